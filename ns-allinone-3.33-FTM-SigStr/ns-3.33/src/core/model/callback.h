@@ -28,7 +28,10 @@
 #include "attribute.h"
 #include "attribute-helper.h"
 #include "simple-ref-count.h"
+#include <cstring>
 #include <typeinfo>
+#include <type_traits>
+#include <utility>
 
 /**
  * \file
@@ -1187,30 +1190,287 @@ private:
   typename TypeTraits<TX3>::ReferencedType m_a3;  //!< third bound argument
 };
 
+/**
+ * \ingroup callbackimpl
+ * A member function bound to a raw object pointer, which Callback
+ * stores inline instead of allocating a MemPtrCallbackImpl.
+ * \tparam OBJ_PTR \deduced Type of the target object, as a raw pointer.
+ * \tparam MEM_PTR \deduced Type of the class member function.
+ * \tparam R \explicit The return type of the Callback.
+ */
+template <typename OBJ_PTR, typename MEM_PTR, typename R>
+struct InlineMemPtr
+{
+  OBJ_PTR m_objPtr;                     //!< the object pointer
+  MEM_PTR m_memPtr;                     //!< the member function pointer
+  /**
+   * \tparam Ts \deduced The types of the arguments.
+   * \param [in] args The arguments
+   * \return Callback value
+   */
+  template <typename... Ts>
+  R operator() (Ts&&... args) const
+  {
+    return (m_objPtr->*m_memPtr)(std::forward<Ts> (args)...);
+  }
+  /**
+   * \param [in] other The other InlineMemPtr
+   * \return \c true if the object or the member function differ
+   */
+  bool operator != (InlineMemPtr const &other) const
+  {
+    return m_objPtr != other.m_objPtr || m_memPtr != other.m_memPtr;
+  }
+};
+
+/**
+ * \ingroup callbackimpl
+ * Invoke a callable stored inline by a Callback, with the arguments
+ * of the Callback.
+ * \tparam C \explicit The type of the callable.
+ * \tparam R \explicit The return type of the Callback.
+ * The remaining template arguments are the types of any arguments
+ * to the Callback.
+ */
+template <typename C, typename R, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9>
+struct InlineInvoker
+{
+  /**
+   * \param [in] storage The callable
+   * \return Callback value
+   */
+  static R Invoke (void const *storage, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8, T9 a9)
+  {
+    return (*static_cast<C const *> (storage))(a1, a2, a3, a4, a5, a6, a7, a8, a9);
+  }
+};
+
+/**
+ * \ingroup callbackimpl
+ * InlineInvoker classes with varying numbers of argument types
+ *
+ * @{
+ */
+template <typename C, typename R>
+struct InlineInvoker<C,R,empty,empty,empty,empty,empty,empty,empty,empty,empty>
+{
+  /**
+   * \param [in] storage The callable
+   * \return Callback value
+   */
+  static R Invoke (void const *storage)
+  {
+    return (*static_cast<C const *> (storage))();
+  }
+};
+
+template <typename C, typename R, typename T1>
+struct InlineInvoker<C,R,T1,empty,empty,empty,empty,empty,empty,empty,empty>
+{
+  /**
+   * \param [in] storage The callable
+   * \return Callback value
+   */
+  static R Invoke (void const *storage, T1 a1)
+  {
+    return (*static_cast<C const *> (storage))(a1);
+  }
+};
+
+template <typename C, typename R, typename T1, typename T2>
+struct InlineInvoker<C,R,T1,T2,empty,empty,empty,empty,empty,empty,empty>
+{
+  /**
+   * \param [in] storage The callable
+   * \return Callback value
+   */
+  static R Invoke (void const *storage, T1 a1, T2 a2)
+  {
+    return (*static_cast<C const *> (storage))(a1, a2);
+  }
+};
+
+template <typename C, typename R, typename T1, typename T2, typename T3>
+struct InlineInvoker<C,R,T1,T2,T3,empty,empty,empty,empty,empty,empty>
+{
+  /**
+   * \param [in] storage The callable
+   * \return Callback value
+   */
+  static R Invoke (void const *storage, T1 a1, T2 a2, T3 a3)
+  {
+    return (*static_cast<C const *> (storage))(a1, a2, a3);
+  }
+};
+
+template <typename C, typename R, typename T1, typename T2, typename T3, typename T4>
+struct InlineInvoker<C,R,T1,T2,T3,T4,empty,empty,empty,empty,empty>
+{
+  /**
+   * \param [in] storage The callable
+   * \return Callback value
+   */
+  static R Invoke (void const *storage, T1 a1, T2 a2, T3 a3, T4 a4)
+  {
+    return (*static_cast<C const *> (storage))(a1, a2, a3, a4);
+  }
+};
+
+template <typename C, typename R, typename T1, typename T2, typename T3, typename T4, typename T5>
+struct InlineInvoker<C,R,T1,T2,T3,T4,T5,empty,empty,empty,empty>
+{
+  /**
+   * \param [in] storage The callable
+   * \return Callback value
+   */
+  static R Invoke (void const *storage, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
+  {
+    return (*static_cast<C const *> (storage))(a1, a2, a3, a4, a5);
+  }
+};
+
+template <typename C, typename R, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+struct InlineInvoker<C,R,T1,T2,T3,T4,T5,T6,empty,empty,empty>
+{
+  /**
+   * \param [in] storage The callable
+   * \return Callback value
+   */
+  static R Invoke (void const *storage, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)
+  {
+    return (*static_cast<C const *> (storage))(a1, a2, a3, a4, a5, a6);
+  }
+};
+
+template <typename C, typename R, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+struct InlineInvoker<C,R,T1,T2,T3,T4,T5,T6,T7,empty,empty>
+{
+  /**
+   * \param [in] storage The callable
+   * \return Callback value
+   */
+  static R Invoke (void const *storage, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7)
+  {
+    return (*static_cast<C const *> (storage))(a1, a2, a3, a4, a5, a6, a7);
+  }
+};
+
+template <typename C, typename R, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8>
+struct InlineInvoker<C,R,T1,T2,T3,T4,T5,T6,T7,T8,empty>
+{
+  /**
+   * \param [in] storage The callable
+   * \return Callback value
+   */
+  static R Invoke (void const *storage, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8)
+  {
+    return (*static_cast<C const *> (storage))(a1, a2, a3, a4, a5, a6, a7, a8);
+  }
+};
+/**@}*/
+
 /**
  * \ingroup callbackimpl
  * Base class for Callback class.
  * Provides pimpl abstraction.
+ *
+ * The callables which are small and trivially copyable, that is function
+ * pointers and member functions bound to raw object pointers, are
+ * stored inline rather than in a heap-allocated CallbackImpl: creating,
+ * copying and destroying the Callback then performs no allocation,
+ * invoking it does not go through the pimpl, and comparing two
+ * Callbacks compares the stored bytes.
  */
 class CallbackBase
 {
 public:
-  CallbackBase () : m_impl ()
+  CallbackBase () : m_impl (), m_ops (0), m_storage ()
   {}
-  /** \return The impl pointer */
+  /**
+   * A callable stored inline is wrapped into a new CallbackImpl,
+   * hence this is not the fast path.
+   *
+   * \return The impl pointer
+   */
   Ptr<CallbackImplBase> GetImpl (void) const
   {
+    if (m_ops != 0)
+      {
+        return Ptr<CallbackImplBase> (m_ops->materialize (m_storage), false);
+      }
     return m_impl;
   }
 
 protected:
+  /**
+   * The operations on a type of callable stored inline, shared by all
+   * the Callbacks of the same signature which store this type of callable.
+   */
+  struct InlineOps
+  {
+    /** The signature of the Callback, see Callback::GetSignature() */
+    void const *signature;
+    /** InlineInvoker::Invoke(), cast to a generic function pointer type */
+    void (*invoke)(void);
+    /** Wrap the callable into a new CallbackImpl */
+    CallbackImplBase * (*materialize)(void const *storage);
+  };
+
   /**
    * Construct from a pimpl
    * \param [in] impl The CallbackImplBase Ptr
    */
-  CallbackBase (Ptr<CallbackImplBase> impl) : m_impl (impl)
+  CallbackBase (Ptr<CallbackImplBase> impl) : m_impl (impl), m_ops (0), m_storage ()
   {}
-  Ptr<CallbackImplBase> m_impl;         //!< the pimpl
+  /**
+   * Store a callable inline.
+   *
+   * \tparam C \deduced The type of the callable.
+   * \param [in] callable The callable
+   * \param [in] ops The operations on the callable
+   */
+  template <typename C>
+  void StoreInline (C const &callable, InlineOps const *ops)
+  {
+    static_assert (sizeof (C) <= sizeof (m_storage) && alignof (C) <= alignof (void *)
+                   && std::is_trivially_copyable<C>::value,
+                   "The callable cannot be stored inline");
+    m_impl = 0;
+    std::memset (m_storage, 0, sizeof (m_storage));
+    std::memcpy (m_storage, &callable, sizeof (C));
+    m_ops = ops;
+  }
+  /**
+   * Equality test
+   *
+   * \param [in] other Callback
+   * \return \c true if we are equal
+   */
+  bool DoIsEqual (const CallbackBase &other) const
+  {
+    if (m_ops != 0 && other.m_ops != 0)
+      {
+        return m_ops == other.m_ops
+               && std::memcmp (m_storage, other.m_storage, sizeof (m_storage)) == 0;
+      }
+    return GetImpl ()->IsEqual (other.GetImpl ());
+  }
+  /**
+   * Check if the other Callback stores inline a callable of the given
+   * signature.
+   *
+   * \param [in] other Callback
+   * \param [in] signature The signature
+   * \return \c true if other stores inline a callable of this signature
+   */
+  bool IsInlineOf (const CallbackBase &other, void const *signature) const
+  {
+    return other.m_ops != 0 && other.m_ops->signature == signature;
+  }
+
+  Ptr<CallbackImplBase> m_impl;         //!< the pimpl, unless the callable is stored inline
+  InlineOps const *m_ops;               //!< the operations on the callable stored inline, or 0
+  void *m_storage[3];                   //!< the callable stored inline
 };
 
 /**
@@ -1293,8 +1553,10 @@ public:
    */
   template <typename FUNCTOR>
   Callback (FUNCTOR const &functor, bool, bool)
-    : CallbackBase (Create<FunctorCallbackImpl<FUNCTOR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (functor))
-  {}
+  {
+    DoStore (functor, std::integral_constant<bool, std::is_pointer<FUNCTOR>::value
+                                             && std::is_function<typename std::remove_pointer<FUNCTOR>::type>::value> ());
+  }
 
   /**
    * Construct a member function pointer call back.
@@ -1306,8 +1568,10 @@ public:
    */
   template <typename OBJ_PTR, typename MEM_PTR>
   Callback (OBJ_PTR const &objPtr, MEM_PTR memPtr)
-    : CallbackBase (Create<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (objPtr, memPtr))
-  {}
+  {
+    DoStore (objPtr, memPtr, std::integral_constant<bool, std::is_pointer<OBJ_PTR>::value
+                                                    && sizeof (InlineMemPtr<OBJ_PTR,MEM_PTR,R>) <= 3 * sizeof (void *)> ());
+  }
 
   /**
    * Construct from a CallbackImpl pointer
@@ -1385,12 +1649,13 @@ public:
    */
   bool IsNull (void) const
   {
-    return (DoPeekImpl () == 0) ? true : false;
+    return (m_ops == 0 && DoPeekImpl () == 0) ? true : false;
   }
   /** Discard the implementation, set it to null */
   void Nullify (void)
   {
     m_impl = 0;
+    m_ops = 0;
   }
 
   /**
@@ -1400,6 +1665,10 @@ public:
   /** \return Callback value */
   R operator() (void) const
   {
+    if (m_ops != 0)
+      {
+        return reinterpret_cast<R (*)(void const *)> (m_ops->invoke)(m_storage);
+      }
     return (*(DoPeekImpl ()))();
   }
   /**
@@ -1408,6 +1677,10 @@ public:
    */
   R operator() (T1 a1) const
   {
+    if (m_ops != 0)
+      {
+        return reinterpret_cast<R (*)(void const *, T1)> (m_ops->invoke)(m_storage, a1);
+      }
     return (*(DoPeekImpl ()))(a1);
   }
   /**
@@ -1417,6 +1690,10 @@ public:
    */
   R operator() (T1 a1, T2 a2) const
   {
+    if (m_ops != 0)
+      {
+        return reinterpret_cast<R (*)(void const *, T1, T2)> (m_ops->invoke)(m_storage, a1, a2);
+      }
     return (*(DoPeekImpl ()))(a1,a2);
   }
   /**
@@ -1427,6 +1704,10 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3) const
   {
+    if (m_ops != 0)
+      {
+        return reinterpret_cast<R (*)(void const *, T1, T2, T3)> (m_ops->invoke)(m_storage, a1, a2, a3);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3);
   }
   /**
@@ -1438,6 +1719,10 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4) const
   {
+    if (m_ops != 0)
+      {
+        return reinterpret_cast<R (*)(void const *, T1, T2, T3, T4)> (m_ops->invoke)(m_storage, a1, a2, a3, a4);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4);
   }
   /**
@@ -1450,6 +1735,10 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4,T5 a5) const
   {
+    if (m_ops != 0)
+      {
+        return reinterpret_cast<R (*)(void const *, T1, T2, T3, T4, T5)> (m_ops->invoke)(m_storage, a1, a2, a3, a4, a5);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4,a5);
   }
   /**
@@ -1463,6 +1752,10 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4,T5 a5,T6 a6) const
   {
+    if (m_ops != 0)
+      {
+        return reinterpret_cast<R (*)(void const *, T1, T2, T3, T4, T5, T6)> (m_ops->invoke)(m_storage, a1, a2, a3, a4, a5, a6);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4,a5,a6);
   }
   /**
@@ -1477,6 +1770,10 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4,T5 a5,T6 a6,T7 a7) const
   {
+    if (m_ops != 0)
+      {
+        return reinterpret_cast<R (*)(void const *, T1, T2, T3, T4, T5, T6, T7)> (m_ops->invoke)(m_storage, a1, a2, a3, a4, a5, a6, a7);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4,a5,a6,a7);
   }
   /**
@@ -1492,6 +1789,10 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4,T5 a5,T6 a6,T7 a7,T8 a8) const
   {
+    if (m_ops != 0)
+      {
+        return reinterpret_cast<R (*)(void const *, T1, T2, T3, T4, T5, T6, T7, T8)> (m_ops->invoke)(m_storage, a1, a2, a3, a4, a5, a6, a7, a8);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4,a5,a6,a7,a8);
   }
   /**
@@ -1508,6 +1809,10 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4,T5 a5,T6 a6,T7 a7,T8 a8, T9 a9) const
   {
+    if (m_ops != 0)
+      {
+        return reinterpret_cast<R (*)(void const *, T1, T2, T3, T4, T5, T6, T7, T8, T9)> (m_ops->invoke)(m_storage, a1, a2, a3, a4, a5, a6, a7, a8, a9);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4,a5,a6,a7,a8,a9);
   }
   /**@}*/
@@ -1520,7 +1825,7 @@ public:
    */
   bool IsEqual (const CallbackBase &other) const
   {
-    return m_impl->IsEqual (other.GetImpl ());
+    return DoIsEqual (other);
   }
 
   /**
@@ -1531,7 +1836,7 @@ public:
    */
   bool CheckType (const CallbackBase & other) const
   {
-    return DoCheckType (other.GetImpl ());
+    return IsInlineOf (other, GetSignature ()) || DoCheckType (other.GetImpl ());
   }
   /**
    * Adopt the other's implementation, if type compatible
@@ -1541,10 +1846,96 @@ public:
    */
   bool Assign (const CallbackBase &other)
   {
+    if (IsInlineOf (other, GetSignature ()))
+      {
+        CallbackBase::operator = (other);
+        return true;
+      }
     return DoAssign (other.GetImpl ());
   }
 
 private:
+  /**
+   * \return A tag which identifies the signature of this Callback type
+   */
+  static void const * GetSignature (void)
+  {
+    static const char signature = 0;
+    return &signature;
+  }
+  /**
+   * \tparam C \explicit The type of the callable stored inline.
+   * \param [in] storage The callable
+   * \return A new CallbackImpl which wraps the callable
+   */
+  template <typename C>
+  static CallbackImplBase * Materialize (void const *storage)
+  {
+    return new FunctorCallbackImpl<C,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> (*static_cast<C const *> (storage));
+  }
+  /**
+   * \tparam C \explicit The type of the callable stored inline.
+   * \return The operations on the callable
+   */
+  template <typename C>
+  static InlineOps const * GetInlineOps (void)
+  {
+    static const InlineOps ops = {
+      GetSignature (),
+      reinterpret_cast<void (*)(void)> (&InlineInvoker<C,R,T1,T2,T3,T4,T5,T6,T7,T8,T9>::Invoke),
+      &Materialize<C>
+    };
+    return &ops;
+  }
+  /**
+   * Store a function pointer inline.
+   *
+   * \tparam FUNCTOR \deduced The type of the function pointer.
+   * \param [in] functor The function pointer
+   */
+  template <typename FUNCTOR>
+  void DoStore (FUNCTOR const &functor, std::true_type)
+  {
+    StoreInline (functor, GetInlineOps<FUNCTOR> ());
+  }
+  /**
+   * Store any other functor in a FunctorCallbackImpl.
+   *
+   * \tparam FUNCTOR \deduced The type of the functor.
+   * \param [in] functor The functor
+   */
+  template <typename FUNCTOR>
+  void DoStore (FUNCTOR const &functor, std::false_type)
+  {
+    m_impl = Create<FunctorCallbackImpl<FUNCTOR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (functor);
+  }
+  /**
+   * Store inline a member function bound to a raw object pointer.
+   *
+   * \tparam OBJ_PTR \deduced Type of the target object, as a pointer.
+   * \tparam MEM_PTR \deduced Type of the class member function.
+   * \param [in] objPtr Pointer to the object
+   * \param [in] memPtr Pointer to the member function
+   */
+  template <typename OBJ_PTR, typename MEM_PTR>
+  void DoStore (OBJ_PTR const &objPtr, MEM_PTR memPtr, std::true_type)
+  {
+    InlineMemPtr<OBJ_PTR,MEM_PTR,R> callable = { objPtr, memPtr };
+    StoreInline (callable, GetInlineOps<InlineMemPtr<OBJ_PTR,MEM_PTR,R> > ());
+  }
+  /**
+   * Store a member function bound to a smart pointer in a MemPtrCallbackImpl.
+   *
+   * \tparam OBJ_PTR \deduced Type of the target object, as a pointer.
+   * \tparam MEM_PTR \deduced Type of the class member function.
+   * \param [in] objPtr Pointer to the object
+   * \param [in] memPtr Pointer to the member function
+   */
+  template <typename OBJ_PTR, typename MEM_PTR>
+  void DoStore (OBJ_PTR const &objPtr, MEM_PTR memPtr, std::false_type)
+  {
+    m_impl = Create<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (objPtr, memPtr);
+  }
   /** \return The pimpl pointer */
   CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> * DoPeekImpl (void) const
   {
@@ -1585,6 +1976,7 @@ private:
         return false;
       }
     m_impl = const_cast<CallbackImplBase *> (PeekPointer (other));
+    m_ops = 0;
     return true;
   }
 };
@@ -26,7 +26,9 @@
 #include "pointer.h"
 #include "log.h"
 
+#include <map>
 #include <sstream>
+#include <utility>
 
 /**
  * \file
@@ -40,6 +42,171 @@ NS_LOG_COMPONENT_DEFINE ("Config");
 
 namespace Config {
 
+/**
+ * \ingroup config-impl
+ * Cache of the attributes and trace sources looked up by name.
+ *
+ * Resolving a path with wildcards, or setting an attribute of the
+ * objects of a MatchContainer, looks up the same name in many objects
+ * of the same type. The attributes and trace sources of a type are
+ * registered before its first object is created, so the results are
+ * kept per TypeId and name.
+ */
+class AccessorCache : public Singleton<AccessorCache>
+{
+public:
+  /** An attribute which holds objects. */
+  struct ObjectAttribute
+  {
+    std::string name;                       //!< The attribute name.
+    Ptr<const AttributeAccessor> accessor;  //!< The attribute accessor.
+    bool container;                         //!< \c true for an ObjectPtrContainer, \c false for a Pointer.
+  };
+  /** Container for the attributes which hold objects. */
+  typedef std::vector<ObjectAttribute> ObjectAttributes;
+
+  /**
+   * Get the attributes of a type, or of its parents, which hold objects
+   * and match a Config path element.
+   *
+   * \param [in] tid The TypeId of the object.
+   * \param [in] item The Config path element: an attribute name, or "*".
+   * \returns The matching gettable Pointer and ObjectPtrContainer attributes.
+   */
+  const ObjectAttributes & GetObjectAttributes (TypeId tid, std::string item);
+  /**
+   * Look up an attribute of a type, or of its parents.
+   *
+   * \param [in] tid The TypeId of the object.
+   * \param [in] name The name of the attribute.
+   * \param [out] info The attribute information.
+   * \returns \c true if the attribute exists.
+   */
+  bool LookupAttribute (TypeId tid, std::string name, struct TypeId::AttributeInformation *info);
+  /**
+   * Look up a trace source of a type, or of its parents.
+   *
+   * \param [in] tid The TypeId of the object.
+   * \param [in] name The name of the trace source.
+   * \returns The trace source accessor, or 0 if the trace source does not exist.
+   */
+  Ptr<const TraceSourceAccessor> LookupTraceSource (TypeId tid, std::string name);
+
+private:
+  /** Key of the caches: the TypeId and the name looked up. */
+  typedef std::pair<TypeId, std::string> Key;
+  /** Attributes which hold objects, per TypeId and path element. */
+  std::map<Key, ObjectAttributes> m_objectAttributes;
+  /**
+   * Attributes per TypeId and name. The accessor is null when
+   * the attribute does not exist.
+   */
+  std::map<Key, struct TypeId::AttributeInformation> m_attributes;
+  /** Trace sources per TypeId and name, null when they do not exist. */
+  std::map<Key, Ptr<const TraceSourceAccessor> > m_traceSources;
+
+};  // class AccessorCache
+
+const AccessorCache::ObjectAttributes &
+AccessorCache::GetObjectAttributes (TypeId tid, std::string item)
+{
+  NS_LOG_FUNCTION (this << tid << item);
+  Key key = std::make_pair (tid, item);
+  std::map<Key, ObjectAttributes>::iterator i = m_objectAttributes.find (key);
+  if (i != m_objectAttributes.end ())
+    {
+      return i->second;
+    }
+  ObjectAttributes &attributes = m_objectAttributes[key];
+  TypeId nextTid = tid;
+  do
+    {
+      tid = nextTid;
+      for (std::size_t j = 0; j < tid.GetAttributeN (); j++)
+        {
+          struct TypeId::AttributeInformation info = tid.GetAttribute (j);
+          if ((info.name != item && item != "*")
+              || !(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter ())
+            {
+              continue;
+            }
+          ObjectAttribute attribute;
+          attribute.name = info.name;
+          attribute.accessor = info.accessor;
+          if (dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.container = false;
+              attributes.push_back (attribute);
+            }
+          else if (dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.container = true;
+              attributes.push_back (attribute);
+            }
+          // this could be anything else and we don't know what to do with it.
+          // So, we just ignore it.
+        }
+      nextTid = tid.GetParent ();
+    }
+  while (nextTid != tid);
+  return attributes;
+}
+
+bool
+AccessorCache::LookupAttribute (TypeId tid, std::string name, struct TypeId::AttributeInformation *info)
+{
+  NS_LOG_FUNCTION (this << tid << name << info);
+  Key key = std::make_pair (tid, name);
+  std::map<Key, struct TypeId::AttributeInformation>::iterator i = m_attributes.find (key);
+  if (i == m_attributes.end ())
+    {
+      struct TypeId::AttributeInformation found;
+      if (!tid.LookupAttributeByName (name, &found))
+        {
+          found.accessor = 0;
+        }
+      i = m_attributes.insert (std::make_pair (key, found)).first;
+    }
+  *info = i->second;
+  return info->accessor != 0;
+}
+
+Ptr<const TraceSourceAccessor>
+AccessorCache::LookupTraceSource (TypeId tid, std::string name)
+{
+  NS_LOG_FUNCTION (this << tid << name);
+  Key key = std::make_pair (tid, name);
+  std::map<Key, Ptr<const TraceSourceAccessor> >::iterator i = m_traceSources.find (key);
+  if (i == m_traceSources.end ())
+    {
+      i = m_traceSources.insert (std::make_pair (key, tid.LookupTraceSourceByName (name))).first;
+    }
+  return i->second;
+}
+
+/**
+ * \ingroup config-impl
+ * Set an attribute of an object, with the accessor of the AccessorCache.
+ *
+ * \param [in] object The object.
+ * \param [in] name The name of the attribute.
+ * \param [in] value The value to set.
+ * \returns \c true if the attribute could be set.
+ */
+static bool
+DoSetAttribute (Ptr<Object> object, std::string name, const AttributeValue &value)
+{
+  NS_LOG_FUNCTION (object << name << &value);
+  struct TypeId::AttributeInformation info;
+  if (!AccessorCache::Get ()->LookupAttribute (object->GetInstanceTypeId (), name, &info)
+      || !(info.flags & TypeId::ATTR_SET) || !info.accessor->HasSetter ())
+    {
+      return false;
+    }
+  Ptr<AttributeValue> v = info.checker->CreateValidValue (value);
+  return v != 0 && info.accessor->Set (PeekPointer (object), *v);
+}
+
 MatchContainer::MatchContainer ()
 {
   NS_LOG_FUNCTION (this);
@@ -97,8 +264,11 @@ MatchContainer::Set (std::string name, const AttributeValue &value)
   for (Iterator tmp = Begin (); tmp != End (); ++tmp)
     {
       Ptr<Object> object = *tmp;
-      // Let ObjectBase::SetAttribute raise any errors
-      object->SetAttribute (name, value);
+      if (!DoSetAttribute (object, name, value))
+        {
+          // Let ObjectBase::SetAttribute raise any errors
+          object->SetAttribute (name, value);
+        }
     }
 }
 bool
@@ -109,7 +279,7 @@ MatchContainer::SetFailSafe (std::string name, const AttributeValue &value)
   for (Iterator tmp = Begin (); tmp != End (); ++tmp)
     {
       Ptr<Object> object = *tmp;
-      ok |= object->SetAttributeFailSafe (name, value);
+      ok |= DoSetAttribute (object, name, value);
     }
   return ok;
 }
@@ -131,7 +301,9 @@ MatchContainer::ConnectFailSafe (std::string name, const CallbackBase &cb)
     {
       Ptr<Object> object = m_objects[i];
       std::string ctx = m_contexts[i] + name;
-      ok |= object->TraceConnect (name, ctx, cb);
+      Ptr<const TraceSourceAccessor> accessor =
+        AccessorCache::Get ()->LookupTraceSource (object->GetInstanceTypeId (), name);
+      ok |= accessor != 0 && accessor->Connect (PeekPointer (object), ctx, cb);
     }
   return ok;
 }
@@ -151,7 +323,9 @@ MatchContainer::ConnectWithoutContextFailSafe (std::string name, const CallbackB
   for (Iterator tmp = Begin (); tmp != End (); ++tmp)
     {
       Ptr<Object> object = *tmp;
-      ok |= object->TraceConnectWithoutContext (name, cb);
+      Ptr<const TraceSourceAccessor> accessor =
+        AccessorCache::Get ()->LookupTraceSource (object->GetInstanceTypeId (), name);
+      ok |= accessor != 0 && accessor->ConnectWithoutContext (PeekPointer (object), cb);
     }
   return ok;
 }
@@ -294,55 +468,130 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
   return !iss.bad () && !iss.fail ();
 }
 
+Path::Path (std::string path)
+  : m_path (path)
+{
+  NS_LOG_FUNCTION (this << path);
+
+  // ensure that we start and end with a '/'
+  std::string canonical = path;
+  if (canonical.find ("/") != 0)
+    {
+      canonical = "/" + canonical;
+    }
+  if (canonical.find_last_of ("/") != canonical.size () - 1)
+    {
+      canonical = canonical + "/";
+    }
+  std::string::size_type begin = 1;
+  std::string::size_type next = canonical.find ("/", begin);
+  while (next != std::string::npos)
+    {
+      m_elements.push_back (canonical.substr (begin, next - begin));
+      begin = next + 1;
+      next = canonical.find ("/", begin);
+    }
+}
+
+std::string
+Path::GetString (void) const
+{
+  return m_path;
+}
+
+const std::vector<std::string> &
+Path::GetElements (void) const
+{
+  return m_elements;
+}
+
+Path
+Path::GetParent (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (!m_elements.empty (), "Empty path " << m_path);
+  Path parent ("");
+  parent.m_elements.assign (m_elements.begin (), m_elements.end () - 1);
+  for (std::vector<std::string>::const_iterator i = parent.m_elements.begin ();
+       i != parent.m_elements.end (); i++)
+    {
+      parent.m_path += "/" + *i;
+    }
+  return parent;
+}
+
+std::string
+Path::GetLeaf (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (!m_elements.empty (), "Empty path " << m_path);
+  return m_elements.back ();
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * Several paths are resolved together: the objects matched by the
+ * same elements of several paths are walked only once.
  */
 class Resolver
 {
 public:
   /**
-   * Construct from a base Config path.
+   * Construct from Config paths.
    *
-   * \param [in] path The Config path.
+   * \param [in] paths The Config paths.
    */
-  Resolver (std::string path);
+  Resolver (const std::vector<Path> &paths);
   /** Destructor. */
   virtual ~Resolver ();
 
   /**
-   * Parse the stored Config path into an object reference,
+   * Parse the stored Config paths into object references,
    * beginning at the indicated root object.
    *
    * \param [in] root The object corresponding to the current position in
-   *                  in the Config path.
+   *                  in the Config paths.
    */
   void Resolve (Ptr<Object> root);
 
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
+  /** Position in a Config path: the index of the path and of its next element. */
+  typedef std::pair<std::size_t, std::size_t> Cursor;
+  /** Container for the positions in the Config paths. */
+  typedef std::vector<Cursor> Cursors;
+
   /**
-   * Parse the next element in the Config path.
+   * Parse the next element of the Config paths.
    *
-   * \param [in] path The remaining portion of the Config path.
-   * \param [in] root The object corresponding to the current position
-   *                  in the Config path.
+   * \param [in] cursors The current positions in the Config paths.
+   * \param [in] root The object corresponding to the current positions
+   *                  in the Config paths.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (const Cursors &cursors, Ptr<Object> root);
   /**
-   * Parse an index on the Config path.
+   * Parse an element shared by the Config paths.
    *
-   * \param [in] path The remaining Config path.
+   * \param [in] item The element.
+   * \param [in] cursors The positions in the Config paths after the element.
+   * \param [in] root The object corresponding to the element.
+   */
+  void DoResolveItem (std::string item, const Cursors &cursors, Ptr<Object> root);
+  /**
+   * Parse an index on the Config paths.
+   *
+   * \param [in] cursors The current positions in the Config paths.
    * \param [in,out] vector The resulting list of matching objects.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (const Cursors &cursors, const ObjectPtrContainerValue &vector);
   /**
-   * Handle one object found on the path.
+   * Handle one object found on a path.
    *
+   * \param [in] path The index of the Config path.
    * \param [in] object The current object on the Config path.
    */
-  void DoResolveOne (Ptr<Object> object);
+  void DoResolveOne (std::size_t path, Ptr<Object> object);
   /**
    * Get the current Config path.
    *
@@ -352,54 +601,40 @@ private:
   /**
    * Handle one found object.
    *
+   * \param [in] path The index of the Config path.
    * \param [in] object The found object.
-   * \param [in] path The matching Config path context.
+   * \param [in] context The matching Config path context.
    */
-  virtual void DoOne (Ptr<Object> object, std::string path) = 0;
+  virtual void DoOne (std::size_t path, Ptr<Object> object, std::string context) = 0;
 
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
-  /** The Config path. */
-  std::string m_path;
+  /** The Config paths. */
+  std::vector<Path> m_paths;
 
 };  // class Resolver
 
-Resolver::Resolver (std::string path)
-  : m_path (path)
+Resolver::Resolver (const std::vector<Path> &paths)
+  : m_paths (paths)
 {
-  NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
+  NS_LOG_FUNCTION (this << paths.size ());
 }
 Resolver::~Resolver ()
 {
   NS_LOG_FUNCTION (this);
 }
-void
-Resolver::Canonicalize (void)
-{
-  NS_LOG_FUNCTION (this);
-
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
-    {
-      // no slash at start
-      m_path = "/" + m_path;
-    }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
-    {
-      // no slash at end
-      m_path = m_path + "/";
-    }
-}
 
 void
 Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  Cursors cursors;
+  for (std::size_t i = 0; i < m_paths.size (); i++)
+    {
+      cursors.push_back (std::make_pair (i, 0));
+    }
+  DoResolve (cursors, root);
 }
 
 std::string
@@ -416,39 +651,63 @@ Resolver::GetResolvedPath (void) const
 }
 
 void
-Resolver::DoResolveOne (Ptr<Object> object)
+Resolver::DoResolveOne (std::size_t path, Ptr<Object> object)
 {
-  NS_LOG_FUNCTION (this << object);
+  NS_LOG_FUNCTION (this << path << object);
 
   NS_LOG_DEBUG ("resolved=" << GetResolvedPath ());
-  DoOne (object, GetResolvedPath ());
+  DoOne (path, object, GetResolvedPath ());
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
-{
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-
-  if (next == std::string::npos)
-    {
-      //
-      // If root is zero, we're beginning to see if we can use the object name
-      // service to resolve this path.  It is impossible to have a object name
-      // associated with the root of the object name service since that root
-      // is not an object.  This path must be referring to something in another
-      // namespace and it will have been found already since the name service
-      // is always consulted last.
-      //
-      if (root)
+Resolver::DoResolve (const Cursors &cursors, Ptr<Object> root)
+{
+  NS_LOG_FUNCTION (this << cursors.size () << root);
+
+  // the paths which continue, grouped by their next element
+  std::vector<std::pair<std::string, Cursors> > items;
+  for (Cursors::const_iterator i = cursors.begin (); i != cursors.end (); i++)
+    {
+      const std::vector<std::string> &elements = m_paths[i->first].GetElements ();
+      if (i->second == elements.size ())
+        {
+          //
+          // If root is zero, we're beginning to see if we can use the object name
+          // service to resolve this path.  It is impossible to have a object name
+          // associated with the root of the object name service since that root
+          // is not an object.  This path must be referring to something in another
+          // namespace and it will have been found already since the name service
+          // is always consulted last.
+          //
+          if (root)
+            {
+              DoResolveOne (i->first, root);
+            }
+          continue;
+        }
+      const std::string &item = elements[i->second];
+      std::vector<std::pair<std::string, Cursors> >::iterator j = items.begin ();
+      while (j != items.end () && j->first != item)
         {
-          DoResolveOne (root);
+          j++;
         }
-      return;
+      if (j == items.end ())
+        {
+          j = items.insert (j, std::make_pair (item, Cursors ()));
+        }
+      j->second.push_back (std::make_pair (i->first, i->second + 1));
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  for (std::vector<std::pair<std::string, Cursors> >::const_iterator i = items.begin ();
+       i != items.end (); i++)
+    {
+      DoResolveItem (i->first, i->second, root);
+    }
+}
+
+void
+Resolver::DoResolveItem (std::string item, const Cursors &cursors, Ptr<Object> root)
+{
+  NS_LOG_FUNCTION (this << item << cursors.size () << root);
 
   //
   // If root is zero, we're beginning to see if we can use the object name
@@ -457,16 +716,12 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   // the root of the "/Names" namespace, so we just ignore it and move on to
   // the next segment.
   //
-  if (root == 0)
+  if (root == 0 && item == "Names")
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
-        {
-          m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
-          m_workStack.pop_back ();
-          return;
-        }
+      m_workStack.push_back (item);
+      DoResolve (cursors, root);
+      m_workStack.pop_back ();
+      return;
     }
 
   //
@@ -480,7 +735,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (cursors, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -510,101 +765,91 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (cursors, object);
       m_workStack.pop_back ();
     }
   else
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
-      bool foundMatch = false;
-
-      do
+      const AccessorCache::ObjectAttributes &attributes =
+        AccessorCache::Get ()->GetObjectAttributes (root->GetInstanceTypeId (), item);
+      if (attributes.empty ())
         {
-          tid = nextTid;
-
-          for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+          NS_LOG_DEBUG ("Requested item=" << item << " does not exist on path=" << GetResolvedPath ());
+          return;
+        }
+      for (AccessorCache::ObjectAttributes::const_iterator i = attributes.begin ();
+           i != attributes.end (); i++)
+        {
+          if (!i->container)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute (i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)=" << i->name << " on path=" << GetResolvedPath ());
+              PointerValue pValue;
+              i->accessor->Get (PeekPointer (root), pValue);
+              Ptr<Object> object = pValue.Get<Object> ();
+              if (object == 0)
                 {
+                  NS_LOG_ERROR ("Requested object name=\"" << item <<
+                                "\" exists on path=\"" << GetResolvedPath () << "\""
+                                " but is null.");
                   continue;
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *pChecker = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (pChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)=" << info.name << " on path=" << GetResolvedPath ());
-                  PointerValue pValue;
-                  root->GetAttribute (info.name, pValue);
-                  Ptr<Object> object = pValue.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\"" << item <<
-                                    "\" exists on path=\"" << GetResolvedPath () << "\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
-                }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker =
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
-                }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              m_workStack.push_back (i->name);
+              DoResolve (cursors, object);
+              m_workStack.pop_back ();
+            }
+          else
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)=" << i->name << " on path=" << GetResolvedPath ());
+              ObjectPtrContainerValue vector;
+              i->accessor->Get (PeekPointer (root), vector);
+              m_workStack.push_back (i->name);
+              DoArrayResolve (cursors, vector);
+              m_workStack.pop_back ();
             }
-
-          nextTid = tid.GetParent ();
-        }
-      while (nextTid != tid);
-
-      if (!foundMatch)
-        {
-          NS_LOG_DEBUG ("Requested item=" << item << " does not exist on path=" << GetResolvedPath ());
-          return;
         }
     }
 }
 
 void
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (const Cursors &cursors, const ObjectPtrContainerValue &container)
 {
-  NS_LOG_FUNCTION (this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << cursors.size () << &container);
+
+  // the paths which continue with an index
+  std::vector<ArrayMatcher> matchers;
+  Cursors next;
+  for (Cursors::const_iterator i = cursors.begin (); i != cursors.end (); i++)
+    {
+      const std::vector<std::string> &elements = m_paths[i->first].GetElements ();
+      if (i->second < elements.size ())
+        {
+          matchers.push_back (ArrayMatcher (elements[i->second]));
+          next.push_back (std::make_pair (i->first, i->second + 1));
+        }
+    }
+  if (next.empty ())
     {
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
-      if (matcher.Matches ((*it).first))
+      Cursors matching;
+      for (std::size_t i = 0; i < matchers.size (); i++)
+        {
+          if (matchers[i].Matches ((*it).first))
+            {
+              matching.push_back (next[i]);
+            }
+        }
+      if (!matching.empty ())
         {
           std::ostringstream oss;
           oss << (*it).first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (matching, (*it).second);
           m_workStack.pop_back ();
         }
     }
@@ -631,8 +876,10 @@ public:
   void DisconnectWithoutContext (std::string path, const CallbackBase &cb);
   /** \copydoc Config::Disconnect() */
   void Disconnect (std::string path, const CallbackBase &cb);
-  /** \copydoc Config::LookupMatches() */
+  /** \copydoc Config::LookupMatches(std::string) */
   MatchContainer LookupMatches (std::string path);
+  /** \copydoc Config::LookupMatches(const std::vector<Path>&) */
+  std::vector<MatchContainer> LookupMatches (const std::vector<Path> &paths);
 
   /** \copydoc Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -751,21 +998,30 @@ MatchContainer
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
+  return LookupMatches (std::vector<Path> (1, Path (path))).front ();
+}
+
+std::vector<MatchContainer>
+ConfigImpl::LookupMatches (const std::vector<Path> &paths)
+{
+  NS_LOG_FUNCTION (this << paths.size ());
   class LookupMatchesResolver : public Resolver
   {
 public:
-    LookupMatchesResolver (std::string path)
-      : Resolver (path)
+    LookupMatchesResolver (const std::vector<Path> &paths)
+      : Resolver (paths),
+        m_objects (paths.size ()),
+        m_contexts (paths.size ())
     {
     }
-    virtual void DoOne (Ptr<Object> object, std::string path)
+    virtual void DoOne (std::size_t path, Ptr<Object> object, std::string context)
     {
-      m_objects.push_back (object);
-      m_contexts.push_back (path);
+      m_objects[path].push_back (object);
+      m_contexts[path].push_back (context);
     }
-    std::vector<Ptr<Object> > m_objects;
-    std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+    std::vector<std::vector<Ptr<Object> > > m_objects;
+    std::vector<std::vector<std::string> > m_contexts;
+  } resolver = LookupMatchesResolver (paths);
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -778,7 +1034,13 @@ public:
   //
   resolver.Resolve (0);
 
-  return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
+  std::vector<MatchContainer> containers;
+  for (std::size_t i = 0; i < paths.size (); i++)
+    {
+      containers.push_back (MatchContainer (resolver.m_objects[i], resolver.m_contexts[i],
+                                            paths[i].GetString ()));
+    }
+  return containers;
 }
 
 void
@@ -940,6 +1202,16 @@ MatchContainer LookupMatches (std::string path)
   NS_LOG_FUNCTION (path);
   return ConfigImpl::Get ()->LookupMatches (path);
 }
+MatchContainer LookupMatches (const Path &path)
+{
+  NS_LOG_FUNCTION (path.GetString ());
+  return ConfigImpl::Get ()->LookupMatches (std::vector<Path> (1, path)).front ();
+}
+std::vector<MatchContainer> LookupMatches (const std::vector<Path> &paths)
+{
+  NS_LOG_FUNCTION (paths.size ());
+  return ConfigImpl::Get ()->LookupMatches (paths);
+}
 
 void RegisterRootNamespaceObject (Ptr<Object> obj)
 {
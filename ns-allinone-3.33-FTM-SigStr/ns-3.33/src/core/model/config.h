@@ -314,6 +314,85 @@ private:
  */
 MatchContainer LookupMatches (std::string path);
 
+/**
+ * \ingroup config
+ * \brief A Config path parsed once, to be resolved many times.
+ *
+ * The functions which take a path as a string split it into its
+ * elements each time they are called. A Path is split only once, and
+ * can then be resolved repeatedly, or together with other paths by
+ * LookupMatches(const std::vector<Path>&), which walks the objects
+ * shared by several paths only once:
+ *
+ * \code
+ *   std::vector<Config::Path> paths;
+ *   paths.push_back (Config::Path ("/NodeList/[0-9]/DeviceList/0/$ns3::WifiNetDevice/Phy"));
+ *   paths.push_back (Config::Path ("/NodeList/[0-9]/DeviceList/0/$ns3::WifiNetDevice/Mac"));
+ *   std::vector<Config::MatchContainer> matches = Config::LookupMatches (paths);
+ *   matches[0].Connect ("PhyRxBegin", MakeCallback (&PhyRxBegin));
+ *   matches[1].Connect ("MacRx", MakeCallback (&MacRx));
+ * \endcode
+ */
+class Path
+{
+public:
+  /**
+   * Parse a Config path.
+   *
+   * \param [in] path The Config path.
+   */
+  explicit Path (std::string path);
+
+  /**
+   * \returns The Config path, as given to the constructor.
+   */
+  std::string GetString (void) const;
+  /**
+   * \returns The elements of the path, without the slashes.
+   */
+  const std::vector<std::string> & GetElements (void) const;
+  /**
+   * \returns The path of the objects which hold the last element
+   *          of this path.
+   */
+  Path GetParent (void) const;
+  /**
+   * \returns The last element of the path, usually the name of an
+   *          attribute or of a trace source.
+   */
+  std::string GetLeaf (void) const;
+
+private:
+  /** The Config path. */
+  std::string m_path;
+  /** The elements of the path. */
+  std::vector<std::string> m_elements;
+};
+
+/**
+ * \ingroup config
+ * \param [in] path The path to perform a match against
+ * \returns A container which contains all the objects which match the input
+ *          path.
+ */
+MatchContainer LookupMatches (const Path &path);
+/**
+ * \ingroup config
+ * \param [in] paths The paths to perform a match against
+ * \returns For each path, a container which contains all the objects
+ *          which match this path.
+ *
+ * The objects are walked only once for all the paths, which is faster
+ * than matching each path in turn when they share their first elements.
+ * The attributes and trace sources of the matched objects can then be
+ * set or connected with the MatchContainer methods, e.g.
+ * \code
+ *   Config::Path path ("/NodeList/[0-3]/DeviceList/0/Mtu");
+ *   Config::LookupMatches (path.GetParent ()).Set (path.GetLeaf (), UintegerValue (1400));
+ * \endcode
+ */
+std::vector<MatchContainer> LookupMatches (const std::vector<Path> &paths);
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
@@ -29,6 +29,7 @@
 #include "log.h"
 
 #include <cmath>
+#include <thread>
 
 
 /**
@@ -72,7 +73,14 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
   m_eventCount = 0;
-  m_eventsWithContextEmpty = true;
+  for (uint32_t i = 0; i < EVENTS_WITH_CONTEXT_RING_SIZE; i++)
+    {
+      m_eventsWithContextRing[i].sequence.store (i, std::memory_order_relaxed);
+    }
+  m_eventsWithContextHead.store (0, std::memory_order_relaxed);
+  m_eventsWithContextTail = 0;
+  m_eventsWithContextOverflow.store (false, std::memory_order_relaxed);
+  m_eventsWithContextEmpty.store (true, std::memory_order_relaxed);
   m_main = SystemThread::Self ();
 }
 
@@ -151,7 +159,10 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   next.impl->Invoke ();
   next.impl->Unref ();
 
-  ProcessEventsWithContext ();
+  if (!m_eventsWithContextEmpty.load (std::memory_order_relaxed))
+    {
+      ProcessEventsWithContext ();
+    }
 }
 
 bool
@@ -160,33 +171,112 @@ DefaultSimulatorImpl::IsFinished (void) const
   return m_events->IsEmpty () || m_stop;
 }
 
+bool
+DefaultSimulatorImpl::PushEventWithContext (const EventWithContext &event)
+{
+  uint64_t pos = m_eventsWithContextHead.load (std::memory_order_relaxed);
+  EventWithContextSlot *slot;
+  while (true)
+    {
+      slot = &m_eventsWithContextRing[pos % EVENTS_WITH_CONTEXT_RING_SIZE];
+      uint64_t sequence = slot->sequence.load (std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t> (sequence - pos);
+      if (diff == 0)
+        {
+          // the slot is free, try to claim it
+          if (m_eventsWithContextHead.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+            {
+              break;
+            }
+        }
+      else if (diff < 0)
+        {
+          // the slot still holds the event written one lap earlier
+          return false;
+        }
+      else
+        {
+          // another thread claimed the slot
+          pos = m_eventsWithContextHead.load (std::memory_order_relaxed);
+        }
+    }
+  slot->event = event;
+  slot->sequence.store (pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool
+DefaultSimulatorImpl::PopEventWithContext (EventWithContext &event)
+{
+  EventWithContextSlot &slot = m_eventsWithContextRing[m_eventsWithContextTail % EVENTS_WITH_CONTEXT_RING_SIZE];
+  if (slot.sequence.load (std::memory_order_acquire) != m_eventsWithContextTail + 1)
+    {
+      // empty, or the event is still being written
+      return false;
+    }
+  event = slot.event;
+  slot.sequence.store (m_eventsWithContextTail + EVENTS_WITH_CONTEXT_RING_SIZE, std::memory_order_release);
+  m_eventsWithContextTail++;
+  return true;
+}
+
+void
+DefaultSimulatorImpl::InsertEventWithContext (const EventWithContext &event)
+{
+  Scheduler::Event ev;
+  ev.impl = event.event;
+  ev.key.m_ts = m_currentTs + event.timestamp;
+  ev.key.m_context = event.context;
+  ev.key.m_uid = m_uid;
+  m_uid++;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
+}
+
 void
 DefaultSimulatorImpl::ProcessEventsWithContext (void)
 {
-  if (m_eventsWithContextEmpty)
+  // Events added after this point set the flag again
+  m_eventsWithContextEmpty.store (true, std::memory_order_seq_cst);
+
+  EventWithContext event;
+  while (PopEventWithContext (event))
     {
-      return;
+      InsertEventWithContext (event);
     }
 
+  if (!m_eventsWithContextOverflow.load (std::memory_order_acquire))
+    {
+      return;
+    }
   // swap queues
   EventsWithContext eventsWithContext;
+  uint64_t head;
   {
     CriticalSection cs (m_eventsWithContextMutex);
     m_eventsWithContext.swap (eventsWithContext);
-    m_eventsWithContextEmpty = true;
+    m_eventsWithContextOverflow.store (false, std::memory_order_release);
+    head = m_eventsWithContextHead.load (std::memory_order_relaxed);
   }
+  // A thread adds events to the list only after the events it added to
+  // the ring, which were all given a position before head. Some of them
+  // may still be being written: wait for them, so that the events of each
+  // thread are inserted in the order they were scheduled.
+  while (m_eventsWithContextTail != head)
+    {
+      if (PopEventWithContext (event))
+        {
+          InsertEventWithContext (event);
+        }
+      else
+        {
+          std::this_thread::yield ();
+        }
+    }
   while (!eventsWithContext.empty ())
     {
-      EventWithContext event = eventsWithContext.front ();
+      InsertEventWithContext (eventsWithContext.front ());
       eventsWithContext.pop_front ();
-      Scheduler::Event ev;
-      ev.impl = event.event;
-      ev.key.m_ts = m_currentTs + event.timestamp;
-      ev.key.m_context = event.context;
-      ev.key.m_uid = m_uid;
-      m_uid++;
-      m_unscheduledEvents++;
-      m_events->Insert (ev);
     }
 }
 
@@ -270,11 +360,14 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
       // Current time added in ProcessEventsWithContext()
       ev.timestamp = delay.GetTimeStep ();
       ev.event = event;
-      {
-        CriticalSection cs (m_eventsWithContextMutex);
-        m_eventsWithContext.push_back (ev);
-        m_eventsWithContextEmpty = false;
-      }
+      if (m_eventsWithContextOverflow.load (std::memory_order_acquire)
+          || !PushEventWithContext (ev))
+        {
+          CriticalSection cs (m_eventsWithContextMutex);
+          m_eventsWithContext.push_back (ev);
+          m_eventsWithContextOverflow.store (true, std::memory_order_release);
+        }
+      m_eventsWithContextEmpty.store (false, std::memory_order_seq_cst);
     }
 }
 
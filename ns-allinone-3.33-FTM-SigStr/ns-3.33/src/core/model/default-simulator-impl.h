@@ -29,6 +29,7 @@
 
 #include "ptr.h"
 
+#include <atomic>
 #include <list>
 
 /**
@@ -97,15 +98,81 @@ private:
     /** The event implementation. */
     EventImpl *event;
   };
+  /**
+   * Add an event from a different thread to the ring of events with context.
+   *
+   * \param [in] event The event.
+   * \returns \c false if the ring is full.
+   */
+  bool PushEventWithContext (const EventWithContext &event);
+  /**
+   * Remove the oldest event from the ring of events with context.
+   * Only called by the main thread.
+   *
+   * \param [out] event The event.
+   * \returns \c false if the ring is empty.
+   */
+  bool PopEventWithContext (EventWithContext &event);
+  /**
+   * Insert an event from a different context into the main event queue.
+   *
+   * \param [in] event The event.
+   */
+  void InsertEventWithContext (const EventWithContext &event);
+
+  /** A slot of the ring of events from a different context. */
+  struct EventWithContextSlot
+  {
+    /**
+     * Position the slot is ready for: equal to the writing position when
+     * the slot is free, and to the writing position plus one when the
+     * slot holds an event.
+     */
+    std::atomic<uint64_t> sequence;
+    /** The event. */
+    EventWithContext event;
+  };
+  /** Number of slots of the ring of events from a different context. */
+  static const uint32_t EVENTS_WITH_CONTEXT_RING_SIZE = 1024;
+  /**
+   * Bounded lock-free ring of events from a different context, with
+   * multiple producers (the other threads) and a single consumer (the
+   * main thread).
+   */
+  EventWithContextSlot m_eventsWithContextRing[EVENTS_WITH_CONTEXT_RING_SIZE];
+  /** Size of a cache line, to lay out the ring positions. */
+  static const uint32_t CACHE_LINE_SIZE = 64;
+  /**
+   * Next writing position in the ring of events with context. It is
+   * updated by the other threads, hence it is kept in its own cache line,
+   * away from the reading position updated by the main thread.
+   */
+  std::atomic<uint64_t> m_eventsWithContextHead;
+  /** Padding between the writing and reading positions. */
+  char m_eventsWithContextHeadPadding[CACHE_LINE_SIZE];
+  /** Next reading position in the ring of events with context. */
+  uint64_t m_eventsWithContextTail;
+  /** Padding after the reading position. */
+  char m_eventsWithContextTailPadding[CACHE_LINE_SIZE];
+
   /** Container type for the events from a different context. */
   typedef std::list<struct EventWithContext> EventsWithContext;
-  /** The container of events from a different context. */
+  /**
+   * The container of events from a different context which did not fit
+   * in the ring.
+   */
   EventsWithContext m_eventsWithContext;
+  /**
+   * Flag \c true if events from a different context are stored in
+   * m_eventsWithContext. While set, other threads keep adding events
+   * to m_eventsWithContext instead of the ring, to preserve their order.
+   */
+  std::atomic<bool> m_eventsWithContextOverflow;
   /**
    * Flag \c true if all events with context have been moved to the
    * primary event queue.
    */
-  bool m_eventsWithContextEmpty;
+  std::atomic<bool> m_eventsWithContextEmpty;
   /** Mutex to control access to the list of events with context. */
   SystemMutex m_eventsWithContextMutex;
 
@@ -20,6 +20,7 @@
 
 #include "event-impl.h"
 #include "log.h"
+#include <new>
 
 /**
  * \file
@@ -31,6 +32,136 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+#ifdef ENABLE_EVENT_POOL
+namespace {
+
+/**
+ * \ingroup events
+ * Per-thread free lists of event blocks.
+ *
+ * Blocks are allocated one by one from the global heap, so that a block
+ * allocated by a thread and released by another one (e.g., an event
+ * scheduled from another thread with the realtime simulator) simply
+ * moves to the free list of the releasing thread.
+ */
+class EventPool
+{
+public:
+  /** Granularity of the block sizes. */
+  static const std::size_t GRANULARITY = 16;
+  /** Number of block sizes. */
+  static const std::size_t CLASSES = 8;
+  /** Maximum number of free blocks kept per block size. */
+  static const uint32_t MAX_FREE = 4096;
+
+  /** Release all the free blocks. */
+  ~EventPool ();
+
+  /**
+   * \param [in] size The size of the event.
+   * \returns The allocated memory.
+   */
+  void * Allocate (std::size_t size);
+  /**
+   * \param [in] ptr The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  void Deallocate (void *ptr, std::size_t size);
+
+  /** A free block. */
+  struct Block
+  {
+    Block *next;  //!< Next free block
+  };
+
+  Block *m_free[CLASSES];   //!< Free blocks, per block size
+  uint32_t m_count[CLASSES]; //!< Number of free blocks, per block size
+};
+
+/**
+ * Whether the free lists of the calling thread have been destroyed.
+ *
+ * This flag is trivially destructible, so it remains valid until the
+ * thread exits, unlike the EventPool itself: events created or released
+ * later by the exiting thread bypass the pool.
+ */
+thread_local bool g_eventPoolDestroyed = false;
+
+EventPool::~EventPool ()
+{
+  for (std::size_t i = 0; i < CLASSES; i++)
+    {
+      while (m_free[i] != 0)
+        {
+          Block *block = m_free[i];
+          m_free[i] = block->next;
+          ::operator delete (block);
+        }
+      m_count[i] = 0;
+    }
+  g_eventPoolDestroyed = true;
+}
+
+void *
+EventPool::Allocate (std::size_t size)
+{
+  std::size_t i = (size - 1) / GRANULARITY;
+  if (i < CLASSES && m_free[i] != 0)
+    {
+      Block *block = m_free[i];
+      m_free[i] = block->next;
+      m_count[i]--;
+      return block;
+    }
+  if (i < CLASSES)
+    {
+      size = (i + 1) * GRANULARITY;
+    }
+  return ::operator new (size);
+}
+
+void
+EventPool::Deallocate (void *ptr, std::size_t size)
+{
+  std::size_t i = (size - 1) / GRANULARITY;
+  if (i >= CLASSES || m_count[i] >= MAX_FREE)
+    {
+      ::operator delete (ptr);
+      return;
+    }
+  Block *block = static_cast<Block *> (ptr);
+  block->next = m_free[i];
+  m_free[i] = block;
+  m_count[i]++;
+}
+
+/** The free lists of the calling thread. */
+thread_local EventPool g_eventPool;
+
+} // unnamed namespace
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  if (g_eventPoolDestroyed)
+    {
+      return ::operator new (size);
+    }
+  return g_eventPool.Allocate (size);
+}
+
+void
+EventImpl::operator delete (void *ptr, std::size_t size)
+{
+  if (g_eventPoolDestroyed)
+    {
+      ::operator delete (ptr);
+      return;
+    }
+  g_eventPool.Deallocate (ptr, size);
+}
+#endif /* ENABLE_EVENT_POOL */
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
@@ -21,6 +21,8 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
+#include "ns3/core-config.h"
 #include "simple-ref-count.h"
 
 /**
@@ -40,6 +42,12 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The subclasses generated by MakeEvent() store the bound function and
+ * arguments inline. Unless the event pool is disabled at configure time
+ * (`--disable-event-pool`), events are allocated from per-thread free lists
+ * of fixed-size blocks, one list per multiple of 16 bytes up to 128 bytes,
+ * instead of the global heap. Larger events use the global heap.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -66,6 +74,23 @@ public:
    */
   bool IsCancelled (void);
 
+#ifdef ENABLE_EVENT_POOL
+  /**
+   * Allocate an event from the free list of the calling thread.
+   *
+   * \param [in] size The size of the event.
+   * \returns The allocated memory.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release an event to the free list of the calling thread.
+   *
+   * \param [in] ptr The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *ptr, std::size_t size);
+#endif /* ENABLE_EVENT_POOL */
+
 protected:
   /**
    * Implementation for Invoke().
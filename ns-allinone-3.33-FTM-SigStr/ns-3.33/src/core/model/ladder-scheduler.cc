@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include "uinteger.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+    .AddAttribute ("Threshold",
+                   "Number of events above which a bucket is spread over a new rung "
+                   "instead of being sorted into the bottom.",
+                   UintegerValue (50),
+                   MakeUintegerAccessor (&LadderScheduler::m_threshold),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MaxRungs",
+                   "Maximum number of rungs of the ladder.",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&LadderScheduler::m_maxRungs),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topMin (std::numeric_limits<uint64_t>::max ()),
+    m_topMax (0),
+    m_topStart (0),
+    m_nRungs (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+std::size_t
+LadderScheduler::FindRung (uint64_t ts) const
+{
+  std::size_t i = 0;
+  while (i < m_nRungs)
+    {
+      const Rung &rung = m_rungs[i];
+      if (ts >= rung.m_start + rung.m_current * rung.m_width)
+        {
+          break;
+        }
+      i++;
+    }
+  return i;
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  std::size_t i;
+  if (ts >= m_topStart)
+    {
+      m_top.push_back (ev);
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+    }
+  else if ((i = FindRung (ts)) < m_nRungs)
+    {
+      Rung &rung = m_rungs[i];
+      std::size_t bucket = (ts - rung.m_start) / rung.m_width;
+      NS_ASSERT (bucket < rung.m_nBuckets);
+      rung.m_buckets[bucket].push_back (ev);
+    }
+  else
+    {
+      Bucket::iterator it = std::lower_bound (m_bottom.begin (), m_bottom.end (),
+                                              ev, std::greater<Event> ());
+      m_bottom.insert (it, ev);
+      if (m_bottom.size () > m_threshold && m_nRungs < m_maxRungs
+          && m_bottom.front ().key.m_ts != m_bottom.back ().key.m_ts)
+        {
+          // too many events for a sorted insertion: spread them over a
+          // new rung ending where the lowest rung (or the top) starts
+          uint64_t start = m_bottom.back ().key.m_ts;
+          uint64_t end = m_topStart;
+          if (m_nRungs > 0)
+            {
+              const Rung &rung = m_rungs[m_nRungs - 1];
+              end = rung.m_start + rung.m_current * rung.m_width;
+            }
+          AddRung (start, end - start, m_bottom);
+        }
+    }
+  // the bottom is empty only if the scheduler was empty
+  if (m_bottom.empty ())
+    {
+      FillBottom ();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_bottom.empty ();
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_bottom.empty ());
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_bottom.empty ());
+  Scheduler::Event ev = m_bottom.back ();
+  m_bottom.pop_back ();
+  if (m_bottom.empty ())
+    {
+      FillBottom ();
+    }
+  NS_LOG_DEBUG ("remove " << ev.key.m_ts << ", " << ev.key.m_uid);
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  Bucket *bucket;
+  if (ts >= m_topStart)
+    {
+      bucket = &m_top;
+    }
+  else
+    {
+      std::size_t i = FindRung (ts);
+      if (i < m_nRungs)
+        {
+          Rung &rung = m_rungs[i];
+          bucket = &rung.m_buckets[(ts - rung.m_start) / rung.m_width];
+        }
+      else
+        {
+          Bucket::iterator it = std::lower_bound (m_bottom.begin (), m_bottom.end (),
+                                                  ev, std::greater<Event> ());
+          NS_ASSERT (it != m_bottom.end () && *it == ev);
+          m_bottom.erase (it);
+          if (m_bottom.empty ())
+            {
+              FillBottom ();
+            }
+          return;
+        }
+    }
+  // Buckets and top are unsorted: replace the event with the last one
+  Bucket::iterator it = std::find (bucket->begin (), bucket->end (), ev);
+  NS_ASSERT (it != bucket->end ());
+  *it = bucket->back ();
+  bucket->pop_back ();
+}
+
+void
+LadderScheduler::AddRung (uint64_t start, uint64_t span, Bucket &events)
+{
+  NS_LOG_FUNCTION (this << start << span << events.size ());
+  NS_ASSERT (!events.empty ());
+  if (m_nRungs == m_rungs.size ())
+    {
+      m_rungs.push_back (Rung ());
+    }
+  Rung &rung = m_rungs[m_nRungs];
+  m_nRungs++;
+  rung.m_start = start;
+  rung.m_width = std::max<uint64_t> ((span + events.size () - 1) / events.size (), 1);
+  rung.m_nBuckets = (span + rung.m_width - 1) / rung.m_width;
+  rung.m_current = 0;
+  if (rung.m_buckets.size () < rung.m_nBuckets)
+    {
+      rung.m_buckets.resize (rung.m_nBuckets);
+    }
+  for (Bucket::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      std::size_t bucket = (i->key.m_ts - start) / rung.m_width;
+      NS_ASSERT (bucket < rung.m_nBuckets);
+      rung.m_buckets[bucket].push_back (*i);
+    }
+  events.clear ();
+}
+
+void
+LadderScheduler::FillBottom (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_bottom.empty ());
+  while (m_bottom.empty ())
+    {
+      if (m_nRungs == 0)
+        {
+          if (m_top.empty ())
+            {
+              // the scheduler is empty: the next events go to the top
+              m_topStart = 0;
+              return;
+            }
+          uint64_t start = m_topMin;
+          AddRung (start, m_topMax - m_topMin + 1, m_top);
+          m_topStart = start + m_rungs[0].m_nBuckets * m_rungs[0].m_width;
+          m_topMin = std::numeric_limits<uint64_t>::max ();
+          m_topMax = 0;
+        }
+      std::size_t index = m_nRungs - 1;
+      Rung &rung = m_rungs[index];
+      while (rung.m_current < rung.m_nBuckets && rung.m_buckets[rung.m_current].empty ())
+        {
+          rung.m_current++;
+        }
+      if (rung.m_current == rung.m_nBuckets)
+        {
+          m_nRungs--;
+          continue;
+        }
+      std::size_t current = rung.m_current++;
+      Bucket &bucket = rung.m_buckets[current];
+      if (bucket.size () > m_threshold && rung.m_width > 1 && m_nRungs < m_maxRungs)
+        {
+          uint64_t start = rung.m_start + current * rung.m_width;
+          uint64_t width = rung.m_width;
+          // AddRung may reallocate the rungs, copy the bucket out first
+          Bucket events;
+          events.swap (bucket);
+          AddRung (start, width, events);
+          // give the storage back to the bucket for later use
+          m_rungs[index].m_buckets[current].swap (events);
+        }
+      else
+        {
+          m_bottom.swap (bucket);
+          std::sort (m_bottom.begin (), m_bottom.end (), std::greater<Event> ());
+        }
+    }
+}
+
+} // namespace ns3
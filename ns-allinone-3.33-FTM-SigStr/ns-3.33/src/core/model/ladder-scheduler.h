@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue described in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * Events are kept in three tiers:
+ *
+ * - **Top**: an unsorted vector holding the events farther in the future
+ *   than the time span covered by the ladder.
+ * - **Ladder**: a stack of rungs, each one made of a vector of buckets
+ *   which split the time span of a single bucket of the rung above.
+ *   Buckets are unsorted vectors.
+ * - **Bottom**: a vector holding the earliest events, sorted in
+ *   decreasing order so that the next event is removed from its end.
+ *
+ * When the bottom runs out of events, the first non-empty bucket of the
+ * lowest rung is either moved to the bottom and sorted, or, if it holds
+ * more than \c Threshold events, spread over a new, finer rung. When the
+ * ladder is exhausted, a new rung is created from the events in the top.
+ * Each event is therefore moved a bounded number of times before being
+ * removed, and the bottom holds a bounded number of events in the common
+ * case, which gives an amortized constant time per event.
+ *
+ * All the tiers are contiguous vectors whose storage is reused as events
+ * flow from the top to the bottom: once the scheduler has reached its
+ * working size, inserting and removing events does not allocate memory.
+ *
+ * Events scheduled earlier than the current bucket of the lowest rung
+ * (typically, events scheduled in the very near future) are inserted
+ * directly into the bottom. Since the bottom is sorted in decreasing
+ * order, events scheduled at the current time are inserted at its end
+ * without moving any other event. When the bottom grows beyond
+ * \c Threshold events, they are spread over a new, lowest rung.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time  | Reason
+ * :----------- | :--------------- | :-----
+ * Insert()     | ~Constant        | Bucket index computation; bounded bottom size
+ * IsEmpty()    | Constant         | Non-empty bottom if the queue is not empty
+ * PeekNext()   | Constant         | Last event of the bottom
+ * Remove()     | ~Constant        | Search within bucket
+ * RemoveNext() | ~Constant        | Bounded number of moves per event
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | Reused bucket vectors            | `std::vector`
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Bucket type. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the ladder. */
+  struct Rung
+  {
+    uint64_t m_start;          /**< Timestamp of the start of the first bucket. */
+    uint64_t m_width;          /**< Time span of each bucket. */
+    std::size_t m_nBuckets;    /**< Number of buckets in use. */
+    std::size_t m_current;     /**< Index of the first bucket not yet consumed. */
+    std::vector<Bucket> m_buckets; /**< The buckets (at least m_nBuckets). */
+  };
+
+  /**
+   * Move events down the ladder until the bottom is not empty, unless
+   * the scheduler holds no event.
+   */
+  void FillBottom (void);
+  /**
+   * Spread a set of events over a new, lowest rung.
+   *
+   * \param [in] start The timestamp of the start of the new rung.
+   * \param [in] span The time span covered by the new rung.
+   * \param [in,out] events The events to move, which is emptied.
+   */
+  void AddRung (uint64_t start, uint64_t span, Bucket &events);
+  /**
+   * Find the rung whose time span includes a timestamp.
+   *
+   * \param [in] ts The timestamp, which must be earlier than the start of the top.
+   * \returns The index of the rung, or the number of rungs in use if the
+   *          timestamp belongs to the bottom.
+   */
+  std::size_t FindRung (uint64_t ts) const;
+
+  /** Events stored in the top. */
+  Bucket m_top;
+  /** Smallest timestamp of the events stored in the top. */
+  uint64_t m_topMin;
+  /** Largest timestamp of the events stored in the top. */
+  uint64_t m_topMax;
+  /** Events with a timestamp not earlier than this are stored in the top. */
+  uint64_t m_topStart;
+  /** The rungs, including those not in use whose storage is kept. */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  std::size_t m_nRungs;
+  /** Events stored in the bottom, sorted in decreasing order. */
+  Bucket m_bottom;
+  /** Number of events above which a bucket is spread over a new rung. */
+  uint32_t m_threshold;
+  /** Maximum number of rungs. */
+  uint32_t m_maxRungs;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
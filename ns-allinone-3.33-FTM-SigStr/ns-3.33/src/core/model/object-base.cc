@@ -81,6 +81,7 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
 {
   // loop over the inheritance tree back to the Object base class.
   NS_LOG_FUNCTION (this << &attributes);
+  const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
   TypeId tid = GetInstanceTypeId ();
   do
     {
@@ -126,7 +127,6 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
             }
 
           // No matching attribute value so we try to look at the env var.
-          const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
           if (envVar != 0 && std::strlen (envVar) > 0)
             {
               std::string env = envVar;
@@ -102,6 +102,7 @@ Object::Object ()
 {
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
+  std::memset (m_aggregates->cacheTid, 0, sizeof (m_aggregates->cacheTid));
   m_aggregates->buffer[0] = this;
 }
 Object::~Object ()
@@ -118,6 +119,8 @@ Object::~Object ()
                         &m_aggregates->buffer[i + 1],
                         sizeof (Object *) * (m_aggregates->n - (i + 1)));
           m_aggregates->n--;
+          // the cache might point to this object
+          std::memset (m_aggregates->cacheTid, 0, sizeof (m_aggregates->cacheTid));
         }
     }
   // finally, if all objects have been removed from the list,
@@ -136,6 +139,7 @@ Object::Object (const Object &o)
     m_getObjectCount (0)
 {
   m_aggregates->n = 1;
+  std::memset (m_aggregates->cacheTid, 0, sizeof (m_aggregates->cacheTid));
   m_aggregates->buffer[0] = this;
 }
 void
@@ -151,33 +155,37 @@ Object::DoGetObject (TypeId tid) const
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (CheckLoose ());
 
+  uint16_t uid = tid.GetUid ();
+  uint32_t slot = uid % (sizeof (m_aggregates->cacheTid) / sizeof (m_aggregates->cacheTid[0]));
+  if (m_aggregates->cacheTid[slot] == uid)
+    {
+      return m_aggregates->cacheObject[slot];
+    }
+
+  Object *found = 0;
   uint32_t n = m_aggregates->n;
-  TypeId objectTid = Object::GetTypeId ();
   for (uint32_t i = 0; i < n; i++)
     {
       Object *current = m_aggregates->buffer[i];
       TypeId cur = current->GetInstanceTypeId ();
-      while (cur != tid && cur != objectTid)
+      if (cur == tid || cur.IsChildOf (tid))
         {
-          cur = cur.GetParent ();
-        }
-      if (cur == tid)
-        {
-          // This is an attempt to 'cache' the result of this lookup.
-          // the idea is that if we perform a lookup for a TypeId on this object,
-          // we are likely to perform the same lookup later so, we make sure
-          // that the aggregate array is sorted by the number of accesses
-          // to each object.
+          // The aggregate array is sorted by the number of accesses
+          // to each object, so that the lookups which miss the cache
+          // find the most used objects first.
 
           // first, increment the access count
           current->m_getObjectCount++;
           // then, update the sort
           UpdateSortedArray (m_aggregates, i);
-          // finally, return the match
-          return const_cast<Object *> (current);
+          found = current;
+          break;
         }
     }
-  return 0;
+  // finally, cache the result, even if there is no match
+  m_aggregates->cacheTid[slot] = uid;
+  m_aggregates->cacheObject[slot] = found;
+  return found;
 }
 void
 Object::Initialize (void)
@@ -263,6 +271,7 @@ Object::AggregateObject (Ptr<Object> o)
   struct Aggregates *aggregates =
     (struct Aggregates *)std::malloc (sizeof(struct Aggregates) + (total - 1) * sizeof(Object*));
   aggregates->n = total;
+  std::memset (aggregates->cacheTid, 0, sizeof (aggregates->cacheTid));
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0],
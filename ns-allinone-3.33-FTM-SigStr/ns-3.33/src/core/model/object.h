@@ -341,11 +341,19 @@ private:
    * chunk of memory than the struct to allow space for a larger
    * variable sized buffer whose size is indicated by the element
    * \c n
+   *
+   * It also holds a small direct-mapped cache of the results of
+   * DoGetObject(), indexed by the TypeId uid. A new list is allocated
+   * by AggregateObject(), which thus starts with an empty cache.
    */
   struct Aggregates
   {
     /** The number of entries in \c buffer. */
     uint32_t n;
+    /** The TypeId uid of each cache entry, or 0 if the entry is empty. */
+    uint16_t cacheTid[8];
+    /** The Object of each cache entry, or 0 if none matches the TypeId. */
+    Object *cacheObject[8];
     /** The array of Objects. */
     Object *buffer[1];
   };
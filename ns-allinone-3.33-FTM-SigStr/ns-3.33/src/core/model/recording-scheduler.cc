@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "recording-scheduler.h"
+#include "map-scheduler.h"
+#include "object-factory.h"
+#include "string.h"
+#include "abort.h"
+#include "log.h"
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::RecordingScheduler class implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RecordingScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (RecordingScheduler);
+
+TypeId
+RecordingScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RecordingScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<RecordingScheduler> ()
+    .AddAttribute ("Scheduler",
+                   "The type of the scheduler which holds the events.",
+                   TypeIdValue (MapScheduler::GetTypeId ()),
+                   MakeTypeIdAccessor (&RecordingScheduler::SetScheduler,
+                                       &RecordingScheduler::GetScheduler),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("FileName",
+                   "The name of the file the operations are written to.",
+                   StringValue ("scheduler.sched"),
+                   MakeStringAccessor (&RecordingScheduler::SetFileName,
+                                       &RecordingScheduler::GetFileName),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+RecordingScheduler::RecordingScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+RecordingScheduler::~RecordingScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+RecordingScheduler::SetScheduler (TypeId tid)
+{
+  NS_LOG_FUNCTION (this << tid);
+  NS_ABORT_MSG_IF (tid == GetTypeId (), "RecordingScheduler cannot record itself");
+  ObjectFactory factory;
+  factory.SetTypeId (tid);
+  Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+  if (m_scheduler != 0)
+    {
+      while (!m_scheduler->IsEmpty ())
+        {
+          scheduler->Insert (m_scheduler->RemoveNext ());
+        }
+    }
+  m_scheduler = scheduler;
+}
+
+TypeId
+RecordingScheduler::GetScheduler (void) const
+{
+  return m_scheduler->GetInstanceTypeId ();
+}
+
+void
+RecordingScheduler::SetFileName (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  if (m_file.is_open ())
+    {
+      m_file.close ();
+    }
+  m_fileName = fileName;
+}
+
+std::string
+RecordingScheduler::GetFileName (void) const
+{
+  return m_fileName;
+}
+
+void
+RecordingScheduler::Record (char op, const Event &ev)
+{
+  if (!m_file.is_open ())
+    {
+      // opened on the first operation, so that the default file is not
+      // created when the attribute is set after the construction
+      m_file.open (m_fileName.c_str (), std::ios::out | std::ios::trunc);
+      NS_ABORT_MSG_UNLESS (m_file.is_open (), "Cannot open " << m_fileName);
+    }
+  m_file << op << ' ' << ev.key.m_ts << ' ' << ev.key.m_uid << '\n';
+}
+
+void
+RecordingScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  Record ('i', ev);
+  m_scheduler->Insert (ev);
+}
+
+bool
+RecordingScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_scheduler->IsEmpty ();
+}
+
+Scheduler::Event
+RecordingScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_scheduler->PeekNext ();
+}
+
+Scheduler::Event
+RecordingScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  Event ev = m_scheduler->RemoveNext ();
+  Record ('n', ev);
+  return ev;
+}
+
+void
+RecordingScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  Record ('r', ev);
+  m_scheduler->Remove (ev);
+}
+
+} // namespace ns3
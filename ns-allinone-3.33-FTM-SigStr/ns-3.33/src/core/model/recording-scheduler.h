@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RECORDING_SCHEDULER_H
+#define RECORDING_SCHEDULER_H
+
+#include "scheduler.h"
+#include "ptr.h"
+#include "type-id.h"
+#include <fstream>
+#include <string>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::RecordingScheduler class declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a scheduler which records the operations of another scheduler
+ *
+ * This scheduler forwards every operation to the scheduler of type
+ * \c Scheduler, and appends it to the file \c FileName, so that the
+ * sequence of operations of a real scenario can later be replayed
+ * against every scheduler by utils/bench-scheduler.cc.
+ * For example:
+ *
+ * \code
+ *   ./waf --run "wifi-example --SchedulerType=ns3::RecordingScheduler
+ *                             --ns3::RecordingScheduler::FileName=wifi.sched"
+ *   ./waf --run "bench-scheduler --file=wifi.sched"
+ * \endcode
+ *
+ * The file is a text file with one operation per line: the operation
+ * (\c i for Insert(), \c n for RemoveNext() and \c r for Remove()),
+ * followed by the timestamp and the unique id of the event. Cancelled
+ * events are only removed from the scheduler when they expire, hence
+ * they appear as RemoveNext() operations.
+ */
+class RecordingScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  RecordingScheduler ();
+  /** Destructor. */
+  virtual ~RecordingScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /**
+   * Set the type of the scheduler which holds the events.
+   *
+   * \param [in] tid The TypeId of the scheduler.
+   */
+  void SetScheduler (TypeId tid);
+  /**
+   * \returns The type of the scheduler which holds the events.
+   */
+  TypeId GetScheduler (void) const;
+  /**
+   * Set the name of the file the operations are written to.
+   *
+   * \param [in] fileName The name of the file.
+   */
+  void SetFileName (std::string fileName);
+  /**
+   * \returns The name of the file the operations are written to.
+   */
+  std::string GetFileName (void) const;
+  /**
+   * Write an operation to the file.
+   *
+   * \param [in] op The operation code.
+   * \param [in] ev The event.
+   */
+  void Record (char op, const Scheduler::Event &ev);
+
+  /** The scheduler which holds the events. */
+  Ptr<Scheduler> m_scheduler;
+  /** The name of the file the operations are written to. */
+  std::string m_fileName;
+  /** The file the operations are written to. */
+  std::ofstream m_file;
+};
+
+} // namespace ns3
+
+#endif /* RECORDING_SCHEDULER_H */
@@ -57,7 +57,9 @@ class EventImpl;
  * practice is to benchmark each Scheduler on the model of interest.
  * The utility program utils/bench-simulator.cc can do simple benchmarking
  * of each SchedulerImpl against an exponential or user-provided
- * event time distribution.
+ * event time distribution. The utility program utils/bench-scheduler.cc
+ * replays against each SchedulerImpl the operations recorded by the
+ * RecordingScheduler while running the model of interest.
  *
  * The most important Scheduler functions for time performance are (usually)
  * Scheduler::Insert (for new events) and Scheduler::RemoveNext (for pulling
@@ -110,6 +112,14 @@ class EventImpl;
  *      <td class="markdownTableBodyLeft"> 0 </td>
  * </tr>
  * <tr class="markdownTableBody">
+ *      <td class="markdownTableBodyLeft"> LadderScheduler </td>
+ *      <td class="markdownTableBodyLeft"> Ladder of `std::vector` buckets </td>
+ *      <td class="markdownTableBodyLeft"> ~Constant </td>
+ *      <td class="markdownTableBodyLeft"> ~Constant </td>
+ *      <td class="markdownTableBodyLeft"> Reused buckets </td>
+ *      <td class="markdownTableBodyLeft"> 0 </td>
+ * </tr>
+ * <tr class="markdownTableBody">
  *      <td class="markdownTableBodyLeft"> ListScheduler </td>
  *      <td class="markdownTableBodyLeft"> `std::list` </td>
  *      <td class="markdownTableBodyLeft"> Linear </td>
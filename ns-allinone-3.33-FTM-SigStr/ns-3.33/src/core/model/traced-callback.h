@@ -30,6 +30,32 @@
  * ns3::TracedCallback declaration and template implementation.
  */
 
+/**
+ * \ingroup tracing
+ * \brief Invoke a TracedCallback only when a Callback is connected.
+ *
+ * The arguments are not evaluated when the chain of Callbacks is
+ * empty, which avoids building them (Ptr copies, structs or maps)
+ * on hot paths when nothing listens to the trace source.
+ * For example:
+ *
+ * \code
+ *   NS_TRACE (m_phyRxBeginTrace, psdu->GetPacket (), rxPowersW);
+ * \endcode
+ *
+ * \param [in] trace The TracedCallback to invoke.
+ * \param [in] ... The arguments to the TracedCallback.
+ */
+#define NS_TRACE(trace, ...)                    \
+  do                                            \
+    {                                           \
+      if (!(trace).IsEmpty ())                  \
+        {                                       \
+          (trace)(__VA_ARGS__);                 \
+        }                                       \
+    }                                           \
+  while (false)
+
 namespace ns3 {
 
 /**
@@ -89,6 +115,15 @@ public:
    * \param [in] args The arguments to the functor
    */
   void operator() (Ts... args) const;
+  /**
+   * Check whether any Callback is connected.
+   *
+   * Use NS_TRACE() to skip the construction of the arguments
+   * of the chain when it is empty.
+   *
+   * \return \c true if the chain of Callbacks is empty.
+   */
+  bool IsEmpty (void) const;
 
   /**
    *  TracedCallback signature for POD.
@@ -187,6 +222,12 @@ TracedCallback<Ts...>::operator() (Ts... args) const
       (*i)(args...);
     }
 }
+template<typename... Ts>
+bool
+TracedCallback<Ts...>::IsEmpty (void) const
+{
+  return m_callbackList.empty ();
+}
 
 } // namespace ns3
 
@@ -24,6 +24,7 @@
 #include "trace-source-accessor.h"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <iomanip>
@@ -143,6 +144,13 @@ public:
    * \returns The parent type id of the type id.
    */
   uint16_t GetParent (uint16_t uid) const;
+  /**
+   * Check if a type id is a descendant of another one.
+   * \param [in] uid The id.
+   * \param [in] ancestor The id of the candidate ancestor.
+   * \returns \c true if \pname{ancestor} is a strict ancestor of \pname{uid}.
+   */
+  bool IsChildOf (uint16_t uid, uint16_t ancestor) const;
   /**
    * Get the group name of a type id.
    * \param [in] uid The id.
@@ -229,6 +237,14 @@ public:
    * \returns The information associated to attribute whose index is \pname{i}.
    */
   struct TypeId::AttributeInformation GetAttribute (uint16_t uid, std::size_t i) const;
+  /**
+   * Find an Attribute of a type id by name, without looking at its parents.
+   * \param [in] uid The id.
+   * \param [in] name The Attribute name.
+   * \param [out] i The index of the Attribute.
+   * \returns \c true if \pname{uid} has the Attribute \pname{name}.
+   */
+  bool FindAttribute (uint16_t uid, std::string name, std::size_t *i) const;
   /**
    * Record a new TraceSource.
    * \param [in] uid The id.
@@ -264,6 +280,14 @@ public:
    * \returns Detailed information about the requested trace source.
    */
   struct TypeId::TraceSourceInformation GetTraceSource (uint16_t uid, std::size_t i) const;
+  /**
+   * Find a TraceSource of a type id by name, without looking at its parents.
+   * \param [in] uid The id.
+   * \param [in] name The TraceSource name.
+   * \param [out] i The index of the TraceSource.
+   * \returns \c true if \pname{uid} has the TraceSource \pname{name}.
+   */
+  bool FindTraceSource (uint16_t uid, std::string name, std::size_t *i) const;
   /**
    * Check if this TypeId should not be listed in documentation.
    * \param [in] uid The id.
@@ -302,6 +326,11 @@ private:
     TypeId::hash_t hash;
     /** The parent type id. */
     uint16_t parent;
+    /**
+     * The ancestors of the type id: bit \c i is set if the type id
+     * with uid \c i is a strict ancestor.
+     */
+    std::vector<bool> ancestors;
     /** The group name. */
     std::string groupName;
     /** The size of the object represented by this type id. */
@@ -314,8 +343,12 @@ private:
     bool mustHideFromDocumentation;
     /** The container of Attributes. */
     std::vector<struct TypeId::AttributeInformation> attributes;
+    /** The index of the Attributes by name. */
+    std::unordered_map<std::string, std::size_t> attributeIndex;
     /** The container of TraceSources. */
     std::vector<struct TypeId::TraceSourceInformation> traceSources;
+    /** The index of the TraceSources by name. */
+    std::unordered_map<std::string, std::size_t> traceSourceIndex;
     /** Support level/deprecation. */
     TypeId::SupportLevel supportLevel;
     /** Support message. */
@@ -335,7 +368,7 @@ private:
   std::vector<struct IidInformation> m_information;
 
   /** Type of the by-name index. */
-  typedef std::map<std::string, uint16_t> namemap_t;
+  typedef std::unordered_map<std::string, uint16_t> namemap_t;
   /** The by-name index. */
   namemap_t m_namemap;
 
@@ -471,6 +504,18 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  // TypeId::SetParent<T>() registers T first, so the ancestors of the
+  // parent are already known
+  information->ancestors.clear ();
+  if (parent != 0 && parent != uid)
+    {
+      information->ancestors = LookupInformation (parent)->ancestors;
+      if (information->ancestors.size () <= parent)
+        {
+          information->ancestors.resize (parent + 1, false);
+        }
+      information->ancestors[parent] = true;
+    }
 }
 void
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -559,6 +604,14 @@ IidManager::GetParent (uint16_t uid) const
   NS_LOG_LOGIC (IIDL << pid);
   return pid;
 }
+bool
+IidManager::IsChildOf (uint16_t uid, uint16_t ancestor) const
+{
+  NS_LOG_FUNCTION (IID << uid << ancestor);
+  struct IidInformation *information = LookupInformation (uid);
+  return ancestor < information->ancestors.size ()
+         && information->ancestors[ancestor];
+}
 std::string
 IidManager::GetGroupName (uint16_t uid) const
 {
@@ -620,14 +673,10 @@ IidManager::HasAttribute (uint16_t uid,
   struct IidInformation *information  = LookupInformation (uid);
   while (true)
     {
-      for (std::vector<struct TypeId::AttributeInformation>::const_iterator i = information->attributes.begin ();
-           i != information->attributes.end (); ++i)
+      if (information->attributeIndex.count (name) != 0)
         {
-          if (i->name == name)
-            {
-              NS_LOG_LOGIC (IIDL << true);
-              return true;
-            }
+          NS_LOG_LOGIC (IIDL << true);
+          return true;
         }
       struct IidInformation *parent = LookupInformation (information->parent);
       if (parent == information)
@@ -681,6 +730,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.supportLevel = supportLevel;
   info.supportMsg = supportMsg;
   information->attributes.push_back (info);
+  information->attributeIndex[name] = information->attributes.size () - 1;
   NS_LOG_LOGIC (IIDL << information->attributes.size () - 1);
 }
 void
@@ -714,6 +764,21 @@ IidManager::GetAttribute (uint16_t uid, std::size_t i) const
   NS_LOG_LOGIC (IIDL << information->name);
   return information->attributes[i];
 }
+bool
+IidManager::FindAttribute (uint16_t uid, std::string name, std::size_t *i) const
+{
+  NS_LOG_FUNCTION (IID << uid << name << i);
+  struct IidInformation *information = LookupInformation (uid);
+  std::unordered_map<std::string, std::size_t>::const_iterator it = information->attributeIndex.find (name);
+  if (it == information->attributeIndex.end ())
+    {
+      NS_LOG_LOGIC (IIDL << false);
+      return false;
+    }
+  *i = it->second;
+  NS_LOG_LOGIC (IIDL << *i);
+  return true;
+}
 
 bool
 IidManager::HasTraceSource (uint16_t uid,
@@ -723,14 +788,10 @@ IidManager::HasTraceSource (uint16_t uid,
   struct IidInformation *information  = LookupInformation (uid);
   while (true)
     {
-      for (std::vector<struct TypeId::TraceSourceInformation>::const_iterator i = information->traceSources.begin ();
-           i != information->traceSources.end (); ++i)
+      if (information->traceSourceIndex.count (name) != 0)
         {
-          if (i->name == name)
-            {
-              NS_LOG_LOGIC (IIDL << true);
-              return true;
-            }
+          NS_LOG_LOGIC (IIDL << true);
+          return true;
         }
       struct IidInformation *parent = LookupInformation (information->parent);
       if (parent == information)
@@ -773,6 +834,7 @@ IidManager::AddTraceSource (uint16_t uid,
   source.supportLevel = supportLevel;
   source.supportMsg = supportMsg;
   information->traceSources.push_back (source);
+  information->traceSourceIndex[name] = information->traceSources.size () - 1;
   NS_LOG_LOGIC (IIDL << information->traceSources.size () - 1);
 }
 std::size_t
@@ -794,6 +856,21 @@ IidManager::GetTraceSource (uint16_t uid, std::size_t i) const
   return information->traceSources[i];
 }
 bool
+IidManager::FindTraceSource (uint16_t uid, std::string name, std::size_t *i) const
+{
+  NS_LOG_FUNCTION (IID << uid << name << i);
+  struct IidInformation *information = LookupInformation (uid);
+  std::unordered_map<std::string, std::size_t>::const_iterator it = information->traceSourceIndex.find (name);
+  if (it == information->traceSourceIndex.end ())
+    {
+      NS_LOG_LOGIC (IIDL << false);
+      return false;
+    }
+  *i = it->second;
+  NS_LOG_LOGIC (IIDL << *i);
+  return true;
+}
+bool
 IidManager::MustHideFromDocumentation (uint16_t uid) const
 {
   NS_LOG_FUNCTION (IID << uid);
@@ -888,29 +965,27 @@ TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInforma
   do
     {
       tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetAttributeN (); i++)
+      std::size_t i;
+      if (IidManager::Get ()->FindAttribute (tid.m_tid, name, &i))
         {
           struct TypeId::AttributeInformation tmp = tid.GetAttribute (i);
-          if (tmp.name == name)
+          if (tmp.supportLevel == TypeId::SUPPORTED)
+            {
+              *info = tmp;
+              return true;
+            }
+          else if (tmp.supportLevel == TypeId::DEPRECATED)
+            {
+              std::cerr << "Attribute '" << name << "' is deprecated: "
+                        << tmp.supportMsg << std::endl;
+              *info = tmp;
+              return true;
+            }
+          else if (tmp.supportLevel == TypeId::OBSOLETE)
             {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "Attribute '" << name << "' is deprecated: "
-                            << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("Attribute '" << name <<
-                                  "' is obsolete, with no fallback: " <<
-                                  tmp.supportMsg);
-                }
+              NS_FATAL_ERROR ("Attribute '" << name <<
+                              "' is obsolete, with no fallback: " <<
+                              tmp.supportMsg);
             }
         }
       nextTid = tid.GetParent ();
@@ -958,12 +1033,7 @@ bool
 TypeId::IsChildOf (TypeId other) const
 {
   NS_LOG_FUNCTION (this << other.GetUid ());
-  TypeId tmp = *this;
-  while (tmp != other && tmp != tmp.GetParent ())
-    {
-      tmp = tmp.GetParent ();
-    }
-  return tmp == other && *this != other;
+  return IidManager::Get ()->IsChildOf (m_tid, other.m_tid);
 }
 std::string
 TypeId::GetGroupName (void) const
@@ -1143,29 +1213,27 @@ TypeId::LookupTraceSourceByName (std::string name,
   do
     {
       tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetTraceSourceN (); i++)
+      std::size_t i;
+      if (IidManager::Get ()->FindTraceSource (tid.m_tid, name, &i))
         {
           tmp = tid.GetTraceSource (i);
-          if (tmp.name == name)
+          if (tmp.supportLevel == TypeId::SUPPORTED)
+            {
+              *info = tmp;
+              return tmp.accessor;
+            }
+          else if (tmp.supportLevel == TypeId::DEPRECATED)
+            {
+              std::cerr << "TraceSource '" << name << "' is deprecated: "
+                        << tmp.supportMsg << std::endl;
+              *info = tmp;
+              return tmp.accessor;
+            }
+          else if (tmp.supportLevel == TypeId::OBSOLETE)
             {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "TraceSource '" << name << "' is deprecated: "
-                            << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("TraceSource '" << name <<
-                                  "' is obsolete, with no fallback: " <<
-                                  tmp.supportMsg);
-                }
+              NS_FATAL_ERROR ("TraceSource '" << name <<
+                              "' is obsolete, with no fallback: " <<
+                              tmp.supportMsg);
             }
         }
       nextTid = tid.GetParent ();
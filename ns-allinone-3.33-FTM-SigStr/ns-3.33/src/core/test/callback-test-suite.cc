@@ -18,6 +18,7 @@
 
 #include "ns3/test.h"
 #include "ns3/callback.h"
+#include "ns3/traced-callback.h"
 #include "ns3/unused.h"
 #include <stdint.h>
 
@@ -595,6 +596,93 @@ NullifyCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (target1.IsNull (), true, "Nullified Callback reports not IsNull()");
 }
 
+// ===========================================================================
+// Test the comparison and the conversion of the Callbacks stored inline
+// ===========================================================================
+class InlineCallbackTestCase : public TestCase
+{
+public:
+  InlineCallbackTestCase ();
+  virtual ~InlineCallbackTestCase ()
+  {}
+
+  void Target1 (int a)
+  {
+    m_sum1 += a;
+  }
+  void Target2 (int a)
+  {
+    m_sum2 += a;
+  }
+  void ContextTarget (std::string context, int a)
+  {
+    m_sum2 += a;
+  }
+  static void StaticTarget (int a)
+  {}
+
+private:
+  virtual void DoRun (void);
+  virtual void DoSetup (void);
+
+  int m_sum1;
+  int m_sum2;
+};
+
+InlineCallbackTestCase::InlineCallbackTestCase ()
+  : TestCase ("Check the comparison and the conversion of Callbacks stored inline")
+{}
+
+void
+InlineCallbackTestCase::DoSetup (void)
+{
+  m_sum1 = 0;
+  m_sum2 = 0;
+}
+
+void
+InlineCallbackTestCase::DoRun (void)
+{
+  Callback<void, int> target1 = MakeCallback (&InlineCallbackTestCase::Target1, this);
+  Callback<void, int> target2 = MakeCallback (&InlineCallbackTestCase::Target2, this);
+  NS_TEST_ASSERT_MSG_EQ (target1.IsEqual (MakeCallback (&InlineCallbackTestCase::Target1, this)), true,
+                         "Same member function and object should be equal");
+  NS_TEST_ASSERT_MSG_EQ (target1.IsEqual (target2), false, "Different member functions should differ");
+  NS_TEST_ASSERT_MSG_EQ (MakeCallback (&InlineCallbackTestCase::StaticTarget).IsEqual (MakeCallback (&InlineCallbackTestCase::StaticTarget)), true,
+                         "Same function should be equal");
+
+  // through a CallbackBase, as done by the trace sources
+  CallbackBase base = target1;
+  Callback<void, int> copy;
+  NS_TEST_ASSERT_MSG_EQ (copy.Assign (base), true, "Cannot assign from CallbackBase");
+  copy (3);
+  NS_TEST_ASSERT_MSG_EQ (m_sum1, 3, "Assigned Callback did not fire");
+
+  // wrapped into a CallbackImpl, then compared with the inline one
+  Callback<void> bound = target1.Bind (4);
+  bound ();
+  NS_TEST_ASSERT_MSG_EQ (m_sum1, 7, "Bound Callback did not fire");
+  typedef CallbackImpl<void, int, empty, empty, empty, empty, empty, empty, empty, empty> Impl;
+  Callback<void, int> materialized (DynamicCast<Impl> (target1.GetImpl ()));
+  NS_TEST_ASSERT_MSG_EQ (materialized.IsNull (), false, "Cannot wrap into a CallbackImpl");
+  NS_TEST_ASSERT_MSG_EQ (materialized.IsEqual (target1), true, "Wrapped Callback should be equal");
+  NS_TEST_ASSERT_MSG_EQ (target1.IsEqual (materialized), true, "Wrapped Callback should be equal");
+  NS_TEST_ASSERT_MSG_EQ (materialized.IsEqual (target2), false, "Wrapped Callback should differ");
+
+  TracedCallback<int> trace;
+  trace.ConnectWithoutContext (target1);
+  trace.ConnectWithoutContext (target2);
+  trace.Connect (MakeCallback (&InlineCallbackTestCase::ContextTarget, this), "context");
+  trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_sum1, 8, "Trace sink did not fire");
+  NS_TEST_ASSERT_MSG_EQ (m_sum2, 2, "Trace sinks did not fire");
+  trace.DisconnectWithoutContext (MakeCallback (&InlineCallbackTestCase::Target1, this));
+  trace.Disconnect (MakeCallback (&InlineCallbackTestCase::ContextTarget, this), "context");
+  trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_sum1, 8, "Disconnected trace sink fired");
+  NS_TEST_ASSERT_MSG_EQ (m_sum2, 3, "Trace sink did not fire");
+}
+
 // ===========================================================================
 // Make sure that various MakeCallback template functions compile and execute.
 // Doesn't check an results of the execution.
@@ -755,6 +843,7 @@ CallbackTestSuite::CallbackTestSuite ()
   AddTestCase (new MakeCallbackTestCase, TestCase::QUICK);
   AddTestCase (new MakeBoundCallbackTestCase, TestCase::QUICK);
   AddTestCase (new NullifyCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new InlineCallbackTestCase, TestCase::QUICK);
   AddTestCase (new MakeCallbackTemplatesTestCase, TestCase::QUICK);
 }
 
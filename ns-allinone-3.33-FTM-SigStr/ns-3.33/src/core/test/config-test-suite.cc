@@ -33,6 +33,7 @@
 #include "ns3/unused.h"
 
 
+#include <algorithm>
 #include <sstream>
 
 /**
@@ -840,6 +841,125 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test for the resolution of parsed Config paths, alone or together.
+ */
+class PathConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  PathConfigTestCase ();
+  /** Destructor. */
+  virtual ~PathConfigTestCase ()
+  {}
+
+  /**
+   * Trace callback without context.
+   * \param oldValue The old value.
+   * \param newValue The new value.
+   */
+  void Trace (int16_t oldValue, int16_t newValue)
+  {
+    NS_UNUSED (oldValue);
+    m_newValue = newValue;
+  }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t m_newValue; //!< Flag to detect tracing result.
+};
+
+PathConfigTestCase::PathConfigTestCase ()
+  : TestCase ("Check the resolution of parsed Config paths and of several paths at once")
+{}
+
+void
+PathConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+
+  //
+  // Create a root namespace object with a vector of four objects two
+  // levels down.  Other test cases leave their own root namespace objects
+  // registered, so the matches are checked against these objects.
+  //
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  root->SetNodeA (a);
+  Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject> ();
+  a->SetNodeB (b);
+  std::vector<Ptr<Object> > objects;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Ptr<ConfigTestObject> obj = CreateObject<ConfigTestObject> ();
+      b->AddNodeB (obj);
+      objects.push_back (obj);
+    }
+
+  //
+  // The path is split once into its elements.
+  //
+  Config::Path path ("NodeA/NodeB/NodesB/[0-1]|3/A");
+  NS_TEST_ASSERT_MSG_EQ (path.GetElements ().size (), 5, "Unexpected number of elements");
+  NS_TEST_ASSERT_MSG_EQ (path.GetLeaf (), "A", "Unexpected leaf");
+  NS_TEST_ASSERT_MSG_EQ (path.GetParent ().GetString (), "/NodeA/NodeB/NodesB/[0-1]|3",
+                         "Unexpected parent");
+
+  //
+  // Resolving several paths at once should find the same objects, with
+  // the same contexts, as resolving each path in turn.
+  //
+  std::vector<Config::Path> paths;
+  paths.push_back (path.GetParent ());
+  paths.push_back (Config::Path ("/NodeA/NodeB/NodesB/*"));
+  paths.push_back (Config::Path ("/NodeA/NodeB"));
+  paths.push_back (Config::Path ("/NodeA/NodeB/NodesB/2"));
+  paths.push_back (Config::Path ("/NodeA/Missing"));
+  std::vector<Config::MatchContainer> batched = Config::LookupMatches (paths);
+  NS_TEST_ASSERT_MSG_EQ (batched.size (), paths.size (), "Unexpected number of containers");
+  for (uint32_t i = 0; i < paths.size (); i++)
+    {
+      Config::MatchContainer single = Config::LookupMatches (paths[i].GetString ());
+      NS_TEST_ASSERT_MSG_EQ (batched[i].GetPath (), single.GetPath (), "Different paths");
+      NS_TEST_ASSERT_MSG_EQ (batched[i].GetN (), single.GetN (), "Different matches for " << single.GetPath ());
+      for (uint32_t j = 0; j < single.GetN (); j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (batched[i].Get (j), single.Get (j), "Different objects for " << single.GetPath ());
+          NS_TEST_ASSERT_MSG_EQ (batched[i].GetMatchedPath (j), single.GetMatchedPath (j),
+                                 "Different contexts for " << single.GetPath ());
+        }
+    }
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      bool matched = std::find (batched[0].Begin (), batched[0].End (), objects[i]) != batched[0].End ();
+      NS_TEST_ASSERT_MSG_EQ (matched, (i != 2), "Unexpected match of object " << i);
+      matched = std::find (batched[1].Begin (), batched[1].End (), objects[i]) != batched[1].End ();
+      NS_TEST_ASSERT_MSG_EQ (matched, true, "Object " << i << " not matched by wildcard");
+    }
+  NS_TEST_ASSERT_MSG_EQ (batched[4].GetN (), 0, "Unexpected match of a missing attribute");
+
+  //
+  // Set an attribute and connect a trace source with parsed paths.
+  //
+  Config::LookupMatches (path.GetParent ()).Set (path.GetLeaf (), IntegerValue (3));
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      objects[i]->GetAttribute ("A", iv);
+      NS_TEST_ASSERT_MSG_EQ ((iv.Get () == 3), (i != 2), "Attribute A of object " << i << " not set as expected");
+    }
+  Config::Path source ("/NodeA/NodeB/NodesB/2/Source");
+  Config::LookupMatches (source.GetParent ())
+    .ConnectWithoutContext (source.GetLeaf (), MakeCallback (&PathConfigTestCase::Trace, this));
+  m_newValue = 0;
+  objects[2]->SetAttribute ("Source", IntegerValue (-5));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -5, "Trace did not fire as expected");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -858,6 +978,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new PathConfigTestCase);
 }
 
 /**
@@ -400,6 +400,19 @@ AggregateObjectTestCase::DoRun (void)
 
   baseA = baseB->GetObject<BaseA> ();
   NS_TEST_ASSERT_MSG_NE (baseA, 0, "Unable to GetObject on released object");
+
+  //
+  // The result of a lookup which failed must not hide an Object aggregated
+  // later, and the Objects must be found through their base classes.
+  //
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB through derivedA");
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+  derivedA->AggregateObject (derivedB);
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), derivedB, "Cannot GetObject (through derivedA) for BaseB Object");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<DerivedB> (), derivedB, "Cannot GetObject (through derivedA) for DerivedB Object");
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (), derivedA, "Cannot GetObject (through derivedB) for BaseA Object");
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (), derivedA, "Cannot GetObject (through derivedB) for BaseA Object twice");
 }
 
 /**
@@ -24,6 +24,18 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include "ns3/recording-scheduler.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/make-event.h"
+#include "ns3/event-impl.h"
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <vector>
 
 using namespace ns3;
 
@@ -465,6 +477,241 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SchedulerOrderingTestCase : public TestCase
+{
+public:
+  SchedulerOrderingTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  ObjectFactory m_schedulerFactory;
+};
+
+SchedulerOrderingTestCase::SchedulerOrderingTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that events are ordered as by the MapScheduler with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+SchedulerOrderingTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+  std::vector<Scheduler::Event> pending;
+  uint64_t now = 0;
+  uint32_t uid = 0;
+
+  for (uint32_t i = 0; i < 20000; i++)
+    {
+      uint32_t action = random->GetInteger (0, 9);
+      if (action < 5 || reference->IsEmpty ())
+        {
+          // insert an event, with many events at the same time or in the near future
+          uint64_t delay;
+          switch (random->GetInteger (0, 3))
+            {
+            case 0:
+              delay = 0;
+              break;
+            case 1:
+              delay = random->GetInteger (0, 100);
+              break;
+            case 2:
+              delay = random->GetInteger (0, 100000);
+              break;
+            default:
+              delay = random->GetInteger (0, 100000000);
+              break;
+            }
+          Scheduler::Event ev = { 0, { now + delay, uid++, 0 } };
+          scheduler->Insert (ev);
+          reference->Insert (ev);
+          pending.push_back (ev);
+        }
+      else if (action < 9)
+        {
+          Scheduler::Event expected = reference->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), false, "The scheduler should not be empty");
+          NS_TEST_ASSERT_MSG_EQ (scheduler->PeekNext ().key.m_uid, expected.key.m_uid, "Unexpected next event");
+          Scheduler::Event ev = scheduler->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.key.m_uid, "Unexpected removed event");
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_ts, expected.key.m_ts, "Unexpected removed event");
+          now = ev.key.m_ts;
+          pending.erase (std::find (pending.begin (), pending.end (), ev));
+        }
+      else
+        {
+          // remove a random pending event
+          std::size_t index = random->GetInteger (0, pending.size () - 1);
+          Scheduler::Event ev = pending[index];
+          pending[index] = pending.back ();
+          pending.pop_back ();
+          scheduler->Remove (ev);
+          reference->Remove (ev);
+        }
+    }
+  while (!reference->IsEmpty ())
+    {
+      Scheduler::Event expected = reference->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), false, "The scheduler should not be empty");
+      NS_TEST_ASSERT_MSG_EQ (scheduler->RemoveNext ().key.m_uid, expected.key.m_uid, "Unexpected removed event");
+    }
+  NS_TEST_EXPECT_MSG_EQ (scheduler->IsEmpty (), true, "The scheduler should be empty");
+}
+
+class RecordingSchedulerTestCase : public TestCase
+{
+public:
+  RecordingSchedulerTestCase ();
+  virtual void DoRun (void);
+  void Event (void);
+  uint32_t m_events;
+};
+
+RecordingSchedulerTestCase::RecordingSchedulerTestCase ()
+  : TestCase ("Check that the RecordingScheduler records the scheduler operations"),
+    m_events (0)
+{}
+
+void
+RecordingSchedulerTestCase::Event (void)
+{
+  m_events++;
+}
+
+void
+RecordingSchedulerTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("recording-scheduler.sched");
+  ObjectFactory factory ("ns3::RecordingScheduler");
+  factory.Set ("Scheduler", TypeIdValue (HeapScheduler::GetTypeId ()));
+  factory.Set ("FileName", StringValue (fileName));
+  Simulator::SetScheduler (factory);
+
+  Simulator::Schedule (NanoSeconds (20), &RecordingSchedulerTestCase::Event, this);
+  EventId removed = Simulator::Schedule (NanoSeconds (10), &RecordingSchedulerTestCase::Event, this);
+  Simulator::Schedule (NanoSeconds (30), &RecordingSchedulerTestCase::Event, this);
+  Simulator::Remove (removed);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (m_events, 2, "The events should run");
+
+  std::ifstream file (fileName.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (file.is_open (), true, "Cannot open " << fileName);
+  const char ops[] = { 'i', 'i', 'i', 'r', 'n', 'n' };
+  const uint64_t ts[] = { 20, 10, 30, 10, 20, 30 };
+  char op;
+  uint64_t timestamp;
+  uint32_t uid;
+  for (uint32_t i = 0; i < sizeof (ops); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (bool (file >> op >> timestamp >> uid), true, "Missing operation " << i);
+      NS_TEST_EXPECT_MSG_EQ (op, ops[i], "Unexpected operation " << i);
+      NS_TEST_EXPECT_MSG_EQ (TimeStep (timestamp), NanoSeconds (ts[i]), "Unexpected timestamp of operation " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (bool (file >> op), false, "Unexpected operation");
+}
+
+#ifdef ENABLE_EVENT_POOL
+class EventPoolTestCase : public TestCase
+{
+public:
+  EventPoolTestCase ();
+  virtual void DoRun (void);
+  void Small (void);
+  void ExitingThread (void);
+  void Large (std::vector<uint64_t> a, std::vector<uint64_t> b, std::vector<uint64_t> c,
+              std::vector<uint64_t> d, std::vector<uint64_t> e, std::vector<uint64_t> f);
+  uint32_t m_small;
+  uint32_t m_large;
+};
+
+EventPoolTestCase::EventPoolTestCase ()
+  : TestCase ("Check that events are allocated from the event pool"),
+    m_small (0),
+    m_large (0)
+{}
+
+void
+EventPoolTestCase::Small (void)
+{
+  m_small++;
+}
+
+void
+EventPoolTestCase::Large (std::vector<uint64_t> a, std::vector<uint64_t> b, std::vector<uint64_t> c,
+                          std::vector<uint64_t> d, std::vector<uint64_t> e, std::vector<uint64_t> f)
+{
+  m_large += a.size () + b.size () + c.size () + d.size () + e.size () + f.size ();
+}
+
+void
+EventPoolTestCase::DoRun (void)
+{
+  EventImpl *event = MakeEvent (&EventPoolTestCase::Small, this);
+  EventImpl *first = event;
+  event->Invoke ();
+  event->Unref ();
+  event = MakeEvent (&EventPoolTestCase::Small, this);
+  NS_TEST_EXPECT_MSG_EQ (event, first, "A released block should be reused by the next event of the same size");
+  event->Invoke ();
+  event->Unref ();
+  NS_TEST_EXPECT_MSG_EQ (m_small, 2, "Events allocated from the pool should be invoked");
+
+  // events larger than the largest block size are allocated from the heap
+  std::vector<uint64_t> v (1);
+  event = MakeEvent (&EventPoolTestCase::Large, this, v, v, v, v, v, v);
+  event->Invoke ();
+  event->Unref ();
+  NS_TEST_EXPECT_MSG_EQ (m_large, 6, "Events allocated from the heap should be invoked");
+
+  Simulator::Schedule (MicroSeconds (1), &EventPoolTestCase::Small, this);
+  Simulator::Schedule (MicroSeconds (2), &EventPoolTestCase::Large, this, v, v, v, v, v, v);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (m_small, 3, "Scheduled pooled events should run");
+  NS_TEST_EXPECT_MSG_EQ (m_large, 12, "Scheduled heap events should run");
+
+  // a thread-local object destroyed after the pool of its thread releases
+  // (and allocates) events while the thread exits
+  std::thread thread (&EventPoolTestCase::ExitingThread, this);
+  thread.join ();
+  NS_TEST_EXPECT_MSG_EQ (m_small, 5, "Events should be usable while the thread exits");
+}
+
+/// Holds an event until the thread exits.
+struct EventHolder
+{
+  EventHolder ()
+    : event (0),
+      test (0)
+  {}
+  ~EventHolder ()
+  {
+    event->Invoke ();
+    event->Unref ();
+    event = MakeEvent (&EventPoolTestCase::Small, test);
+    event->Invoke ();
+    event->Unref ();
+  }
+  EventImpl *event;         //!< The event released at thread exit
+  EventPoolTestCase *test;  //!< The test case
+};
+
+void
+EventPoolTestCase::ExitingThread (void)
+{
+  // constructed before the pool, hence destroyed after it
+  static thread_local EventHolder holder;
+  holder.test = this;
+  holder.event = MakeEvent (&EventPoolTestCase::Small, this);
+}
+#endif /* ENABLE_EVENT_POOL */
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -483,5 +730,15 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SchedulerOrderingTestCase (factory), TestCase::QUICK);
+    // use a small threshold to exercise the creation of the rungs
+    factory.Set ("Threshold", UintegerValue (2));
+    AddTestCase (new SchedulerOrderingTestCase (factory), TestCase::QUICK);
+    AddTestCase (new RecordingSchedulerTestCase (), TestCase::QUICK);
+#ifdef ENABLE_EVENT_POOL
+    AddTestCase (new EventPoolTestCase (), TestCase::QUICK);
+#endif /* ENABLE_EVENT_POOL */
   }
 } g_simulatorTestSuite;
@@ -27,11 +27,13 @@
 #include "ns3/string.h"
 #include "ns3/system-thread.h"
 
+#include <atomic>
 #include <chrono>  // seconds, milliseconds
 #include <ctime>
 #include <list>
 #include <thread>  // sleep_for
 #include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -225,6 +227,96 @@ ThreadedSimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_a, m_d, "Bad scheduling");
 }
 
+class ThreadedSimulatorOrderingTestCase : public TestCase
+{
+public:
+  ThreadedSimulatorOrderingTestCase (uint32_t events, uint32_t threads, bool running);
+  void Event (uint32_t thread, uint32_t index);
+  void Poll (void);
+  static void SchedulingThread (ThreadedSimulatorOrderingTestCase *test, uint32_t thread);
+  uint32_t m_events;
+  uint32_t m_threads;
+  bool m_running;
+  std::atomic<uint32_t> m_done;
+  std::vector<std::vector<uint32_t> > m_received;
+
+private:
+  virtual void DoRun (void);
+};
+
+ThreadedSimulatorOrderingTestCase::ThreadedSimulatorOrderingTestCase (uint32_t events, uint32_t threads, bool running)
+  : TestCase ("Check that " + std::to_string (events) + " events scheduled by each of " +
+              std::to_string (threads) + " other threads " +
+              (running ? "while the simulation runs " : "") +
+              "run in order in ns3::DefaultSimulatorImpl"),
+    m_events (events),
+    m_threads (threads),
+    m_running (running)
+{}
+
+void
+ThreadedSimulatorOrderingTestCase::Event (uint32_t thread, uint32_t index)
+{
+  m_received[thread].push_back (index);
+}
+
+void
+ThreadedSimulatorOrderingTestCase::Poll (void)
+{
+  // keep the simulation running until all the events are scheduled
+  if (m_done.load () < m_threads)
+    {
+      Simulator::Schedule (MicroSeconds (1), &ThreadedSimulatorOrderingTestCase::Poll, this);
+    }
+}
+
+void
+ThreadedSimulatorOrderingTestCase::SchedulingThread (ThreadedSimulatorOrderingTestCase *test, uint32_t thread)
+{
+  for (uint32_t i = 0; i < test->m_events; i++)
+    {
+      Simulator::ScheduleWithContext (i, Seconds (0), &ThreadedSimulatorOrderingTestCase::Event, test, thread, i);
+    }
+  test->m_done++;
+}
+
+void
+ThreadedSimulatorOrderingTestCase::DoRun (void)
+{
+  Simulator::SetScheduler (ObjectFactory ("ns3::MapScheduler"));
+  m_done = 0;
+  m_received.assign (m_threads, std::vector<uint32_t> ());
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 0; i < m_threads; i++)
+    {
+      threads.push_back (Create<SystemThread> (MakeBoundCallback (&ThreadedSimulatorOrderingTestCase::SchedulingThread, this, i)));
+      threads.back ()->Start ();
+    }
+  if (m_running)
+    {
+      // the events are queued while the main thread drains the ring
+      Simulator::Schedule (MicroSeconds (1), &ThreadedSimulatorOrderingTestCase::Poll, this);
+      Simulator::Run ();
+    }
+  for (uint32_t i = 0; i < m_threads; i++)
+    {
+      threads[i]->Join ();
+    }
+  // otherwise, the events are queued before the simulation runs, possibly
+  // more than fit in the ring
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  for (uint32_t i = 0; i < m_threads; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_received[i].size (), m_events, "Some events were lost");
+      for (uint32_t j = 0; j < m_events; j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (m_received[i][j], j, "Events run out of order");
+        }
+    }
+}
+
 class ThreadedSimulatorTestSuite : public TestSuite
 {
 public:
@@ -262,5 +354,8 @@ public:
               }
           }
       }
+    AddTestCase (new ThreadedSimulatorOrderingTestCase (100, 1, false), TestCase::QUICK);
+    AddTestCase (new ThreadedSimulatorOrderingTestCase (5000, 1, false), TestCase::QUICK);
+    AddTestCase (new ThreadedSimulatorOrderingTestCase (5000, 4, true), TestCase::QUICK);
   }
 } g_threadedSimulatorTestSuite;
@@ -113,6 +113,76 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class EmptyTracedCallbackTestCase : public TestCase
+{
+public:
+  EmptyTracedCallbackTestCase ();
+  virtual ~EmptyTracedCallbackTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+
+  void Cb (uint8_t a, double b);
+  double MakeArgument (void);
+
+  uint32_t m_calls;
+  uint32_t m_arguments;
+};
+
+EmptyTracedCallbackTestCase::EmptyTracedCallbackTestCase ()
+  : TestCase ("Check NS_TRACE with and without connected callbacks")
+{}
+
+void
+EmptyTracedCallbackTestCase::Cb (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_calls++;
+}
+
+double
+EmptyTracedCallbackTestCase::MakeArgument (void)
+{
+  m_arguments++;
+  return 2;
+}
+
+void
+EmptyTracedCallbackTestCase::DoRun (void)
+{
+  TracedCallback<uint8_t, double> trace;
+  m_calls = 0;
+  m_arguments = 0;
+
+  //
+  // Without any callback, the arguments of NS_TRACE should not be evaluated.
+  //
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "New TracedCallback not empty");
+  NS_TRACE (trace, 1, MakeArgument ());
+  NS_TEST_ASSERT_MSG_EQ (m_arguments, 0, "Argument evaluated without any callback");
+
+  //
+  // With a callback, NS_TRACE should evaluate the arguments once and
+  // invoke the chain.
+  //
+  trace.ConnectWithoutContext (MakeCallback (&EmptyTracedCallbackTestCase::Cb, this));
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), false, "TracedCallback empty after Connect");
+  NS_TRACE (trace, 1, MakeArgument ());
+  NS_TEST_ASSERT_MSG_EQ (m_arguments, 1, "Argument not evaluated once");
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 1, "Callback not called");
+
+  //
+  // Once the callback is disconnected, the chain is empty again.
+  //
+  trace.DisconnectWithoutContext (MakeCallback (&EmptyTracedCallbackTestCase::Cb, this));
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "TracedCallback not empty after Disconnect");
+  NS_TRACE (trace, 1, MakeArgument ());
+  NS_TEST_ASSERT_MSG_EQ (m_arguments, 1, "Argument evaluated after Disconnect");
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 1, "Callback called after Disconnect");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -123,6 +193,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new EmptyTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
@@ -334,6 +334,84 @@ DeprecatedAttributeTestCase::DoRun (void)
 }
 
 
+//----------------------------
+//
+// Attribute and TraceSource lookup test
+
+class LookupByNameTestCase : public TestCase
+{
+public:
+  LookupByNameTestCase ();
+  virtual ~LookupByNameTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+};
+
+LookupByNameTestCase::LookupByNameTestCase ()
+  : TestCase ("Check the lookup of Attributes and TraceSources by name")
+{}
+
+LookupByNameTestCase::~LookupByNameTestCase ()
+{}
+
+void
+LookupByNameTestCase::DoRun (void)
+{
+  for (uint16_t i = 0; i < TypeId::GetRegisteredN (); ++i)
+    {
+      TypeId tid = TypeId::GetRegistered (i);
+      if (tid.GetParent ().GetUid () == 0)
+        {
+          // no parent set, like the colliding types of CollisionTestCase
+          continue;
+        }
+      for (std::size_t j = 0; j < tid.GetAttributeN (); ++j)
+        {
+          struct TypeId::AttributeInformation expected = tid.GetAttribute (j);
+          if (expected.supportLevel != TypeId::SUPPORTED)
+            {
+              // already checked by DeprecatedAttributeTestCase
+              continue;
+            }
+          struct TypeId::AttributeInformation info;
+          NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName (expected.name, &info), true,
+                                 "lookup attribute " << tid.GetName () << "::" << expected.name);
+          NS_TEST_ASSERT_MSG_EQ (info.accessor, expected.accessor,
+                                 "accessor of attribute " << tid.GetName () << "::" << expected.name);
+        }
+      for (std::size_t j = 0; j < tid.GetTraceSourceN (); ++j)
+        {
+          struct TypeId::TraceSourceInformation expected = tid.GetTraceSource (j);
+          if (expected.supportLevel != TypeId::SUPPORTED)
+            {
+              continue;
+            }
+          NS_TEST_ASSERT_MSG_EQ (tid.LookupTraceSourceByName (expected.name), expected.accessor,
+                                 "lookup trace source " << tid.GetName () << "::" << expected.name);
+        }
+      // the attributes of the parent are found through the child
+      TypeId parent = tid.GetParent ();
+      for (std::size_t j = 0; parent != tid && j < parent.GetAttributeN (); ++j)
+        {
+          if (parent.GetAttribute (j).supportLevel != TypeId::SUPPORTED)
+            {
+              continue;
+            }
+          struct TypeId::AttributeInformation info;
+          NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName (parent.GetAttribute (j).name, &info), true,
+                                 "lookup attribute " << tid.GetName () << "::" << parent.GetAttribute (j).name);
+        }
+      struct TypeId::AttributeInformation info;
+      NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("NoSuchAttribute", &info), false,
+                             "lookup unknown attribute of " << tid.GetName ());
+      NS_TEST_ASSERT_MSG_EQ (tid.LookupTraceSourceByName ("NoSuchTraceSource"), 0,
+                             "lookup unknown trace source of " << tid.GetName ());
+    }
+}
+
+
 //----------------------------
 //
 // Performance test
@@ -394,6 +472,34 @@ LookupTimeTestCase::DoRun (void)
   stop = clock ();
   Report ("hash", stop - start);
 
+  uint32_t nattributes = 0;
+  start = clock ();
+  // fewer repetitions, as each type has several attributes
+  for (uint32_t j = 0; j < REPETITIONS / 10; ++j)
+    {
+      for (uint16_t i = 0; i < nids; ++i)
+        {
+          const TypeId tid = TypeId::GetRegistered (i);
+          for (std::size_t k = 0; k < tid.GetAttributeN (); ++k)
+            {
+              if (tid.GetAttribute (k).supportLevel != TypeId::SUPPORTED)
+                {
+                  continue;
+                }
+              struct TypeId::AttributeInformation info;
+              tid.LookupAttributeByName (tid.GetAttribute (k).name, &info);
+              ++nattributes;
+            }
+        }
+    }
+  stop = clock ();
+  cout << suite << "Lookup time: by attribute name: "
+       << "ticks: " << stop - start
+       << "\tper: "
+       << 1E6 * double(stop - start) / (nattributes * double(CLOCKS_PER_SEC))
+       << " microsec/lookup"
+       << endl;
+
 }
 
 void
@@ -447,6 +553,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
   AddTestCase (new DeprecatedAttributeTestCase, QUICK);
+  AddTestCase (new LookupByNameTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;
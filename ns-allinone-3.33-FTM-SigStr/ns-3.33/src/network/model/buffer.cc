@@ -50,16 +50,35 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 
-uint32_t Buffer::g_recommendedStart = 0;
+bool Buffer::g_perThreadState = false;
+struct Buffer::ThreadState Buffer::g_processState;
+thread_local struct Buffer::ThreadState Buffer::g_threadState;
+
+void
+Buffer::EnablePerThreadState (bool enable)
+{
+  NS_LOG_FUNCTION (enable);
+  g_perThreadState = enable;
+}
+
+struct Buffer::ThreadState &
+Buffer::GetThreadState (void)
+{
+  // the thread-local state is only accessed by parallel simulations: the
+  // access to the state of the process is cheaper
+  return g_perThreadState ? g_threadState : g_processState;
+}
+
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
+ * keep track of 3 possible states for the freeList of a ThreadState:
+ *  - uninitialized means that no one has created a buffer yet with this
+ *    state so no one has created the associated free list (it is created
  *    on-demand when the first buffer is created)
  *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
+ *  - destroyed means that the destructor of the state (a static or a
+ *    thread-local one) has run so, the free list has been cleared from
+ *    its content
  * The key is that in destroyed state, we are careful not re-create it
  * which is a typical weakness of lazy evaluation schemes which use 
  * '0' as a special value to indicate both un-initialized and destroyed.
@@ -75,22 +94,19 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
-struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
-Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
+Buffer::ThreadState::~ThreadState (void)
 {
   NS_LOG_FUNCTION (this);
-  if (IS_INITIALIZED (g_freeList))
+  if (IS_INITIALIZED (freeList))
     {
-      for (Buffer::FreeList::iterator i = g_freeList->begin ();
-           i != g_freeList->end (); i++)
+      for (Buffer::FreeList::iterator i = freeList->begin ();
+           i != freeList->end (); i++)
         {
           Buffer::Deallocate (*i);
         }
-      delete g_freeList;
-      g_freeList = DESTROYED;
+      delete freeList;
+      freeList = DESTROYED;
     }
 }
 
@@ -99,19 +115,20 @@ Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
-  NS_ASSERT (!IS_UNINITIALIZED (g_freeList));
-  g_maxSize = std::max (g_maxSize, data->m_size);
-  /* feed into free list */
-  if (data->m_size < g_maxSize ||
-      IS_DESTROYED (g_freeList) ||
-      g_freeList->size () > 1000)
+  struct ThreadState &state = GetThreadState ();
+  state.maxSize = std::max (state.maxSize, data->m_size);
+  /* feed into free list; the buffer may have been created by another
+   * thread, in which case this thread may have no free list yet */
+  if (data->m_size < state.maxSize ||
+      !IS_INITIALIZED (state.freeList) ||
+      state.freeList->size () > 1000)
     {
       Buffer::Deallocate (data);
     }
   else
     {
-      NS_ASSERT (IS_INITIALIZED (g_freeList));
-      g_freeList->push_back (data);
+      NS_ASSERT (IS_INITIALIZED (state.freeList));
+      state.freeList->push_back (data);
     }
 }
 
@@ -119,17 +136,18 @@ Buffer::Data *
 Buffer::Create (uint32_t dataSize)
 {
   NS_LOG_FUNCTION (dataSize);
+  struct ThreadState &state = GetThreadState ();
   /* try to find a buffer correctly sized. */
-  if (IS_UNINITIALIZED (g_freeList))
+  if (IS_UNINITIALIZED (state.freeList))
     {
-      g_freeList = new Buffer::FreeList ();
+      state.freeList = new Buffer::FreeList ();
     }
-  else if (IS_INITIALIZED (g_freeList))
+  else if (IS_INITIALIZED (state.freeList))
     {
-      while (!g_freeList->empty ()) 
+      while (!state.freeList->empty ()) 
         {
-          struct Buffer::Data *data = g_freeList->back ();
-          g_freeList->pop_back ();
+          struct Buffer::Data *data = state.freeList->back ();
+          state.freeList->pop_back ();
           if (data->m_size >= dataSize) 
             {
               data->m_count = 1;
@@ -143,6 +161,10 @@ Buffer::Create (uint32_t dataSize)
   return data;
 }
 #else /* BUFFER_FREE_LIST */
+Buffer::ThreadState::~ThreadState (void)
+{
+}
+
 void
 Buffer::Recycle (struct Buffer::Data *data)
 {
@@ -245,7 +267,7 @@ Buffer::Initialize (uint32_t zeroSize)
 {
   NS_LOG_FUNCTION (this << zeroSize);
   m_data = Buffer::Create (0);
-  m_start = std::min (m_data->m_size, g_recommendedStart);
+  m_start = std::min (m_data->m_size, GetThreadState ().recommendedStart);
   m_maxZeroAreaStart = m_start;
   m_zeroAreaStart = m_start;
   m_zeroAreaEnd = m_zeroAreaStart + zeroSize;
@@ -270,7 +292,8 @@ Buffer::operator = (Buffer const&o)
       m_data = o.m_data;
       m_data->m_count++;
     }
-  g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+  uint32_t &recommendedStart = GetThreadState ().recommendedStart;
+  recommendedStart = std::max (recommendedStart, m_maxZeroAreaStart);
   m_maxZeroAreaStart = o.m_maxZeroAreaStart;
   m_zeroAreaStart = o.m_zeroAreaStart;
   m_zeroAreaEnd = o.m_zeroAreaEnd;
@@ -284,7 +307,8 @@ Buffer::~Buffer ()
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (CheckInternalState ());
-  g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+  uint32_t &recommendedStart = GetThreadState ().recommendedStart;
+  recommendedStart = std::max (recommendedStart, m_maxZeroAreaStart);
   m_data->m_count--;
   if (m_data->m_count == 0) 
     {
@@ -642,6 +642,17 @@ private:
    */
   Buffer (uint32_t dataSize, bool initialize);
   ~Buffer ();
+
+  /**
+   * \brief Give each thread its own free list and heuristics.
+   *
+   * By default, the buffers share the free list and the heuristics of
+   * the process, which may only be used by one thread. A parallel
+   * simulator enables the per-thread state while its threads run.
+   *
+   * \param enable whether each thread has its own state
+   */
+  static void EnablePerThreadState (bool enable);
 private:
   /**
    * This data structure is variable-sized through its last member whose size
@@ -762,12 +773,6 @@ private:
    * m_zeroAreaStart.
    */
   uint32_t m_maxZeroAreaStart;
-  /**
-   * location in a newly-allocated buffer where you should start
-   * writing data. i.e., m_start should be initialized to this 
-   * value.
-   */
-  static uint32_t g_recommendedStart;
 
   /**
    * offset to the start of the virtual zero area from the start
@@ -793,15 +798,36 @@ private:
 #ifdef BUFFER_FREE_LIST
   /// Container for buffer data
   typedef std::vector<struct Buffer::Data*> FreeList;
-  /// Local static destructor structure
-  struct LocalStaticDestructor 
+#endif
+  /**
+   * \brief The heuristics and the free list of the buffers of a thread.
+   *
+   * It has no constructor: its members are zero-initialized before any
+   * constructor runs, so that buffers may be created by static constructors.
+   */
+  struct ThreadState
   {
-    ~LocalStaticDestructor ();
-  };
-  static uint32_t g_maxSize; //!< Max observed data size
-  static FreeList *g_freeList; //!< Buffer data container
-  static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+    ~ThreadState ();
+    /**
+     * location in a newly-allocated buffer where you should start
+     * writing data. i.e., m_start should be initialized to this 
+     * value.
+     */
+    uint32_t recommendedStart;
+#ifdef BUFFER_FREE_LIST
+    uint32_t maxSize; //!< Max observed data size
+    FreeList *freeList; //!< Buffer data container
 #endif
+  };
+  /**
+   * \brief Get the state of the calling thread
+   * \returns the state of the process, unless each thread has its own state
+   */
+  static struct ThreadState &GetThreadState (void);
+
+  static bool g_perThreadState; //!< Whether each thread has its own state
+  static struct ThreadState g_processState; //!< State of the process
+  static thread_local struct ThreadState g_threadState; //!< State of the calling thread
 };
 
 } // namespace ns3
@@ -57,8 +57,26 @@ static class ByteTagListDataFreeList : public std::vector<struct ByteTagListData
 {
 public:
   ~ByteTagListDataFreeList ();
-} g_freeList; //!< Container for struct ByteTagListData
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+  uint32_t maxSize = 0; //!< maximum data size (used for allocation)
+} g_freeList; //!< Container for struct ByteTagListData of the process
+static thread_local ByteTagListDataFreeList g_threadFreeList; //!< Container for struct ByteTagListData of the calling thread
+static bool g_perThreadFreeList = false; //!< Whether each thread has its own free list
+
+/**
+ * \ingroup packet
+ *
+ * \brief Get the free list of the calling thread
+ *
+ * The thread-local free lists are only accessed by parallel simulations:
+ * the access to the free list of the process is cheaper.
+ *
+ * \returns the free list of the process, unless each thread has its own
+ */
+static ByteTagListDataFreeList &
+GetFreeList (void)
+{
+  return g_perThreadFreeList ? g_threadFreeList : g_freeList;
+}
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList ()
 {
@@ -72,6 +90,15 @@ ByteTagListDataFreeList::~ByteTagListDataFreeList ()
 }
 #endif /* USE_FREE_LIST */
 
+void
+ByteTagList::EnablePerThreadState (bool enable)
+{
+  NS_LOG_FUNCTION (enable);
+#ifdef USE_FREE_LIST
+  g_perThreadFreeList = enable;
+#endif /* USE_FREE_LIST */
+}
+
 ByteTagList::Iterator::Item::Item (TagBuffer buf_)
   : buf (buf_)
 {
@@ -345,10 +372,11 @@ struct ByteTagListData *
 ByteTagList::Allocate (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
-  while (!g_freeList.empty ())
+  ByteTagListDataFreeList &freeList = GetFreeList ();
+  while (!freeList.empty ())
     {
-      struct ByteTagListData *data = g_freeList.back ();
-      g_freeList.pop_back ();
+      struct ByteTagListData *data = freeList.back ();
+      freeList.pop_back ();
       NS_ASSERT (data != 0);
       if (data->size >= size)
         {
@@ -359,7 +387,7 @@ ByteTagList::Allocate (uint32_t size)
       uint8_t *buffer = (uint8_t *)data;
       delete [] buffer;
     }
-  uint8_t *buffer = new uint8_t [std::max (size, g_maxSize) + sizeof (struct ByteTagListData) - 4];
+  uint8_t *buffer = new uint8_t [std::max (size, freeList.maxSize) + sizeof (struct ByteTagListData) - 4];
   struct ByteTagListData *data = (struct ByteTagListData *)buffer;
   data->count = 1;
   data->size = size;
@@ -375,19 +403,20 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
     {
       return;
     }
-  g_maxSize = std::max (g_maxSize, data->size);
+  ByteTagListDataFreeList &freeList = GetFreeList ();
+  freeList.maxSize = std::max (freeList.maxSize, data->size);
   data->count--;
   if (data->count == 0)
     {
-      if (g_freeList.size () > FREE_LIST_SIZE ||
-          data->size < g_maxSize)
+      if (freeList.size () > FREE_LIST_SIZE ||
+          data->size < freeList.maxSize)
         {
           uint8_t *buffer = (uint8_t *)data;
           delete [] buffer;
         }
       else
         {
-          g_freeList.push_back (data);
+          freeList.push_back (data);
         }
     }
 }
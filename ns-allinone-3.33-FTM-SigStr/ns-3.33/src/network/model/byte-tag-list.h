@@ -169,6 +169,17 @@ private:
   ByteTagList &operator = (const ByteTagList &o);
   ~ByteTagList ();
 
+  /**
+   * \brief Give each thread its own free list.
+   *
+   * By default, the lists share the free list of the process, which may
+   * only be used by one thread. A parallel simulator enables the
+   * per-thread state while its threads run.
+   *
+   * \param enable whether each thread has its own free list
+   */
+  static void EnablePerThreadState (bool enable);
+
   /**
    * \param tid the typeid of the tag added
    * \param bufferSize the size of the tag when its serialization will 
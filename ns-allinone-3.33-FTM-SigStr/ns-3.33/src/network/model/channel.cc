@@ -19,16 +19,22 @@
 #include "channel.h"
 #include "channel-list.h"
 #include "net-device.h"
+#include "node.h"
 
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/uinteger.h"
 
+#include <vector>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Channel");
 
 NS_OBJECT_ENSURE_REGISTERED (Channel);
 
+Channel::RemoteDeviceFunction Channel::g_remoteDevice = 0;
+
 TypeId 
 Channel::GetTypeId (void)
 {
@@ -62,4 +68,33 @@ Channel::GetId (void) const
   return m_id;
 }
 
+void
+Channel::SetRemoteDeviceFunction (RemoteDeviceFunction function)
+{
+  NS_LOG_FUNCTION (function);
+  g_remoteDevice = function;
+}
+
+bool
+Channel::IsRemoteDevice (const NetDevice *device, uint32_t *node)
+{
+  if (g_remoteDevice == 0)
+    {
+      *node = device->GetNode ()->GetId ();
+      return false;
+    }
+  return g_remoteDevice (device, node);
+}
+
+Ptr<Packet>
+Channel::DeepCopy (Ptr<const Packet> packet)
+{
+  uint32_t size = packet->GetSerializedSize ();
+  // Packet::Serialize() writes 32-bit words
+  std::vector<uint32_t> buffer ((size + 3) / 4);
+  uint8_t *data = reinterpret_cast<uint8_t *> (&buffer[0]);
+  NS_ABORT_MSG_IF (packet->Serialize (data, size) == 0, "Failed to serialize packet " << packet->GetUid ());
+  return Create<Packet> (data, size, true);
+}
+
 } // namespace ns3
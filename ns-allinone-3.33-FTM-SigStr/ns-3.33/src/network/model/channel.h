@@ -21,6 +21,9 @@
 #include <stdint.h>
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
 
 namespace ns3 {
 
@@ -39,6 +42,10 @@ class NetDevice;
  *
  * Subclasses must use Simulator::ScheduleWithContext to correctly update
  * event contexts when scheduling an event from one node to another one.
+ * The channels whose devices may be simulated by different threads, e.g.,
+ * by a parallel simulator implementation, must deliver their packets with
+ * ScheduleReceive() and must not share any other state between the
+ * threads of their devices.
  */
 class Channel : public Object
 {
@@ -74,10 +81,96 @@ public:
    */
   virtual Ptr<NetDevice> GetDevice (std::size_t i) const = 0;
 
+  /**
+   * Function telling whether a device is simulated by another thread than
+   * the calling one.
+   *
+   * \param [in] device The device.
+   * \param [out] node The ID of the node of the device.
+   * \returns \c true if the device is simulated by another thread.
+   */
+  typedef bool (* RemoteDeviceFunction)(const NetDevice *device, uint32_t *node);
+  /**
+   * Set the function telling which devices are simulated by other threads.
+   *
+   * This function is set by the simulator implementations which execute
+   * the events of several nodes concurrently, while they do so. It must
+   * not be changed while other threads execute events.
+   *
+   * \param [in] function The function, or 0 if all the devices are
+   *            simulated by the calling thread.
+   */
+  static void SetRemoteDeviceFunction (RemoteDeviceFunction function);
+
+protected:
+  /**
+   * \param [in] device A device.
+   * \param [out] node The ID of the node of the device.
+   * \returns \c true if the device is simulated by another thread than the
+   *          calling one.
+   */
+  static bool IsRemoteDevice (const NetDevice *device, uint32_t *node);
+  /**
+   * Copy a packet through its serialization, so that the copy shares no
+   * data with the original packet. The serialization includes the byte
+   * tags, the packet tags and the nix-vector of the packet: the tag types
+   * are looked up by the hash of their TypeId.
+   *
+   * \param [in] packet The packet.
+   * \returns The copy.
+   */
+  static Ptr<Packet> DeepCopy (Ptr<const Packet> packet);
+  /**
+   * Schedule the reception of a packet by a device, in the context of the
+   * node of the device.
+   *
+   * When the device is simulated by another thread than the calling one,
+   * the device receives a copy of the packet made through its
+   * serialization, and the event only references the device once it is
+   * executed by the thread of its node.
+   *
+   * \tparam DEVICE \deduced The class of the device.
+   * \tparam Us \deduced The types of the other parameters of the method.
+   * \tparam Ts \deduced The types of the other arguments.
+   * \param [in] device The receiving device.
+   * \param [in] delay The delay of the reception.
+   * \param [in] receive The method of the device receiving the packet.
+   * \param [in] packet The packet.
+   * \param [in] args The other arguments of the method.
+   * \returns \c true if the device is simulated by another thread, in
+   *          which case the caller must not reference the device either.
+   */
+  template <typename DEVICE, typename... Us, typename... Ts>
+  static bool ScheduleReceive (const Ptr<DEVICE> &device, const Time &delay,
+                               void (DEVICE::*receive)(Ptr<Packet>, Us...),
+                               Ptr<const Packet> packet, Ts... args);
+
 private:
   uint32_t m_id; //!< Channel id for this channel
+
+  /** The function telling which devices are simulated by other threads. */
+  static RemoteDeviceFunction g_remoteDevice;
 };
 
+template <typename DEVICE, typename... Us, typename... Ts>
+bool
+Channel::ScheduleReceive (const Ptr<DEVICE> &device, const Time &delay,
+                          void (DEVICE::*receive)(Ptr<Packet>, Us...),
+                          Ptr<const Packet> packet, Ts... args)
+{
+  uint32_t node;
+  if (IsRemoteDevice (PeekPointer (device), &node))
+    {
+      // bind the raw device: its reference count may only be updated by
+      // the thread of its node
+      Simulator::ScheduleWithContext (node, delay, receive, PeekPointer (device),
+                                      DeepCopy (packet), args...);
+      return true;
+    }
+  Simulator::ScheduleWithContext (node, delay, receive, device, packet->Copy (), args...);
+  return false;
+}
+
 } // namespace ns3
 
 #endif /* NS3_CHANNEL_H */
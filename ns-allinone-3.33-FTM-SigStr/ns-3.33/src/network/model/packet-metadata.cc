@@ -33,26 +33,42 @@ NS_LOG_COMPONENT_DEFINE ("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
-bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+std::atomic<bool> PacketMetadata::m_metadataSkipped (false);
+bool PacketMetadata::m_perThreadState = false;
+struct PacketMetadata::ThreadState PacketMetadata::m_processState;
+thread_local struct PacketMetadata::ThreadState PacketMetadata::m_threadState;
 
-PacketMetadata::DataFreeList::~DataFreeList ()
+PacketMetadata::ThreadState::~ThreadState ()
 {
   NS_LOG_FUNCTION (this);
-  for (iterator i = begin (); i != end (); i++)
+  for (std::vector<struct Data *>::iterator i = freeList.begin (); i != freeList.end (); i++)
     {
       PacketMetadata::Deallocate (*i);
     }
-  PacketMetadata::m_enable = false;
+  freeList.clear ();
+  freeListDestroyed = true;
+}
+
+void
+PacketMetadata::EnablePerThreadState (bool enable)
+{
+  NS_LOG_FUNCTION (enable);
+  m_perThreadState = enable;
+}
+
+struct PacketMetadata::ThreadState &
+PacketMetadata::GetThreadState (void)
+{
+  // the thread-local state is only accessed by parallel simulations: the
+  // access to the state of the process is cheaper
+  return m_perThreadState ? m_threadState : m_processState;
 }
 
 void 
 PacketMetadata::Enable (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  NS_ASSERT_MSG (!m_metadataSkipped,
+  NS_ASSERT_MSG (!m_metadataSkipped.load (std::memory_order_relaxed),
                  "Error: attempting to enable the packet metadata "
                  "subsystem too late in the simulation, which is not allowed.\n"
                  "A common cause for this problem is to enable ASCII tracing "
@@ -570,15 +586,16 @@ struct PacketMetadata::Data *
 PacketMetadata::Create (uint32_t size)
 {
   NS_LOG_FUNCTION (size);
-  NS_LOG_LOGIC ("create size="<<size<<", max="<<m_maxSize);
-  if (size > m_maxSize)
+  struct ThreadState &state = GetThreadState ();
+  NS_LOG_LOGIC ("create size="<<size<<", max="<<state.maxSize);
+  if (size > state.maxSize)
     {
-      m_maxSize = size;
+      state.maxSize = size;
     }
-  while (!m_freeList.empty ()) 
+  while (!state.freeList.empty ()) 
     {
-      struct PacketMetadata::Data *data = m_freeList.back ();
-      m_freeList.pop_back ();
+      struct PacketMetadata::Data *data = state.freeList.back ();
+      state.freeList.pop_back ();
       if (data->m_size >= size) 
         {
           NS_LOG_LOGIC ("create found size="<<data->m_size);
@@ -588,29 +605,30 @@ PacketMetadata::Create (uint32_t size)
       NS_LOG_LOGIC ("create dealloc size="<<data->m_size);
       PacketMetadata::Deallocate (data);
     }
-  NS_LOG_LOGIC ("create alloc size="<<m_maxSize);
-  return PacketMetadata::Allocate (m_maxSize);
+  NS_LOG_LOGIC ("create alloc size="<<state.maxSize);
+  return PacketMetadata::Allocate (state.maxSize);
 }
 
 void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  if (!m_enable)
+  struct ThreadState &state = GetThreadState ();
+  if (!m_enable || state.freeListDestroyed)
     {
       PacketMetadata::Deallocate (data);
       return;
     } 
-  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList.size ());
+  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<state.freeList.size ());
   NS_ASSERT (data->m_count == 0);
-  if (m_freeList.size () > 1000 ||
-      data->m_size < m_maxSize) 
+  if (state.freeList.size () > 1000 ||
+      data->m_size < state.maxSize) 
     {
       PacketMetadata::Deallocate (data);
     } 
   else 
     {
-      m_freeList.push_back (data);
+      state.freeList.push_back (data);
     }
 }
 
@@ -665,7 +683,7 @@ PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
   NS_LOG_FUNCTION (this << uid << size);
   if (!m_enable)
     {
-      m_metadataSkipped = true;
+      m_metadataSkipped.store (true, std::memory_order_relaxed);
       return;
     }
 
@@ -674,8 +692,7 @@ PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
   item.prev = 0xffff;
   item.typeUid = uid;
   item.size = size;
-  item.chunkUid = m_chunkUid;
-  m_chunkUid++;
+  item.chunkUid = GetThreadState ().chunkUid++;
   uint16_t written = AddSmall (&item);
   UpdateHead (written);
 }
@@ -687,7 +704,7 @@ PacketMetadata::RemoveHeader (const Header &header, uint32_t size)
   NS_ASSERT (IsStateOk ());
   if (!m_enable) 
     {
-      m_metadataSkipped = true;
+      m_metadataSkipped.store (true, std::memory_order_relaxed);
       return;
     }
   struct PacketMetadata::SmallItem item;
@@ -735,7 +752,7 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
   NS_ASSERT (IsStateOk ());
   if (!m_enable)
     {
-      m_metadataSkipped = true;
+      m_metadataSkipped.store (true, std::memory_order_relaxed);
       return;
     }
   struct PacketMetadata::SmallItem item;
@@ -743,8 +760,7 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
   item.prev = m_tail;
   item.typeUid = uid;
   item.size = size;
-  item.chunkUid = m_chunkUid;
-  m_chunkUid++;
+  item.chunkUid = GetThreadState ().chunkUid++;
   uint16_t written = AddSmall (&item);
   UpdateTail (written);
   NS_ASSERT (IsStateOk ());
@@ -757,7 +773,7 @@ PacketMetadata::RemoveTrailer (const Trailer &trailer, uint32_t size)
   NS_ASSERT (IsStateOk ());
   if (!m_enable) 
     {
-      m_metadataSkipped = true;
+      m_metadataSkipped.store (true, std::memory_order_relaxed);
       return;
     }
   struct PacketMetadata::SmallItem item;
@@ -804,7 +820,7 @@ PacketMetadata::AddAtEnd (PacketMetadata const&o)
   NS_ASSERT (IsStateOk ());
   if (!m_enable) 
     {
-      m_metadataSkipped = true;
+      m_metadataSkipped.store (true, std::memory_order_relaxed);
       return;
     }
   if (m_tail == 0xffff)
@@ -881,7 +897,7 @@ PacketMetadata::AddPaddingAtEnd (uint32_t end)
   NS_LOG_FUNCTION (this << end);
   if (!m_enable)
     {
-      m_metadataSkipped = true;
+      m_metadataSkipped.store (true, std::memory_order_relaxed);
       return;
     }
 }
@@ -892,7 +908,7 @@ PacketMetadata::RemoveAtStart (uint32_t start)
   NS_ASSERT (IsStateOk ());
   if (!m_enable) 
     {
-      m_metadataSkipped = true;
+      m_metadataSkipped.store (true, std::memory_order_relaxed);
       return;
     }
   NS_ASSERT (m_data != 0);
@@ -955,7 +971,7 @@ PacketMetadata::RemoveAtEnd (uint32_t end)
   NS_ASSERT (IsStateOk ());
   if (!m_enable) 
     {
-      m_metadataSkipped = true;
+      m_metadataSkipped.store (true, std::memory_order_relaxed);
       return;
     }
   NS_ASSERT (m_data != 0);
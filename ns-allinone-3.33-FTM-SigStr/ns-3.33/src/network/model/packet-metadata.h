@@ -23,6 +23,7 @@
 #include <stdint.h>
 #include <vector>
 #include <limits>
+#include <atomic>
 #include "ns3/callback.h"
 #include "ns3/assert.h"
 #include "ns3/type-id.h"
@@ -160,6 +161,16 @@ private:
    * \brief Enable the packet metadata checking
    */
   static void EnableChecking (void);
+  /**
+   * \brief Give each thread its own free list and chunk uids.
+   *
+   * By default, the metadata share the free list and the counters of the
+   * process, which may only be used by one thread. A parallel simulator
+   * enables the per-thread state while its threads run.
+   *
+   * \param enable whether each thread has its own state
+   */
+  static void EnablePerThreadState (bool enable);
 
   /**
    * \brief Constructor
@@ -495,15 +506,18 @@ private:
   };
 
   /**
-   * \brief Class to hold all the metadata
+   * \brief The free list of the metadata storage and the counters of a thread
    */
-  class DataFreeList : public std::vector<struct Data *>
+  struct ThreadState
   {
-public:
-    ~DataFreeList ();
+    ~ThreadState ();
+    std::vector<struct Data *> freeList; //!< the metadata data storage
+    bool freeListDestroyed; //!< Whether the free list was destroyed
+    uint32_t maxSize; //!< maximum metadata size
+    uint16_t chunkUid; //!< Chunk Uid
   };
 
-  friend DataFreeList::~DataFreeList ();
+  friend ThreadState::~ThreadState ();
   /// Friend class
   friend class ItemIterator;
 
@@ -661,7 +675,15 @@ public:
    */
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList; //!< the metadata data storage
+  /**
+   * \brief Get the state of the calling thread
+   * \returns the state of the process, unless each thread has its own state
+   */
+  static struct ThreadState &GetThreadState (void);
+
+  static bool m_perThreadState; //!< Whether each thread has its own state
+  static struct ThreadState m_processState; //!< State of the process
+  static thread_local struct ThreadState m_threadState; //!< State of the calling thread
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
 
@@ -670,10 +692,7 @@ public:
    * m_enable is false; used to detect enabling of metadata in the
    * middle of a simulation, which isn't allowed.
    */
-  static bool m_metadataSkipped;
-
-  static uint32_t m_maxSize; //!< maximum metadata size
-  static uint16_t m_chunkUid; //!< Chunk Uid
+  static std::atomic<bool> m_metadataSkipped;
 
   struct Data *m_data; //!< Metadata storage
   /*
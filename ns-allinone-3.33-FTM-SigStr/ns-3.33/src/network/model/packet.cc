@@ -29,6 +29,8 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("Packet");
 
 uint32_t Packet::m_globalUid = 0;
+thread_local uint64_t *Packet::m_uidCounter = 0;
+bool Packet::m_perThreadState = false;
 
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
@@ -130,16 +132,9 @@ Packet::Packet ()
   : m_buffer (),
     m_byteTagList (),
     m_packetTagList (),
-    /* The upper 32 bits of the packet id in 
-     * metadata is for the system id. For non-
-     * distributed simulations, this is simply 
-     * zero.  The lower 32 bits are for the 
-     * global UID
-     */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, 0),
+    m_metadata (AllocateUid (), 0),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 
 Packet::Packet (const Packet &o)
@@ -172,16 +167,9 @@ Packet::Packet (uint32_t size)
   : m_buffer (size),
     m_byteTagList (),
     m_packetTagList (),
-    /* The upper 32 bits of the packet id in 
-     * metadata is for the system id. For non-
-     * distributed simulations, this is simply 
-     * zero.  The lower 32 bits are for the 
-     * global UID
-     */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (AllocateUid (), size),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
   : m_buffer (0, false),
@@ -198,16 +186,9 @@ Packet::Packet (uint8_t const*buffer, uint32_t size)
   : m_buffer (),
     m_byteTagList (),
     m_packetTagList (),
-    /* The upper 32 bits of the packet id in 
-     * metadata is for the system id. For non-
-     * distributed simulations, this is simply 
-     * zero.  The lower 32 bits are for the 
-     * global UID
-     */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (AllocateUid (), size),
     m_nixVector (0)
 {
-  m_globalUid++;
   m_buffer.AddAtStart (size);
   Buffer::Iterator i = m_buffer.Begin ();
   i.Write (buffer, size);
@@ -582,6 +563,38 @@ Packet::EnableChecking (void)
   PacketMetadata::EnableChecking ();
 }
 
+void
+Packet::SetUidCounter (uint64_t *counter)
+{
+  m_uidCounter = counter;
+}
+
+void
+Packet::EnablePerThreadState (bool enable)
+{
+  NS_LOG_FUNCTION (enable);
+  m_perThreadState = enable;
+  Buffer::EnablePerThreadState (enable);
+  PacketMetadata::EnablePerThreadState (enable);
+  ByteTagList::EnablePerThreadState (enable);
+}
+
+uint64_t
+Packet::AllocateUid (void)
+{
+  if (m_perThreadState && m_uidCounter != 0)
+    {
+      return (*m_uidCounter)++;
+    }
+  /* The upper 32 bits of the packet id in
+   * metadata is for the system id. For non-
+   * distributed simulations, this is simply
+   * zero.  The lower 32 bits are for the
+   * global UID
+   */
+  return static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid++;
+}
+
 uint32_t Packet::GetSerializedSize (void) const
 {
   uint32_t size = 0;
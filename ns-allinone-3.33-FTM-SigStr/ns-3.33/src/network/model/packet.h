@@ -530,6 +530,29 @@ public:
    * errors will be detected and will abort the program.
    */
   static void EnableChecking (void);
+  /**
+   * \brief Set the counter of the uids of the packets created by the
+   * calling thread.
+   *
+   * By default, the uids are allocated from a global counter, which may
+   * only be used by one thread. A parallel simulator sets a counter for
+   * each of its partitions, so that the uids do not depend on the thread
+   * scheduling: the counters must then start from disjoint ranges.
+   *
+   * \param [in] counter The counter, or 0 for the global counter.
+   */
+  static void SetUidCounter (uint64_t *counter);
+  /**
+   * \brief Give each thread its own packet state.
+   *
+   * By default, the uid counter and the free lists of the buffers, the
+   * metadata and the byte tags are shared by the process, which may only
+   * be used by one thread. A parallel simulator enables the per-thread
+   * state while its threads run, before it sets the uid counters.
+   *
+   * \param [in] enable Whether each thread has its own state.
+   */
+  static void EnablePerThreadState (bool enable);
 
   /**
    * \brief Returns number of bytes required for packet
@@ -779,6 +802,12 @@ private:
    */
   uint32_t Deserialize (uint8_t const*buffer, uint32_t size);
 
+  /**
+   * \brief Allocate the uid of a new packet.
+   * \returns the uid.
+   */
+  static uint64_t AllocateUid (void);
+
   Buffer m_buffer;                //!< the packet buffer (it's actual contents)
   ByteTagList m_byteTagList;      //!< the ByteTag list
   PacketTagList m_packetTagList;  //!< the packet's Tag list
@@ -788,6 +817,8 @@ private:
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
   static uint32_t m_globalUid; //!< Global counter of packets Uid
+  static thread_local uint64_t *m_uidCounter; //!< Counter of packets Uid of the calling thread, if not the global one
+  static bool m_perThreadState; //!< Whether each thread has its own state
 };
 
 /**
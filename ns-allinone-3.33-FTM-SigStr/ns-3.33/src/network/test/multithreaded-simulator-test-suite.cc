@@ -0,0 +1,488 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/packet.h"
+#include "ns3/multithreaded-simulator-impl.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the MultithreadedSimulatorImpl partitions the nodes
+ * as expected and executes the same events as the DefaultSimulatorImpl,
+ * in the same order whatever the number of threads.
+ *
+ * Pairs of nodes are connected by a SimpleChannel. Each node runs a chain
+ * of local events and, from time to time, schedules an event on the other
+ * node of its pair with a delay equal to the channel delay. Global events
+ * also schedule events on the nodes.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorTestCase ();
+  virtual ~MultithreadedSimulatorTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /// Timestamp and kind of the events executed by a node
+  typedef std::vector<std::pair<uint64_t, uint32_t> > NodeLog;
+
+  /**
+   * Run the scenario.
+   *
+   * \param implementation the simulator implementation type
+   * \param splitChannels the SplitChannels attribute
+   * \param maxThreads the MaxThreads attribute
+   * \param nPartitions the expected number of partitions
+   */
+  void RunScenario (std::string implementation, bool splitChannels, uint32_t maxThreads,
+                    uint32_t nPartitions);
+  /**
+   * Local event of a node.
+   *
+   * \param node the node ID
+   * \param count the number of local events executed so far
+   */
+  void Local (uint32_t node, uint32_t count);
+  /**
+   * Event scheduled by the other node of the pair.
+   *
+   * \param node the node ID
+   */
+  void Remote (uint32_t node);
+  /**
+   * Event scheduled by a global event.
+   *
+   * \param node the node ID
+   */
+  void FromGlobal (uint32_t node);
+  /**
+   * Global event.
+   */
+  void Global (void);
+
+  static const uint32_t N_NODES = 8;   //!< number of nodes
+  static const uint32_t N_LOCAL = 500; //!< number of local events per node
+  Time m_delay;                        //!< channel delay
+  std::vector<NodeLog> m_logs;         //!< events executed by each node
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase ()
+  : TestCase ("Check the partitions and the events of the multi-threaded simulator"),
+    m_delay (MicroSeconds (10))
+{
+}
+
+MultithreadedSimulatorTestCase::~MultithreadedSimulatorTestCase ()
+{
+}
+
+void
+MultithreadedSimulatorTestCase::Local (uint32_t node, uint32_t count)
+{
+  NS_ASSERT (Simulator::GetContext () == node);
+  m_logs[node].push_back (std::make_pair (Simulator::Now ().GetTimeStep (), count));
+  if (count % 7 == node % 7)
+    {
+      Simulator::ScheduleWithContext (node ^ 1, m_delay, &MultithreadedSimulatorTestCase::Remote,
+                                      this, node ^ 1);
+    }
+  if (count < N_LOCAL)
+    {
+      Simulator::Schedule (MicroSeconds (1 + (count * 13 + node) % 4),
+                           &MultithreadedSimulatorTestCase::Local, this, node, count + 1);
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::Remote (uint32_t node)
+{
+  NS_ASSERT (Simulator::GetContext () == node);
+  m_logs[node].push_back (std::make_pair (Simulator::Now ().GetTimeStep (), N_LOCAL + 1));
+}
+
+void
+MultithreadedSimulatorTestCase::FromGlobal (uint32_t node)
+{
+  NS_ASSERT (Simulator::GetContext () == node);
+  m_logs[node].push_back (std::make_pair (Simulator::Now ().GetTimeStep (), N_LOCAL + 2));
+}
+
+void
+MultithreadedSimulatorTestCase::Global (void)
+{
+  NS_ASSERT (Simulator::GetContext () == Simulator::NO_CONTEXT);
+  for (uint32_t node = 0; node < N_NODES; node++)
+    {
+      Simulator::ScheduleWithContext (node, MicroSeconds (node), &MultithreadedSimulatorTestCase::FromGlobal,
+                                      this, node);
+    }
+  if (Simulator::Now () < MicroSeconds (1000))
+    {
+      Simulator::Schedule (MicroSeconds (333), &MultithreadedSimulatorTestCase::Global, this);
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::RunScenario (std::string implementation, bool splitChannels,
+                                             uint32_t maxThreads, uint32_t nPartitions)
+{
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue (implementation));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::SplitChannels", BooleanValue (splitChannels));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (maxThreads));
+
+  NodeContainer nodes;
+  nodes.Create (N_NODES);
+  SimpleNetDeviceHelper helper;
+  helper.SetChannelAttribute ("Delay", TimeValue (m_delay));
+  for (uint32_t i = 0; i < N_NODES; i += 2)
+    {
+      helper.Install (NodeContainer (nodes.Get (i), nodes.Get (i + 1)));
+    }
+
+  m_logs.assign (N_NODES, NodeLog ());
+  for (uint32_t node = 0; node < N_NODES; node++)
+    {
+      Simulator::ScheduleWithContext (node, MicroSeconds (node), &MultithreadedSimulatorTestCase::Local,
+                                      this, node, 0);
+    }
+  Simulator::Schedule (MicroSeconds (100), &MultithreadedSimulatorTestCase::Global, this);
+  Simulator::Stop (MicroSeconds (1500));
+  Simulator::Run ();
+
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl != 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (impl->GetNPartitions (), nPartitions, "Unexpected number of partitions");
+      if (splitChannels)
+        {
+          NS_TEST_EXPECT_MSG_EQ (impl->GetLookahead (), m_delay, "Unexpected lookahead");
+        }
+    }
+  Simulator::Destroy ();
+
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::SplitChannels", BooleanValue (false));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (0));
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun (void)
+{
+  RunScenario ("ns3::DefaultSimulatorImpl", false, 0, 0);
+  std::vector<NodeLog> expected = m_logs;
+  for (uint32_t node = 0; node < N_NODES; node++)
+    {
+      std::sort (expected[node].begin (), expected[node].end ());
+    }
+
+  struct
+  {
+    bool splitChannels;
+    uint32_t maxThreads;
+    uint32_t nPartitions;
+  } configs[] = {
+    { false, 1, N_NODES / 2 },
+    { false, 3, N_NODES / 2 },
+    { true, 1, N_NODES },
+    { true, 4, N_NODES },
+  };
+  for (uint32_t i = 0; i < sizeof (configs) / sizeof (configs[0]); i++)
+    {
+      RunScenario ("ns3::MultithreadedSimulatorImpl", configs[i].splitChannels,
+                   configs[i].maxThreads, configs[i].nPartitions);
+      std::vector<NodeLog> logs = m_logs;
+      for (uint32_t node = 0; node < N_NODES; node++)
+        {
+          // events at the same time may be executed in a different order
+          // than with the default simulator
+          std::sort (logs[node].begin (), logs[node].end ());
+          NS_TEST_EXPECT_MSG_EQ ((logs[node] == expected[node]), true,
+                                 "Different events on node " << node << " with SplitChannels="
+                                 << configs[i].splitChannels << ", MaxThreads=" << configs[i].maxThreads);
+        }
+      if (i % 2 == 1)
+        {
+          // same partitions with more threads: same order
+          std::vector<NodeLog> threadedLogs = m_logs;
+          RunScenario ("ns3::MultithreadedSimulatorImpl", configs[i].splitChannels, 1,
+                       configs[i].nPartitions);
+          NS_TEST_EXPECT_MSG_EQ ((threadedLogs == m_logs), true,
+                                 "Order depends on the number of threads with SplitChannels="
+                                 << configs[i].splitChannels);
+        }
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the packets sent across partitions and the events
+ * cancelled across partitions give the same traces whatever the number
+ * of threads.
+ *
+ * Pairs of nodes are connected by a split SimpleChannel. Each node sends
+ * a packet to the other node of its pair, which replies with a new packet
+ * whose bytes are derived from the received ones, until a number of
+ * exchanges is reached. Each node traces the time, the uid and the bytes
+ * of the packets it receives. Each node also schedules an event, which is
+ * cancelled or removed by the other node of its pair.
+ */
+class MultithreadedSimulatorPacketTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorPacketTestCase ();
+  virtual ~MultithreadedSimulatorPacketTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the scenario.
+   *
+   * \param maxThreads the MaxThreads attribute
+   * \returns the traces of all the nodes
+   */
+  std::string RunScenario (uint32_t maxThreads);
+  /**
+   * Send a packet to the other node of the pair.
+   *
+   * \param node the node ID
+   * \param bytes the bytes of the packet
+   */
+  void Send (uint32_t node, std::vector<uint8_t> bytes);
+  /**
+   * Receive a packet.
+   *
+   * \param device the receiving device
+   * \param packet the packet
+   * \param protocol the protocol number
+   * \param from the sender address
+   * \returns true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+  /**
+   * Cancel or remove the event of the other node of the pair.
+   *
+   * \param node the node ID
+   */
+  void CancelRemote (uint32_t node);
+  /**
+   * Event which must be cancelled.
+   *
+   * \param node the node ID
+   */
+  void Cancelled (uint32_t node);
+
+  static const uint32_t N_NODES = 6;       //!< number of nodes
+  static const uint8_t N_EXCHANGES = 40;   //!< number of replies in each chain of exchanges
+  Time m_delay;                            //!< channel delay
+  NetDeviceContainer m_devices;            //!< the device of each node
+  std::vector<Address> m_addresses;        //!< the address of the device of each node
+  std::vector<EventId> m_events;           //!< the event to cancel on each node
+  std::vector<std::string> m_traces;       //!< the trace of each node
+  std::vector<uint32_t> m_received;        //!< the number of packets received by each node
+  std::vector<uint32_t> m_cancelled;       //!< the number of cancelled events executed by each node
+};
+
+MultithreadedSimulatorPacketTestCase::MultithreadedSimulatorPacketTestCase ()
+  : TestCase ("Check the packets and the cancellations across the partitions of the multi-threaded simulator"),
+    m_delay (MicroSeconds (10))
+{
+}
+
+MultithreadedSimulatorPacketTestCase::~MultithreadedSimulatorPacketTestCase ()
+{
+}
+
+void
+MultithreadedSimulatorPacketTestCase::Send (uint32_t node, std::vector<uint8_t> bytes)
+{
+  if (bytes[0] == 0)
+    {
+      m_events[node] = Simulator::Schedule (MicroSeconds (300), &MultithreadedSimulatorPacketTestCase::Cancelled,
+                                            this, node);
+      Simulator::Schedule (MicroSeconds (100), &MultithreadedSimulatorPacketTestCase::CancelRemote,
+                           this, node);
+    }
+  Ptr<Packet> packet = Create<Packet> (&bytes[0], bytes.size ());
+  // the device of the other node must not be referenced by this partition
+  m_devices.Get (node)->Send (packet, m_addresses[node ^ 1], 1);
+}
+
+bool
+MultithreadedSimulatorPacketTestCase::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                               uint16_t protocol, const Address &from)
+{
+  uint32_t node = device->GetNode ()->GetId ();
+  NS_ASSERT (Simulator::GetContext () == node);
+  std::vector<uint8_t> bytes (packet->GetSize ());
+  packet->CopyData (&bytes[0], bytes.size ());
+  std::ostringstream trace;
+  trace << Simulator::Now ().GetTimeStep () << ' ' << packet->GetUid () << ' ';
+  trace.write (reinterpret_cast<const char *> (&bytes[0]), bytes.size ());
+  m_traces[node] += trace.str ();
+  m_received[node]++;
+  if (bytes[0] < N_EXCHANGES)
+    {
+      bytes[0]++;
+      for (std::size_t i = 1; i < bytes.size (); i++)
+        {
+          bytes[i] = bytes[i] * 7 + bytes[i - 1] + node;
+        }
+      bytes.resize (bytes.size () + node % 3);
+      Simulator::Schedule (MicroSeconds (1 + bytes[1] % 5),
+                           &MultithreadedSimulatorPacketTestCase::Send, this, node, bytes);
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorPacketTestCase::CancelRemote (uint32_t node)
+{
+  // the event belongs to the partition of the other node
+  if (node % 2 == 0)
+    {
+      Simulator::Cancel (m_events[node ^ 1]);
+    }
+  else
+    {
+      Simulator::Remove (m_events[node ^ 1]);
+    }
+}
+
+void
+MultithreadedSimulatorPacketTestCase::Cancelled (uint32_t node)
+{
+  m_cancelled[node]++;
+}
+
+std::string
+MultithreadedSimulatorPacketTestCase::RunScenario (uint32_t maxThreads)
+{
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::MultithreadedSimulatorImpl"));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::SplitChannels", BooleanValue (true));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (maxThreads));
+
+  NodeContainer nodes;
+  nodes.Create (N_NODES);
+  SimpleNetDeviceHelper helper;
+  helper.SetChannelAttribute ("Delay", TimeValue (m_delay));
+  m_devices = NetDeviceContainer ();
+  for (uint32_t i = 0; i < N_NODES; i += 2)
+    {
+      m_devices.Add (helper.Install (NodeContainer (nodes.Get (i), nodes.Get (i + 1))));
+    }
+
+  m_addresses.clear ();
+  for (uint32_t node = 0; node < N_NODES; node++)
+    {
+      m_addresses.push_back (m_devices.Get (node)->GetAddress ());
+    }
+  m_events.assign (N_NODES, EventId ());
+  m_traces.assign (N_NODES, "");
+  m_received.assign (N_NODES, 0);
+  m_cancelled.assign (N_NODES, 0);
+  for (uint32_t node = 0; node < N_NODES; node++)
+    {
+      m_devices.Get (node)->SetReceiveCallback (MakeCallback (&MultithreadedSimulatorPacketTestCase::Receive, this));
+      std::vector<uint8_t> bytes (20 + node);
+      for (std::size_t i = 0; i < bytes.size (); i++)
+        {
+          bytes[i] = i * 31 + node;
+        }
+      bytes[0] = 0;
+      Simulator::ScheduleWithContext (node, MicroSeconds (node), &MultithreadedSimulatorPacketTestCase::Send,
+                                      this, node, bytes);
+    }
+  Simulator::Run ();
+
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_EXPECT_MSG_EQ (impl->GetNPartitions (), N_NODES, "The channels should split the partitions");
+  Simulator::Destroy ();
+
+  std::string traces;
+  for (uint32_t node = 0; node < N_NODES; node++)
+    {
+      // each node receives the odd replies of its chain and the even
+      // replies of the chain of the other node
+      NS_TEST_EXPECT_MSG_EQ (m_received[node], N_EXCHANGES + 1u,
+                             "Unexpected number of packets received by node " << node);
+      NS_TEST_EXPECT_MSG_EQ (m_cancelled[node], 0u, "Event of node " << node << " not cancelled");
+      traces += m_traces[node];
+    }
+  m_events.clear ();
+  m_devices = NetDeviceContainer ();
+
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::SplitChannels", BooleanValue (false));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (0));
+  return traces;
+}
+
+void
+MultithreadedSimulatorPacketTestCase::DoRun (void)
+{
+  std::string expected = RunScenario (1);
+  for (uint32_t maxThreads = 2; maxThreads <= 4; maxThreads++)
+    {
+      std::string traces = RunScenario (maxThreads);
+      NS_TEST_EXPECT_MSG_EQ ((traces == expected), true,
+                             "The traces depend on the number of threads, MaxThreads=" << maxThreads);
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief MultithreadedSimulatorImpl TestSuite
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ();
+};
+
+MultithreadedSimulatorTestSuite::MultithreadedSimulatorTestSuite ()
+  : TestSuite ("multithreaded-simulator", UNIT)
+{
+  AddTestCase (new MultithreadedSimulatorTestCase, TestCase::QUICK);
+  AddTestCase (new MultithreadedSimulatorPacketTestCase, TestCase::QUICK);
+}
+
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite; //!< Static variable for test initialization
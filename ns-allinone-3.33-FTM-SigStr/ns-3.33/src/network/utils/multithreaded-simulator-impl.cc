@@ -0,0 +1,988 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/channel.h"
+#include "ns3/channel-list.h"
+#include "ns3/net-device.h"
+#include "ns3/packet.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::Partition *MultithreadedSimulatorImpl::g_currentPartition = 0;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Network")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("MaxThreads",
+                   "Maximum number of threads executing events, including the main "
+                   "thread. Zero means the number of hardware threads.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_maxThreads),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("SplitChannels",
+                   "Whether the nodes connected by a point-to-point or simple channel "
+                   "with a Delay attribute greater than zero may belong to different "
+                   "partitions, in which case the lookahead is the smallest of these "
+                   "delays.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MultithreadedSimulatorImpl::m_splitChannels),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  m_lookahead = GetMaximumSimulationTime ().GetTimeStep ();
+  m_parallel = false;
+  m_windowEnd = 0;
+  m_nextWindowPartition.store (0, std::memory_order_relaxed);
+  m_windowGeneration = 0;
+  m_idleWorkers = 0;
+  m_workersExit = false;
+  m_stop.store (false, std::memory_order_relaxed);
+  m_main = SystemThread::Self ();
+
+  Partition *global = CreatePartition ();
+  // uids are allocated from 4.
+  // uid 0 is "invalid" events
+  // uid 1 is "now" events
+  // uid 2 is "destroy" events
+  global->uid = 4;
+  global->currentContext = Simulator::NO_CONTEXT;
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  StopWorkers ();
+  ProcessMessages ();
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      Partition *partition = *i;
+      while (partition->events != 0 && !partition->events->IsEmpty ())
+        {
+          Scheduler::Event next = partition->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      delete partition;
+    }
+  m_partitions.clear ();
+  m_contextPartitions.clear ();
+  m_deviceNodes.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (true)
+    {
+      Ptr<EventImpl> ev;
+      {
+        CriticalSection cs (m_destroyEventsMutex);
+        if (m_destroyEvents.empty ())
+          {
+            break;
+          }
+        ev = m_destroyEvents.front ().PeekEventImpl ();
+        m_destroyEvents.pop_front ();
+      }
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::CreatePartition (void)
+{
+  Partition *partition = new Partition ();
+  partition->simulator = this;
+  partition->id = m_partitions.size ();
+  if (m_schedulerFactory.IsTypeIdSet ())
+    {
+      partition->events = m_schedulerFactory.Create<Scheduler> ();
+    }
+  partition->uid = 0;
+  partition->currentUid = 0;
+  partition->currentTs = 0;
+  partition->currentContext = Simulator::NO_CONTEXT;
+  partition->eventCount.store (0, std::memory_order_relaxed);
+  partition->unscheduledEvents = 0;
+  partition->sentMessages = 0;
+  partition->mailbox.store (0, std::memory_order_relaxed);
+  // the packet uids of the partitions are distinguished by their upper
+  // bits, like those of the logical processes of a distributed simulation
+  partition->packetUid = static_cast<uint64_t> (partition->id) << 32;
+  m_partitions.push_back (partition);
+  return partition;
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  m_schedulerFactory = schedulerFactory;
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      Partition *partition = *i;
+      Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+      if (partition->events != 0)
+        {
+          while (!partition->events->IsEmpty ())
+            {
+              scheduler->Insert (partition->events->RemoveNext ());
+            }
+        }
+      partition->events = scheduler;
+    }
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+std::set<TypeId> &
+MultithreadedSimulatorImpl::GetSplitChannelTypes (void)
+{
+  static std::set<TypeId> types;
+  return types;
+}
+
+void
+MultithreadedSimulatorImpl::AddSplitChannelType (TypeId tid)
+{
+  GetSplitChannelTypes ().insert (tid);
+}
+
+bool
+MultithreadedSimulatorImpl::IsRemoteDevice (const NetDevice *device, uint32_t *node)
+{
+  Partition *current = g_currentPartition;
+  if (current == 0 || !current->simulator->m_parallel)
+    {
+      // a single thread executes events
+      *node = device->GetNode ()->GetId ();
+      return false;
+    }
+  const MultithreadedSimulatorImpl *simulator = current->simulator;
+  std::map<const NetDevice *, uint32_t>::const_iterator i = simulator->m_deviceNodes.find (device);
+  NS_ABORT_MSG_IF (i == simulator->m_deviceNodes.end (),
+                   "MultithreadedSimulatorImpl: device added to a node after the start of Run()");
+  *node = i->second;
+  return simulator->GetPartition (*node) != current;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetCurrentPartition (void) const
+{
+  Partition *partition = g_currentPartition;
+  if (partition == 0)
+    {
+      NS_ASSERT_MSG (SystemThread::Equals (m_main), "MultithreadedSimulatorImpl: Thread-unsafe invocation!");
+      partition = m_partitions[0];
+    }
+  return partition;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetPartition (uint32_t context) const
+{
+  if (context < m_contextPartitions.size ())
+    {
+      return m_contextPartitions[context];
+    }
+  return m_partitions[0];
+}
+
+EventId
+MultithreadedSimulatorImpl::Insert (Partition *partition, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = ts;
+  ev.key.m_context = context;
+  ev.key.m_uid = partition->uid;
+  partition->uid++;
+  partition->unscheduledEvents++;
+  partition->events->Insert (ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (Partition *partition)
+{
+  Scheduler::Event next = partition->events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= partition->currentTs);
+  partition->unscheduledEvents--;
+  partition->eventCount.store (partition->eventCount.load (std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+
+  NS_LOG_LOGIC ("handle " << next.key.m_ts);
+  partition->currentTs = next.key.m_ts;
+  partition->currentContext = next.key.m_context;
+  partition->currentUid = next.key.m_uid;
+  if (!partition->cancelledEvents.empty ()
+      && partition->cancelledEvents.erase (std::make_pair (next.key.m_ts, next.key.m_uid)) > 0)
+    {
+      next.impl->Cancel ();
+    }
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessPartition (Partition *partition)
+{
+  Partition *previous = g_currentPartition;
+  g_currentPartition = partition;
+  Packet::SetUidCounter (&partition->packetUid);
+  while (!partition->events->IsEmpty ()
+         && partition->events->PeekNext ().key.m_ts < m_windowEnd)
+    {
+      ProcessOneEvent (partition);
+    }
+  Packet::SetUidCounter (0);
+  g_currentPartition = previous;
+}
+
+bool
+MultithreadedSimulatorImpl::MessageLess (const Message *a, const Message *b)
+{
+  if (a->ts != b->ts)
+    {
+      return a->ts < b->ts;
+    }
+  if (a->source != b->source)
+    {
+      return a->source < b->source;
+    }
+  return a->sequence < b->sequence;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessMessages (void)
+{
+  std::vector<Message *> messages;
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      Partition *partition = *i;
+      Message *message = partition->mailbox.exchange (0, std::memory_order_acquire);
+      if (message == 0)
+        {
+          continue;
+        }
+      // the order of the mailbox depends on the thread scheduling: sort
+      // the messages before allocating their uids
+      messages.clear ();
+      for (; message != 0; message = message->next)
+        {
+          messages.push_back (message);
+        }
+      std::sort (messages.begin (), messages.end (), &MultithreadedSimulatorImpl::MessageLess);
+      for (std::vector<Message *>::const_iterator j = messages.begin (); j != messages.end (); j++)
+        {
+          Message *message = *j;
+          if (message->event != 0)
+            {
+              Insert (partition, message->ts, message->context, message->event);
+            }
+          else if (message->ts > partition->currentTs
+                   || (message->ts == partition->currentTs && message->uid > partition->currentUid))
+            {
+              // the event is cancelled by the partition when it is executed,
+              // since another thread may hold references to it
+              partition->cancelledEvents.insert (std::make_pair (message->ts, message->uid));
+            }
+          delete message;
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::UpdatePartitions (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t nNodes = NodeList::GetNNodes ();
+
+  // union-find of the nodes connected by the channels which do not split
+  // the partitions
+  std::vector<uint32_t> parent (nNodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      parent[i] = i;
+    }
+  std::set<TypeId> splitTypes = GetSplitChannelTypes ();
+  // the modules of these channels may not be linked
+  const char *splitTypeNames[] = { "ns3::PointToPointChannel", "ns3::SimpleChannel" };
+  for (std::size_t i = 0; i < sizeof (splitTypeNames) / sizeof (splitTypeNames[0]); i++)
+    {
+      TypeId tid;
+      if (TypeId::LookupByNameFailSafe (splitTypeNames[i], &tid))
+        {
+          splitTypes.insert (tid);
+        }
+    }
+  uint64_t lookahead = GetMaximumSimulationTime ().GetTimeStep ();
+  for (ChannelList::Iterator i = ChannelList::Begin (); i != ChannelList::End (); i++)
+    {
+      Ptr<Channel> channel = *i;
+      if (m_splitChannels
+          && splitTypes.count (channel->GetInstanceTypeId ()) > 0)
+        {
+          struct TypeId::AttributeInformation info;
+          if (channel->GetInstanceTypeId ().LookupAttributeByName ("Delay", &info)
+              && info.checker->GetValueTypeName () == "ns3::TimeValue")
+            {
+              TimeValue delay;
+              channel->GetAttribute ("Delay", delay);
+              if (delay.Get ().IsStrictlyPositive ())
+                {
+                  lookahead = std::min<uint64_t> (lookahead, delay.Get ().GetTimeStep ());
+                  continue;
+                }
+            }
+        }
+      uint32_t root = nNodes;
+      for (std::size_t j = 0; j < channel->GetNDevices (); j++)
+        {
+          Ptr<NetDevice> device = channel->GetDevice (j);
+          if (device == 0 || device->GetNode () == 0)
+            {
+              continue;
+            }
+          uint32_t node = device->GetNode ()->GetId ();
+          while (parent[node] != node)
+            {
+              parent[node] = parent[parent[node]];
+              node = parent[node];
+            }
+          if (root == nNodes)
+            {
+              root = node;
+            }
+          else if (node != root)
+            {
+              // keep the smallest node ID as the root
+              parent[std::max (node, root)] = std::min (node, root);
+              root = std::min (node, root);
+            }
+        }
+    }
+  m_lookahead = lookahead;
+
+  m_deviceNodes.clear ();
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); i++)
+    {
+      for (uint32_t j = 0; j < (*i)->GetNDevices (); j++)
+        {
+          m_deviceNodes[PeekPointer ((*i)->GetDevice (j))] = (*i)->GetId ();
+        }
+    }
+
+  // number the partitions in the order of their smallest node ID
+  std::vector<uint32_t> partitionIds (nNodes);
+  uint32_t nPartitions = 1;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      uint32_t root = i;
+      while (parent[root] != root)
+        {
+          root = parent[root];
+        }
+      partitionIds[i] = (root == i) ? nPartitions++ : partitionIds[root];
+    }
+
+  bool unchanged = (m_contextPartitions.size () == nNodes && m_partitions.size () == nPartitions);
+  for (uint32_t i = 0; unchanged && i < nNodes; i++)
+    {
+      unchanged = (m_contextPartitions[i]->id == partitionIds[i]);
+    }
+  NS_LOG_DEBUG (nNodes << " nodes, " << nPartitions - 1 << " partitions, lookahead "
+                       << lookahead << (unchanged ? ", unchanged" : ""));
+  if (unchanged)
+    {
+      return;
+    }
+
+  // move all the events to the global partition, then to the partition
+  // of their context
+  Partition *global = m_partitions[0];
+  std::vector<Scheduler::Event> events;
+  std::vector<uint64_t> packetUids;
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      Partition *partition = *i;
+      while (!partition->events->IsEmpty ())
+        {
+          Scheduler::Event event = partition->events->RemoveNext ();
+          if (partition->cancelledEvents.erase (std::make_pair (event.key.m_ts, event.key.m_uid)) > 0)
+            {
+              event.impl->Cancel ();
+            }
+          events.push_back (event);
+        }
+      partition->cancelledEvents.clear ();
+      partition->unscheduledEvents = 0;
+      packetUids.push_back (partition->packetUid);
+      if (partition != global)
+        {
+          global->eventCount.store (global->eventCount.load (std::memory_order_relaxed)
+                                    + partition->eventCount.load (std::memory_order_relaxed),
+                                    std::memory_order_relaxed);
+          global->uid = std::max (global->uid, partition->uid);
+          global->currentTs = std::max (global->currentTs, partition->currentTs);
+          delete partition;
+        }
+    }
+  m_partitions.resize (1);
+  while (m_partitions.size () < nPartitions)
+    {
+      // the uids of the moved events must not be allocated again
+      Partition *partition = CreatePartition ();
+      partition->uid = global->uid;
+      partition->currentTs = global->currentTs;
+      if (partition->id < packetUids.size ())
+        {
+          // do not allocate the packet uids of this partition again
+          partition->packetUid = packetUids[partition->id];
+        }
+    }
+  m_contextPartitions.resize (nNodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      m_contextPartitions[i] = m_partitions[partitionIds[i]];
+    }
+  for (std::vector<Scheduler::Event>::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      Partition *partition = GetPartition (i->key.m_context);
+      partition->unscheduledEvents++;
+      partition->events->Insert (*i);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StartWorkers (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_workers.empty ());
+  uint32_t nThreads = m_maxThreads;
+  if (nThreads == 0)
+    {
+      nThreads = std::max (std::thread::hardware_concurrency (), 1U);
+    }
+  nThreads = std::min<uint32_t> (nThreads, m_partitions.size () - 1);
+  m_windowGeneration = 0;
+  m_idleWorkers = 0;
+  m_workersExit = false;
+  for (uint32_t i = 1; i < nThreads; i++)
+    {
+      Ptr<SystemThread> worker = Create<SystemThread> (MakeCallback (&MultithreadedSimulatorImpl::DoWorker, this));
+      worker->Start ();
+      m_workers.push_back (worker);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StopWorkers (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_workers.empty ())
+    {
+      return;
+    }
+  {
+    std::lock_guard<std::mutex> lock (m_workerMutex);
+    m_workersExit = true;
+  }
+  m_workerStart.notify_all ();
+  for (std::vector<Ptr<SystemThread> >::iterator i = m_workers.begin (); i != m_workers.end (); i++)
+    {
+      (*i)->Join ();
+    }
+  m_workers.clear ();
+}
+
+void
+MultithreadedSimulatorImpl::DoWorker (void)
+{
+  uint64_t generation = 0;
+  while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock (m_workerMutex);
+        while (!m_workersExit && m_windowGeneration == generation)
+          {
+            m_workerStart.wait (lock);
+          }
+        if (m_workersExit)
+          {
+            return;
+          }
+        generation = m_windowGeneration;
+      }
+      ProcessWindowPartitions ();
+      {
+        std::lock_guard<std::mutex> lock (m_workerMutex);
+        m_idleWorkers++;
+      }
+      m_workerDone.notify_one ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindowPartitions (void)
+{
+  while (true)
+    {
+      uint32_t index = m_nextWindowPartition.fetch_add (1, std::memory_order_relaxed);
+      if (index >= m_window.size ())
+        {
+          break;
+        }
+      ProcessPartition (m_window[index]);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunWindow (void)
+{
+  m_window.clear ();
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin () + 1; i != m_partitions.end (); i++)
+    {
+      if (!(*i)->events->IsEmpty () && (*i)->events->PeekNext ().key.m_ts < m_windowEnd)
+        {
+          m_window.push_back (*i);
+        }
+    }
+  NS_LOG_LOGIC ("window " << m_windowEnd << ", " << m_window.size () << " partitions");
+
+  m_parallel = true;
+  m_nextWindowPartition.store (0, std::memory_order_relaxed);
+  if (!m_workers.empty ())
+    {
+      {
+        std::lock_guard<std::mutex> lock (m_workerMutex);
+        m_idleWorkers = 0;
+        m_windowGeneration++;
+      }
+      m_workerStart.notify_all ();
+    }
+  ProcessWindowPartitions ();
+  if (!m_workers.empty ())
+    {
+      std::unique_lock<std::mutex> lock (m_workerMutex);
+      while (m_idleWorkers < m_workers.size ())
+        {
+          m_workerDone.wait (lock);
+        }
+    }
+  m_parallel = false;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop.load (std::memory_order_relaxed))
+    {
+      return true;
+    }
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      if (!(*i)->events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  // Set the current threadId as the main threadId
+  m_main = SystemThread::Self ();
+  m_stop.store (false, std::memory_order_relaxed);
+  UpdatePartitions ();
+  Channel::SetRemoteDeviceFunction (&MultithreadedSimulatorImpl::IsRemoteDevice);
+  Packet::EnablePerThreadState (true);
+  StartWorkers ();
+
+  Partition *global = m_partitions[0];
+  uint64_t maxTs = std::numeric_limits<uint64_t>::max ();
+  g_currentPartition = global;
+  while (!m_stop.load (std::memory_order_relaxed))
+    {
+      uint64_t next = maxTs;
+      for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+        {
+          if (!(*i)->events->IsEmpty ())
+            {
+              next = std::min (next, (*i)->events->PeekNext ().key.m_ts);
+            }
+        }
+      if (next == maxTs)
+        {
+          break;
+        }
+      uint64_t globalNext = global->events->IsEmpty () ? maxTs : global->events->PeekNext ().key.m_ts;
+      if (globalNext == next)
+        {
+          // the global events are executed alone
+          ProcessOneEvent (global);
+          continue;
+        }
+      m_windowEnd = std::min (next + m_lookahead, globalNext);
+      RunWindow ();
+      ProcessMessages ();
+    }
+  g_currentPartition = 0;
+  StopWorkers ();
+  Packet::EnablePerThreadState (false);
+  Channel::SetRemoteDeviceFunction (0);
+
+  // the events scheduled by the main thread are relative to the latest
+  // time reached by any partition
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      global->currentTs = std::max (global->currentTs, (*i)->currentTs);
+    }
+
+  // If the simulator stopped naturally by lack of events, make a
+  // consistency test to check that we didn't lose any events along the way.
+  int unscheduledEvents = 0;
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      unscheduledEvents += (*i)->unscheduledEvents;
+    }
+  NS_ASSERT (!IsFinished () || unscheduledEvents == 0);
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stop.store (true, std::memory_order_relaxed);
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  Simulator::Schedule (delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+  Partition *current = GetCurrentPartition ();
+  uint32_t context = current->currentContext;
+  uint64_t ts = current->currentTs + delay.GetTimeStep ();
+  return Insert (m_parallel ? current : GetPartition (context), ts, context, event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+  Partition *current = GetCurrentPartition ();
+  Partition *target = GetPartition (context);
+  uint64_t ts = current->currentTs + delay.GetTimeStep ();
+  if (!m_parallel || target == current)
+    {
+      Insert (target, ts, context, event);
+      return;
+    }
+  if (ts < m_windowEnd)
+    {
+      NS_FATAL_ERROR ("Event scheduled at " << TimeStep (ts).As (Time::S)
+                      << " with context " << context << " by context " << current->currentContext
+                      << ", earlier than the end of the window at " << TimeStep (m_windowEnd).As (Time::S)
+                      << ": the lookahead is too large for this scenario");
+    }
+  Message *message = new Message ();
+  message->ts = ts;
+  message->context = context;
+  message->event = event;
+  message->uid = 0;
+  PostMessage (target, message);
+}
+
+void
+MultithreadedSimulatorImpl::PostMessage (Partition *target, Message *message)
+{
+  Partition *current = GetCurrentPartition ();
+  message->source = current->id;
+  message->sequence = current->sentMessages++;
+  message->next = target->mailbox.load (std::memory_order_relaxed);
+  while (!target->mailbox.compare_exchange_weak (message->next, message,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+MultithreadedSimulatorImpl::PostCancel (Partition *owner, const EventId &id)
+{
+  // the cancellation is only applied at the end of the window, like the
+  // events scheduled for another partition: the event must not be due
+  // earlier than that
+  if (id.GetTs () < m_windowEnd)
+    {
+      Partition *current = GetCurrentPartition ();
+      NS_FATAL_ERROR ("Event at " << TimeStep (id.GetTs ()).As (Time::S)
+                      << " with context " << id.GetContext () << " cancelled by context " << current->currentContext
+                      << ", earlier than the end of the window at " << TimeStep (m_windowEnd).As (Time::S)
+                      << ": the lookahead is too large for this scenario");
+    }
+  // the reference count and the state of the event may be in use by
+  // another thread: only its key is posted
+  Message *message = new Message ();
+  message->ts = id.GetTs ();
+  message->context = id.GetContext ();
+  message->event = 0;
+  message->uid = id.GetUid ();
+  PostMessage (owner, message);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  return Schedule (TimeStep (0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  EventId id (Ptr<EventImpl> (event, false), GetCurrentPartition ()->currentTs, 0xffffffff, 2);
+  CriticalSection cs (m_destroyEventsMutex);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  Partition *partition = g_currentPartition;
+  if (partition == 0)
+    {
+      partition = m_partitions[0];
+    }
+  return TimeStep (partition->currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - GetCurrentPartition ()->currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyEventsMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition *owner = GetPartition (id.GetContext ());
+  if (m_parallel && owner != GetCurrentPartition ())
+    {
+      // the event queue of the owner may be in use by another thread
+      PostCancel (owner, id);
+      return;
+    }
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  owner->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  owner->unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition *owner = GetPartition (id.GetContext ());
+  if (id.GetUid () != 2 && m_parallel && owner != GetCurrentPartition ())
+    {
+      PostCancel (owner, id);
+      return;
+    }
+  id.PeekEventImpl ()->Cancel ();
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      CriticalSection cs (m_destroyEventsMutex);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  if (id.PeekEventImpl () == 0)
+    {
+      return true;
+    }
+  Partition *current = GetCurrentPartition ();
+  Partition *owner = GetPartition (id.GetContext ());
+  if (m_parallel && owner != current)
+    {
+      // the state of the owner and of the event may be in use by another
+      // thread: the uids of different partitions cannot be compared
+      return id.GetTs () < current->currentTs;
+    }
+  return id.PeekEventImpl ()->IsCancelled ()
+         || id.GetTs () < owner->currentTs
+         || (id.GetTs () == owner->currentTs && id.GetUid () <= owner->currentUid);
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  Partition *partition = g_currentPartition;
+  if (partition == 0)
+    {
+      partition = m_partitions[0];
+    }
+  return partition->currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount (void) const
+{
+  uint64_t eventCount = 0;
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      eventCount += (*i)->eventCount.load (std::memory_order_relaxed);
+    }
+  return eventCount;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions (void) const
+{
+  return m_partitions.size () - 1;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead (void) const
+{
+  return TimeStep (m_lookahead);
+}
+
+} // namespace ns3
@@ -0,0 +1,363 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/object-factory.h"
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+class NetDevice;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief A shared-memory parallel simulator implementation.
+ *
+ * Events are partitioned by context, i.e., by node: each partition has
+ * its own event queue and is executed by one thread at a time, out of a
+ * pool of worker threads. The partitions advance together in time
+ * windows, using a conservative synchronization: within a window, a
+ * partition may only schedule events in another partition later than
+ * the end of the window, which is guaranteed by the lookahead.
+ *
+ * At the start of Run(), the nodes are grouped into partitions:
+ *
+ * - By default, two nodes belong to the same partition if they are
+ *   connected, directly or not, by channels. The partitions do not
+ *   interact through channels, the lookahead is unbounded and each
+ *   window lasts until the next global event (see below).
+ * - If \c SplitChannels is true, the point-to-point and simple channels,
+ *   and the channels whose type was passed to AddSplitChannelType(), whose
+ *   \c Delay attribute is greater than zero do not join the nodes they
+ *   connect. The lookahead is the smallest delay of these channels. The
+ *   other channels, e.g., CSMA channels, whose medium state is shared by
+ *   all the devices, or wireless channels, always join their nodes.
+ *
+ * The events without context (Simulator::NO_CONTEXT) or whose context is
+ * not the ID of a node belong to a global partition, whose events are
+ * executed by the main thread while no other partition runs. Before the
+ * first call to Run(), all the events are stored in the global partition.
+ *
+ * An event scheduled in another partition earlier than the end of the
+ * current window is a fatal error, as the events are then no longer
+ * executed in timestamp order: either disable \c SplitChannels or reduce
+ * \c Lookahead. Events scheduled in another partition are posted to a
+ * lock-free mailbox of that partition and moved to its event queue at the
+ * end of the window, in an order which does not depend on the thread
+ * scheduling: the simulation is deterministic regardless of the number
+ * of threads.
+ *
+ * The reference counts of the objects are not atomic, so the partitions
+ * must not share any object. The split channels deliver their packets
+ * with Channel::ScheduleReceive(): a packet sent to another partition is
+ * copied through its serialization, and the receiving device is only
+ * referenced by the partition of its node. The packets created by a partition get
+ * their uids from a counter of this partition. The other models and the
+ * trace sinks shared by several partitions must be thread-safe.
+ *
+ * Simulator::Stop() takes effect at the end of the current window: the
+ * other partitions may execute events later than the one which called it.
+ * Likewise, cancelling or removing an event which belongs to another
+ * partition is posted to the mailbox of that partition and takes effect
+ * at the end of the window. Such a cancellation must respect the lookahead
+ * like the events scheduled for another partition: the simulation aborts
+ * if the cancelled event is due before the end of the current window.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+  /**
+   * \return The number of partitions of the nodes, not counting the
+   *         global partition, computed by the last call to Run().
+   */
+  uint32_t GetNPartitions (void) const;
+  /**
+   * \return The lookahead used by the last call to Run().
+   */
+  Time GetLookahead (void) const;
+
+  /**
+   * Allow the channels of a type to split the partitions, if their
+   * \c Delay attribute is greater than zero.
+   *
+   * The channels of this type must deliver their packets after at least
+   * this delay, with Channel::ScheduleReceive(), and must not share any
+   * other state between the partitions of their devices. The point-to-point
+   * and simple channels are always allowed to split the partitions.
+   *
+   * \param [in] tid The TypeId of the channels.
+   */
+  static void AddSplitChannelType (TypeId tid);
+
+private:
+  virtual void DoDispose (void);
+
+  /**
+   * Look up the node of a device, while Run() executes events.
+   *
+   * \param [in] device The device.
+   * \param [out] node The ID of the node of the device.
+   * \returns \c true if the device belongs to another partition than the
+   *          calling thread.
+   * \sa Channel::SetRemoteDeviceFunction
+   */
+  static bool IsRemoteDevice (const NetDevice *device, uint32_t *node);
+  /**
+   * \returns The types of the channels passed to AddSplitChannelType().
+   */
+  static std::set<TypeId> & GetSplitChannelTypes (void);
+
+  /**
+   * An event posted to the mailbox of another partition, or the
+   * cancellation of an event of that partition.
+   */
+  struct Message
+  {
+    uint64_t ts;           /**< Event timestamp. */
+    uint32_t context;      /**< Event context. */
+    uint32_t source;       /**< ID of the sending partition. */
+    uint64_t sequence;     /**< Sequence number within the sending partition. */
+    EventImpl *event;      /**< The event implementation, or 0 to cancel an event. */
+    uint32_t uid;          /**< Unique id of the event to cancel. */
+    Message *next;         /**< Next message in the mailbox. */
+  };
+  /**
+   * Compare two messages by timestamp, then by sender.
+   *
+   * \param [in] a The first message.
+   * \param [in] b The second message.
+   * \returns \c true if \pname{a} must be inserted before \pname{b}.
+   */
+  static bool MessageLess (const Message *a, const Message *b);
+
+  /** A set of events executed by a single thread at a time. */
+  struct Partition
+  {
+    const MultithreadedSimulatorImpl *simulator; /**< The simulator owning the partition. */
+    uint32_t id;                       /**< Partition ID, 0 for the global partition. */
+    Ptr<Scheduler> events;             /**< The event priority queue. */
+    uint32_t uid;                      /**< Next event unique id. */
+    uint32_t currentUid;               /**< Unique id of the current event. */
+    uint64_t currentTs;                /**< Timestamp of the current event. */
+    uint32_t currentContext;           /**< Execution context of the current event. */
+    std::atomic<uint64_t> eventCount;  /**< The event count. */
+    int unscheduledEvents;             /**< Number of events inserted but not yet executed. */
+    uint64_t sentMessages;             /**< Number of messages posted to other partitions. */
+    std::atomic<Message *> mailbox;    /**< Lock-free stack of incoming messages. */
+    uint64_t packetUid;                /**< Next uid of the packets created by the partition. */
+    /** Timestamps and uids of the events cancelled by other partitions. */
+    std::set<std::pair<uint64_t, uint32_t> > cancelledEvents;
+  };
+
+  /**
+   * \returns The partition of the calling thread.
+   */
+  Partition * GetCurrentPartition (void) const;
+  /**
+   * \param [in] context An event context.
+   * \returns The partition which executes the events with this context.
+   */
+  Partition * GetPartition (uint32_t context) const;
+  /**
+   * Insert an event in the event queue of a partition.
+   *
+   * \param [in] partition The partition.
+   * \param [in] ts The event timestamp.
+   * \param [in] context The event context.
+   * \param [in] event The event implementation.
+   * \returns The EventId of the event.
+   */
+  EventId Insert (Partition *partition, uint64_t ts, uint32_t context, EventImpl *event);
+  /**
+   * Post a message to the mailbox of a partition.
+   *
+   * \param [in] target The partition.
+   * \param [in] message The message.
+   */
+  void PostMessage (Partition *target, Message *message);
+  /**
+   * Cancel an event which belongs to another partition, at the end of the
+   * current window. Aborts if the event is due before the end of the window.
+   *
+   * \param [in] owner The partition of the event.
+   * \param [in] id The event.
+   */
+  void PostCancel (Partition *owner, const EventId &id);
+  /**
+   * Process the next event of a partition.
+   *
+   * \param [in] partition The partition.
+   */
+  void ProcessOneEvent (Partition *partition);
+  /**
+   * Process the events of a partition earlier than the end of the
+   * current window.
+   *
+   * \param [in] partition The partition.
+   */
+  void ProcessPartition (Partition *partition);
+  /**
+   * Move the messages of the mailboxes to the event queues.
+   */
+  void ProcessMessages (void);
+  /**
+   * Create a partition with an empty event queue.
+   *
+   * \returns The partition.
+   */
+  Partition * CreatePartition (void);
+  /**
+   * Group the nodes into partitions, compute the lookahead and move the
+   * events to the partition of their context.
+   */
+  void UpdatePartitions (void);
+  /**
+   * Create the worker threads.
+   */
+  void StartWorkers (void);
+  /**
+   * Stop and join the worker threads.
+   */
+  void StopWorkers (void);
+  /**
+   * Execute the current window, with the help of the worker threads.
+   */
+  void RunWindow (void);
+  /**
+   * Process the partitions of the current window, until all of them
+   * have been picked up by a thread.
+   */
+  void ProcessWindowPartitions (void);
+  /**
+   * Main loop of the worker threads.
+   */
+  void DoWorker (void);
+
+  /** The partitions, starting with the global partition. */
+  std::vector<Partition *> m_partitions;
+  /** The partition of each context (node ID). */
+  std::vector<Partition *> m_contextPartitions;
+  /** The node ID of each device, when Run() was called. */
+  std::map<const NetDevice *, uint32_t> m_deviceNodes;
+  /** The factory of the event queues. */
+  ObjectFactory m_schedulerFactory;
+
+  /** Partition of the calling thread, if it executes events. */
+  static thread_local Partition *g_currentPartition;
+
+  /** Maximum number of threads, including the main thread. */
+  uint32_t m_maxThreads;
+  /** Whether the channels with a delay split the partitions. */
+  bool m_splitChannels;
+  /** Lookahead, in time steps. */
+  uint64_t m_lookahead;
+
+  /** Whether the partitions are running concurrently. */
+  bool m_parallel;
+  /** End of the current window (excluded). */
+  uint64_t m_windowEnd;
+  /** The partitions with events in the current window. */
+  std::vector<Partition *> m_window;
+  /** Index in m_window of the next partition to process. */
+  std::atomic<uint32_t> m_nextWindowPartition;
+
+  /** The worker threads. */
+  std::vector<Ptr<SystemThread> > m_workers;
+  /** Mutex protecting the window generation and the exit flag. */
+  std::mutex m_workerMutex;
+  /** Signals a new window or the exit of the worker threads. */
+  std::condition_variable m_workerStart;
+  /** Signals the end of the current window. */
+  std::condition_variable m_workerDone;
+  /** Number of windows started. */
+  uint64_t m_windowGeneration;
+  /** Number of worker threads done with the current window. */
+  uint32_t m_idleWorkers;
+  /** Flag calling for the exit of the worker threads. */
+  bool m_workersExit;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Mutex to control access to the events to run at Destroy. */
+  mutable SystemMutex m_destroyEventsMutex;
+  /** Flag calling for the end of the simulation. */
+  std::atomic<bool> m_stop;
+
+  /** Main execution thread. */
+  SystemThread::ThreadId m_main;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
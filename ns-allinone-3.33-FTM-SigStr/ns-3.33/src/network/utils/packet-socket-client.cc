@@ -163,7 +163,7 @@ PacketSocketClient::Send (void)
 
   if ((m_socket->Send (p)) >= 0)
     {
-      m_txTrace (p, m_peerAddress);
+      NS_TRACE (m_txTrace, p, m_peerAddress);
       NS_LOG_INFO ("TraceDelay TX " << m_size << " bytes to "
                                     << peerAddressStringStream.str () << " Uid: "
                                     << p->GetUid () << " Time: "
@@ -124,7 +124,7 @@ PacketSocketServer::HandleRead (Ptr<Socket> socket)
                        << PacketSocketAddress::ConvertFrom (from)
                        << " total Rx " << m_pktRx << " packets"
                        << " and " << m_bytesRx << " bytes");
-          m_rxTrace (packet, from);
+          NS_TRACE (m_rxTrace, packet, from);
         }
     }
 }
@@ -424,7 +424,7 @@ PacketSocket::ForwardUp (Ptr<NetDevice> device, Ptr<const Packet> packet,
       //
       // drop and trace packet
       NS_LOG_WARN ("No receive buffer space available.  Drop.");
-      m_dropTrace (packet);
+      NS_TRACE (m_dropTrace, packet);
     }
 }
 
@@ -500,7 +500,7 @@ Queue<Item>::DoEnqueue (ConstIterator pos, Ptr<Item> item)
   m_nTotalReceivedPackets++;
 
   NS_LOG_LOGIC ("m_traceEnqueue (p)");
-  m_traceEnqueue (item);
+  NS_TRACE (m_traceEnqueue, item);
 
   return true;
 }
@@ -529,7 +529,7 @@ Queue<Item>::DoDequeue (ConstIterator pos)
       m_nPackets--;
 
       NS_LOG_LOGIC ("m_traceDequeue (p)");
-      m_traceDequeue (item);
+      NS_TRACE (m_traceDequeue, item);
     }
   return item;
 }
@@ -559,7 +559,7 @@ Queue<Item>::DoRemove (ConstIterator pos)
 
       // packets are first dequeued and then dropped
       NS_LOG_LOGIC ("m_traceDequeue (p)");
-      m_traceDequeue (item);
+      NS_TRACE (m_traceDequeue, item);
 
       DropAfterDequeue (item);
     }
@@ -628,8 +628,8 @@ Queue<Item>::DropBeforeEnqueue (Ptr<Item> item)
   m_nTotalDroppedBytesBeforeEnqueue += item->GetSize ();
 
   NS_LOG_LOGIC ("m_traceDropBeforeEnqueue (p)");
-  m_traceDrop (item);
-  m_traceDropBeforeEnqueue (item);
+  NS_TRACE (m_traceDrop, item);
+  NS_TRACE (m_traceDropBeforeEnqueue, item);
 }
 
 template <typename Item>
@@ -644,8 +644,8 @@ Queue<Item>::DropAfterDequeue (Ptr<Item> item)
   m_nTotalDroppedBytesAfterDequeue += item->GetSize ();
 
   NS_LOG_LOGIC ("m_traceDropAfterDequeue (p)");
-  m_traceDrop (item);
-  m_traceDropAfterDequeue (item);
+  NS_TRACE (m_traceDrop, item);
+  NS_TRACE (m_traceDropAfterDequeue, item);
 }
 
 // The following explicit template instantiation declarations prevent all the
@@ -59,7 +59,8 @@ SimpleChannel::Send (Ptr<Packet> p, uint16_t protocol,
   NS_LOG_FUNCTION (this << p << protocol << to << from << sender);
   for (std::vector<Ptr<SimpleNetDevice> >::const_iterator i = m_devices.begin (); i != m_devices.end (); ++i)
     {
-      Ptr<SimpleNetDevice> tmp = *i;
+      // do not copy the pointer: the device may be simulated by another thread
+      const Ptr<SimpleNetDevice> &tmp = *i;
       if (tmp == sender)
         {
           continue;
@@ -72,8 +73,7 @@ SimpleChannel::Send (Ptr<Packet> p, uint16_t protocol,
               continue;
             }
         }
-      Simulator::ScheduleWithContext (tmp->GetNode ()->GetId (), m_delay,
-                                      &SimpleNetDevice::Receive, tmp, p->Copy (), protocol, to, from);
+      ScheduleReceive (tmp, m_delay, &SimpleNetDevice::Receive, p, protocol, to, from);
     }
 }
 
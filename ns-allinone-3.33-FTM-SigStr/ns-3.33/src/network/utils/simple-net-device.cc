@@ -238,7 +238,7 @@ SimpleNetDevice::Receive (Ptr<Packet> packet, uint16_t protocol,
 
   if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt (packet) )
     {
-      m_phyRxDropTrace (packet);
+      NS_TRACE (m_phyRxDropTrace, packet);
       return;
     }
 
@@ -43,7 +43,8 @@ PointToPointChannel::GetTypeId (void)
     .AddTraceSource ("TxRxPointToPoint",
                      "Trace source indicating transmission of packet "
                      "from the PointToPointChannel, used by the Animation "
-                     "interface.",
+                     "interface. It is not fired for the packets sent to a "
+                     "device simulated by another thread.",
                      MakeTraceSourceAccessor (&PointToPointChannel::m_txrxPointToPoint),
                      "ns3::PointToPointChannel::TxRxAnimationCallback")
   ;
@@ -97,9 +98,12 @@ PointToPointChannel::TransmitStart (
 
   uint32_t wire = src == m_link[0].m_src ? 0 : 1;
 
-  Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode ()->GetId (),
-                                  txTime + m_delay, &PointToPointNetDevice::Receive,
-                                  m_link[wire].m_dst, p->Copy ());
+  if (ScheduleReceive (m_link[wire].m_dst, txTime + m_delay, &PointToPointNetDevice::Receive, p))
+    {
+      // the receiving device is simulated by another thread, which alone
+      // may update its reference count
+      return true;
+    }
 
   // Call the tx anim callback on the net device
   m_txrxPointToPoint (p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
@@ -128,6 +132,23 @@ PointToPointChannel::GetDevice (std::size_t i) const
   return GetPointToPointDevice (i);
 }
 
+Address
+PointToPointChannel::GetRemoteAddress (const PointToPointNetDevice *device) const
+{
+  NS_LOG_FUNCTION (this << device);
+  NS_ASSERT (m_nDevices == N_DEVICES);
+  for (std::size_t i = 0; i < N_DEVICES; i++)
+    {
+      if (PeekPointer (m_link[i].m_src) != device)
+        {
+          return m_link[i].m_src->GetAddress ();
+        }
+    }
+  NS_ASSERT (false);
+  // quiet compiler.
+  return Address ();
+}
+
 Time
 PointToPointChannel::GetDelay (void) const
 {
@@ -25,6 +25,7 @@
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
 #include "ns3/traced-callback.h"
+#include "ns3/address.h"
 
 namespace ns3 {
 
@@ -100,6 +101,17 @@ public:
    */
   virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
 
+  /**
+   * \brief Get the address of the other device of this channel
+   *
+   * Unlike GetPointToPointDevice(), this method does not copy the pointer
+   * to the other device, which may be simulated by another thread.
+   *
+   * \param device a device of this channel
+   * \returns the address of the other device
+   */
+  Address GetRemoteAddress (const PointToPointNetDevice *device) const;
+
 protected:
   /**
    * \brief Get the delay associated with this channel
@@ -617,17 +617,9 @@ PointToPointNetDevice::GetRemote (void) const
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (m_channel->GetNDevices () == 2);
-  for (std::size_t i = 0; i < m_channel->GetNDevices (); ++i)
-    {
-      Ptr<NetDevice> tmp = m_channel->GetDevice (i);
-      if (tmp != this)
-        {
-          return tmp->GetAddress ();
-        }
-    }
-  NS_ASSERT (false);
-  // quiet compiler.
-  return Address ();
+  // the remote device may be simulated by another thread: do not copy
+  // the pointer to it
+  return m_channel->GetRemoteAddress (this);
 }
 
 bool
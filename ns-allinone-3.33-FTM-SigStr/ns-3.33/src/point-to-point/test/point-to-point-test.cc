@@ -24,6 +24,15 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/node-container.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/global-value.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/flow-id-tag.h"
+#include "ns3/socket.h"
 
 using namespace ns3;
 
@@ -94,6 +103,160 @@ PointToPointTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief Test of PointToPointChannels whose devices are simulated by
+ * different threads of the MultithreadedSimulatorImpl
+ *
+ * Two pairs of nodes exchange packets over split channels: the packets
+ * must all be received with their byte and packet tags, and the
+ * TxRxPointToPoint trace source, which would reference the device of
+ * another thread, must not be fired.
+ */
+class PointToPointMultithreadedTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointMultithreadedTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Send packets from a device
+   *
+   * \param device the sending device
+   * \param remaining the number of packets left to send
+   */
+  void Send (Ptr<PointToPointNetDevice> device, uint32_t remaining);
+  /**
+   * \brief Receive a packet
+   *
+   * \param device the receiving device
+   * \param packet the packet
+   * \param protocol the protocol number
+   * \param from the sender address
+   * \returns true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+  /**
+   * \brief Sink of the TxRxPointToPoint trace source
+   */
+  void TxRx (Ptr<const Packet>, Ptr<NetDevice>, Ptr<NetDevice>, Time, Time);
+
+  static const uint32_t N_NODES = 4;     //!< number of nodes
+  static const uint32_t N_PACKETS = 50;  //!< number of packets sent by each node
+  std::vector<uint32_t> m_received;      //!< number of packets received by each node
+  uint32_t m_txrx;                       //!< number of TxRxPointToPoint traces
+};
+
+const uint32_t PointToPointMultithreadedTest::N_NODES;
+const uint32_t PointToPointMultithreadedTest::N_PACKETS;
+
+PointToPointMultithreadedTest::PointToPointMultithreadedTest ()
+  : TestCase ("PointToPoint with the multi-threaded simulator")
+{
+}
+
+void
+PointToPointMultithreadedTest::Send (Ptr<PointToPointNetDevice> device, uint32_t remaining)
+{
+  uint32_t node = device->GetNode ()->GetId ();
+  Ptr<Packet> p = Create<Packet> (100 + node);
+  // the packets sent to another thread are copied: the tags must follow
+  p->AddByteTag (FlowIdTag (node));
+  SocketPriorityTag priority;
+  priority.SetPriority (node + 1);
+  p->AddPacketTag (priority);
+  device->Send (p, device->GetBroadcast (), 0x800);
+  if (remaining > 1)
+    {
+      Simulator::Schedule (MicroSeconds (20), &PointToPointMultithreadedTest::Send, this, device, remaining - 1);
+    }
+}
+
+bool
+PointToPointMultithreadedTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                        uint16_t protocol, const Address &from)
+{
+  uint32_t node = device->GetNode ()->GetId ();
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 100 + (node ^ 1), "Unexpected packet received by node " << node);
+  ByteTagIterator i = packet->GetByteTagIterator ();
+  NS_TEST_EXPECT_MSG_EQ (i.HasNext (), true, "Byte tag lost by node " << node);
+  if (i.HasNext ())
+    {
+      ByteTagIterator::Item item = i.Next ();
+      NS_TEST_EXPECT_MSG_EQ (item.GetTypeId (), FlowIdTag::GetTypeId (), "Unexpected byte tag");
+      NS_TEST_EXPECT_MSG_EQ (item.GetStart (), 0, "Unexpected start of the byte tag");
+      NS_TEST_EXPECT_MSG_EQ (item.GetEnd (), packet->GetSize (), "Unexpected end of the byte tag");
+      FlowIdTag flowId;
+      item.GetTag (flowId);
+      NS_TEST_EXPECT_MSG_EQ (flowId.GetFlowId (), (node ^ 1), "Unexpected byte tag value");
+      NS_TEST_EXPECT_MSG_EQ (i.HasNext (), false, "Unexpected byte tags");
+    }
+  SocketPriorityTag priority;
+  NS_TEST_EXPECT_MSG_EQ (packet->PeekPacketTag (priority), true, "Packet tag lost by node " << node);
+  NS_TEST_EXPECT_MSG_EQ (+priority.GetPriority (), ((node ^ 1) + 1), "Unexpected packet tag value");
+  m_received[node]++;
+  return true;
+}
+
+void
+PointToPointMultithreadedTest::TxRx (Ptr<const Packet>, Ptr<NetDevice>, Ptr<NetDevice>, Time, Time)
+{
+  m_txrx++;
+}
+
+void
+PointToPointMultithreadedTest::DoRun (void)
+{
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::MultithreadedSimulatorImpl"));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::SplitChannels", BooleanValue (true));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (N_NODES));
+
+  NodeContainer nodes;
+  nodes.Create (N_NODES);
+  m_received.assign (N_NODES, 0);
+  m_txrx = 0;
+  for (uint32_t i = 0; i < N_NODES; i += 2)
+    {
+      Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel> ();
+      channel->SetAttribute ("Delay", TimeValue (MicroSeconds (10)));
+      channel->TraceConnectWithoutContext ("TxRxPointToPoint",
+                                           MakeCallback (&PointToPointMultithreadedTest::TxRx, this));
+      for (uint32_t j = i; j < i + 2; j++)
+        {
+          Ptr<PointToPointNetDevice> device = CreateObject<PointToPointNetDevice> ();
+          device->Attach (channel);
+          device->SetAddress (Mac48Address::Allocate ());
+          device->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+          nodes.Get (j)->AddDevice (device);
+          device->SetReceiveCallback (MakeCallback (&PointToPointMultithreadedTest::Receive, this));
+          Simulator::ScheduleWithContext (j, MicroSeconds (j), &PointToPointMultithreadedTest::Send,
+                                          this, device, N_PACKETS);
+        }
+    }
+
+  Simulator::Run ();
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_EXPECT_MSG_EQ (impl->GetNPartitions (), N_NODES, "The channels should split the partitions");
+  Simulator::Destroy ();
+
+  for (uint32_t node = 0; node < N_NODES; node++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_received[node], N_PACKETS, "Unexpected number of packets received by node " << node);
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_txrx, 0, "The trace source must not reference the devices of other threads");
+
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::SplitChannels", BooleanValue (false));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (0));
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -110,6 +273,7 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest, TestCase::QUICK);
+  AddTestCase (new PointToPointMultithreadedTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
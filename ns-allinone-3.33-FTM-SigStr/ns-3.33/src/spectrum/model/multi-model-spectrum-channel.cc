@@ -29,7 +29,9 @@
 #include <ns3/net-device.h>
 #include <ns3/node.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include <ns3/mobility-model.h>
+#include <ns3/constant-position-mobility-model.h>
 #include <ns3/spectrum-phy.h>
 #include <ns3/spectrum-converter.h>
 #include <ns3/spectrum-propagation-loss-model.h>
@@ -79,7 +81,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
-  : m_numDevices {0}
+  : m_numDevices {0},
+    m_linkStateCacheEnabled (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -90,6 +93,12 @@ MultiModelSpectrumChannel::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  m_linkStateMap.clear ();
+  for (auto mobility : m_watchedMobility)
+    {
+      mobility->TraceDisconnectWithoutContext ("CourseChange", MakeCallback (&MultiModelSpectrumChannel::NotifyCourseChange, this));
+    }
+  m_watchedMobility.clear ();
   SpectrumChannel::DoDispose ();
 }
 
@@ -100,7 +109,14 @@ MultiModelSpectrumChannel::GetTypeId (void)
     .SetParent<SpectrumChannel> ()
     .SetGroupName ("Spectrum")
     .AddConstructor<MultiModelSpectrumChannel> ()
-
+    .AddAttribute ("LinkStateCache",
+                   "If true, the antenna gains, propagation loss and propagation delay "
+                   "between two nodes using a ConstantPositionMobilityModel are computed "
+                   "once and reused until either node changes course. Only enable this "
+                   "if the propagation loss and delay models are deterministic.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MultiModelSpectrumChannel::m_linkStateCacheEnabled),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -220,6 +236,11 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
   NS_ASSERT (txParams->txPhy);
   NS_ASSERT (txParams->psd);
+  if (!IsLocal (txParams->txPhy))
+    {
+      // the transmission is simulated by the logical process owning the sender
+      return;
+    }
   Ptr<SpectrumSignalParameters> txParamsTrace = txParams->Copy (); // copy it since traced value cannot be const (because of potential underlying DynamicCasts)
   m_txSigParamsTrace (txParamsTrace);
 
@@ -269,6 +290,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
           if ((*rxPhyIterator) != txParams->txPhy)
             {
+              CheckLocalReceiver (*rxPhyIterator);
               NS_LOG_LOGIC ("copying signal parameters " << txParams);
               Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
               rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
@@ -278,34 +300,45 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
               if (txMobility && receiverMobility)
                 {
-                  double txAntennaGain = 0;
-                  double rxAntennaGain = 0;
-                  double propagationGainDb = 0;
-                  double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
+                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
+                  SpectrumLinkStateMap_t::iterator linkIt = m_linkStateMap.end ();
+                  bool cacheable = m_linkStateCacheEnabled
+                    && DynamicCast<ConstantPositionMobilityModel> (txMobility)
+                    && DynamicCast<ConstantPositionMobilityModel> (receiverMobility);
+                  if (cacheable)
                     {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
+                      linkIt = m_linkStateMap.find (std::make_pair (txParams->txPhy, *rxPhyIterator));
+                      if (linkIt != m_linkStateMap.end ()
+                          && (linkIt->second.txAntenna != PeekPointer (rxParams->txAntenna)
+                              || linkIt->second.rxAntenna != PeekPointer (rxAntenna)
+                              || linkIt->second.txMobility != PeekPointer (txMobility)
+                              || linkIt->second.rxMobility != PeekPointer (receiverMobility)))
+                        {
+                          NS_LOG_LOGIC ("antenna or mobility model changed, recomputing link state");
+                          m_linkStateMap.erase (linkIt);
+                          linkIt = m_linkStateMap.end ();
+                        }
                     }
-                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
+                  SpectrumLinkState linkState;
+                  if (linkIt != m_linkStateMap.end ())
                     {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
+                      NS_LOG_LOGIC ("using cached link state");
+                      linkState = linkIt->second;
                     }
-                  if (m_propagationLoss)
+                  else
                     {
-                      propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
+                      linkState = CalcLinkState (rxParams->txAntenna, rxAntenna, txMobility, receiverMobility);
+                      if (cacheable)
+                        {
+                          linkIt = m_linkStateMap.insert (std::make_pair (std::make_pair (txParams->txPhy, *rxPhyIterator), linkState)).first;
+                          WatchMobility (txMobility);
+                          WatchMobility (receiverMobility);
+                        }
+                    }
+                  double pathLossDb = linkState.pathLossDb;
                   NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
                   // Gain trace
-                  m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
+                  m_gainTrace (txMobility, receiverMobility, linkState.txAntennaGainDb, linkState.rxAntennaGainDb, linkState.propagationGainDb, pathLossDb);
                   // Pathloss trace
                   m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
                   if (pathLossDb > m_maxLossDb)
@@ -323,7 +356,19 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
                   if (m_propagationDelay)
                     {
-                      delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
+                      if (linkIt != m_linkStateMap.end () && linkIt->second.delayValid)
+                        {
+                          delay = linkIt->second.delay;
+                        }
+                      else
+                        {
+                          delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
+                          if (linkIt != m_linkStateMap.end ())
+                            {
+                              linkIt->second.delay = delay;
+                              linkIt->second.delayValid = true;
+                            }
+                        }
                     }
                 }
 
@@ -348,6 +393,71 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
 }
 
+SpectrumLinkState
+MultiModelSpectrumChannel::CalcLinkState (Ptr<AntennaModel> txAntenna, Ptr<AntennaModel> rxAntenna,
+                                          Ptr<MobilityModel> txMobility, Ptr<MobilityModel> rxMobility) const
+{
+  NS_LOG_FUNCTION (this << txMobility << rxMobility);
+  SpectrumLinkState linkState;
+  linkState.txAntenna = PeekPointer (txAntenna);
+  linkState.rxAntenna = PeekPointer (rxAntenna);
+  linkState.txMobility = PeekPointer (txMobility);
+  linkState.rxMobility = PeekPointer (rxMobility);
+  linkState.txAntennaGainDb = 0;
+  linkState.rxAntennaGainDb = 0;
+  linkState.propagationGainDb = 0;
+  linkState.pathLossDb = 0;
+  linkState.delayValid = false;
+  if (txAntenna != 0)
+    {
+      Angles txAngles (rxMobility->GetPosition (), txMobility->GetPosition ());
+      linkState.txAntennaGainDb = txAntenna->GetGainDb (txAngles);
+      NS_LOG_LOGIC ("txAntennaGain = " << linkState.txAntennaGainDb << " dB");
+      linkState.pathLossDb -= linkState.txAntennaGainDb;
+    }
+  if (rxAntenna != 0)
+    {
+      Angles rxAngles (txMobility->GetPosition (), rxMobility->GetPosition ());
+      linkState.rxAntennaGainDb = rxAntenna->GetGainDb (rxAngles);
+      NS_LOG_LOGIC ("rxAntennaGain = " << linkState.rxAntennaGainDb << " dB");
+      linkState.pathLossDb -= linkState.rxAntennaGainDb;
+    }
+  if (m_propagationLoss)
+    {
+      linkState.propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, rxMobility);
+      NS_LOG_LOGIC ("propagationGainDb = " << linkState.propagationGainDb << " dB");
+      linkState.pathLossDb -= linkState.propagationGainDb;
+    }
+  return linkState;
+}
+
+void
+MultiModelSpectrumChannel::WatchMobility (Ptr<MobilityModel> mobility)
+{
+  if (m_watchedMobility.insert (mobility).second)
+    {
+      NS_LOG_FUNCTION (this << mobility);
+      mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&MultiModelSpectrumChannel::NotifyCourseChange, this));
+    }
+}
+
+void
+MultiModelSpectrumChannel::NotifyCourseChange (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  for (SpectrumLinkStateMap_t::iterator it = m_linkStateMap.begin (); it != m_linkStateMap.end (); )
+    {
+      if (it->second.txMobility == PeekPointer (mobility) || it->second.rxMobility == PeekPointer (mobility))
+        {
+          it = m_linkStateMap.erase (it);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+}
+
 void
 MultiModelSpectrumChannel::StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
 {
@@ -27,6 +27,8 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
+#include <ns3/mobility-model.h>
+#include <ns3/antenna-model.h>
 #include <map>
 #include <set>
 
@@ -90,6 +92,32 @@ public:
 typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap_t;
 
 
+/**
+ * \ingroup spectrum
+ * Propagation results for a (transmitter, receiver) pair, cached by
+ * MultiModelSpectrumChannel when both nodes are static.
+ */
+struct SpectrumLinkState
+{
+  const AntennaModel *txAntenna;    //!< TX antenna the gains were computed with
+  const AntennaModel *rxAntenna;    //!< RX antenna the gains were computed with
+  const MobilityModel *txMobility;  //!< TX mobility model
+  const MobilityModel *rxMobility;  //!< RX mobility model
+  double txAntennaGainDb;           //!< TX antenna gain (dB)
+  double rxAntennaGainDb;           //!< RX antenna gain (dB)
+  double propagationGainDb;         //!< gain returned by the propagation loss model (dB)
+  double pathLossDb;                //!< total path loss (dB)
+  bool delayValid;                  //!< whether delay has been computed yet
+  Time delay;                       //!< propagation delay
+};
+
+/**
+ * \ingroup spectrum
+ * Container: (TX SpectrumPhy, RX SpectrumPhy), SpectrumLinkState
+ */
+typedef std::map<std::pair<Ptr<const SpectrumPhy>, Ptr<const SpectrumPhy> >, SpectrumLinkState> SpectrumLinkStateMap_t;
+
+
 /**
  * \ingroup spectrum
  *
@@ -102,6 +130,15 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * \note If the LinkStateCache attribute is set, the antenna gains, the
+ * propagation loss and the propagation delay computed for a pair of
+ * nodes which both use a ConstantPositionMobilityModel are reused for
+ * the following transmissions between them, until either node reports a
+ * course change. This is only correct if the PropagationLossModel and
+ * the PropagationDelayModel are deterministic. The
+ * SpectrumPropagationLossModel is still invoked for every transmission,
+ * since its result may depend on the PSD and on time.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -149,6 +186,33 @@ private:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * Compute the antenna gains and the propagation loss between two nodes.
+   *
+   * \param txAntenna the TX antenna, if any
+   * \param rxAntenna the RX antenna, if any
+   * \param txMobility the TX mobility model
+   * \param rxMobility the RX mobility model
+   * \return the link state, without the propagation delay
+   */
+  SpectrumLinkState CalcLinkState (Ptr<AntennaModel> txAntenna, Ptr<AntennaModel> rxAntenna,
+                                   Ptr<MobilityModel> txMobility, Ptr<MobilityModel> rxMobility) const;
+
+  /**
+   * Connect to the CourseChange trace of a mobility model whose links are
+   * cached, unless already done.
+   *
+   * \param mobility the mobility model
+   */
+  void WatchMobility (Ptr<MobilityModel> mobility);
+
+  /**
+   * Invalidate the cached links involving a mobility model.
+   *
+   * \param mobility the mobility model which changed course
+   */
+  void NotifyCourseChange (Ptr<const MobilityModel> mobility);
+
   /**
    * Data structure holding, for each TX SpectrumModel,  all the
    * converters to any RX SpectrumModel, and all the corresponding
@@ -169,6 +233,10 @@ private:
    */
   std::size_t m_numDevices;
 
+  bool m_linkStateCacheEnabled;               //!< whether link states of static nodes are cached
+  SpectrumLinkStateMap_t m_linkStateMap;      //!< cached link states
+  std::set<Ptr<MobilityModel> > m_watchedMobility; //!< mobility models whose CourseChange trace is connected
+
 };
 
 
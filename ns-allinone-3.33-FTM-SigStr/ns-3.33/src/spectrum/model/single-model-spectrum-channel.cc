@@ -85,6 +85,11 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_FUNCTION (this << txParams->psd << txParams->duration << txParams->txPhy);
   NS_ASSERT_MSG (txParams->psd, "NULL txPsd");
   NS_ASSERT_MSG (txParams->txPhy, "NULL txPhy");
+  if (!IsLocal (txParams->txPhy))
+    {
+      // the transmission is simulated by the logical process owning the sender
+      return;
+    }
 
   Ptr<SpectrumSignalParameters> txParamsTrace = txParams->Copy (); // copy it since traced value cannot be const (because of potential underlying DynamicCasts)
   m_txSigParamsTrace (txParamsTrace);
@@ -112,6 +117,7 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
     {
       if ((*rxPhyIterator) != txParams->txPhy)
         {
+          CheckLocalReceiver (*rxPhyIterator);
           Time delay  = MicroSeconds (0);
 
           Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
@@ -21,6 +21,10 @@
 #include <ns3/log.h>
 #include <ns3/double.h>
 #include <ns3/pointer.h>
+#include <ns3/boolean.h>
+#include <ns3/simulator.h>
+#include <ns3/net-device.h>
+#include <ns3/node.h>
 
 #include "spectrum-channel.h"
 
@@ -32,6 +36,7 @@ NS_LOG_COMPONENT_DEFINE ("SpectrumChannel");
 NS_OBJECT_ENSURE_REGISTERED (SpectrumChannel);
 
 SpectrumChannel::SpectrumChannel ()
+  : m_partitioned (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -76,6 +81,19 @@ SpectrumChannel::GetTypeId (void)
                    MakePointerAccessor (&SpectrumChannel::m_propagationLoss),
                    MakePointerChecker<PropagationLossModel> ())
 
+    .AddAttribute ("Partitioned",
+                   "If true, signals are only carried between the nodes of the local "
+                   "logical process (see Simulator::GetSystemId). This allows a distributed "
+                   "simulation to be partitioned by frequency: every node sharing spectrum "
+                   "with another one must then belong to the same logical process, otherwise "
+                   "the simulation is aborted when a signal would cross logical processes. "
+                   "Only the signals are partitioned: the MAC of the remote nodes (e.g., "
+                   "beacons and probing) still runs in every logical process, and its "
+                   "transmissions are discarded by the channel.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SpectrumChannel::m_partitioned),
+                   MakeBooleanChecker ())
+
     .AddTraceSource ("Gain",
                      "This trace is fired whenever a new path loss value "
                      "is calculated. The parameters to this trace are : "
@@ -155,5 +173,28 @@ SpectrumChannel::GetPropagationLossModel ()
   return m_propagationLoss;
 }
 
+bool
+SpectrumChannel::IsLocal (Ptr<const SpectrumPhy> phy) const
+{
+  if (!m_partitioned)
+    {
+      return true;
+    }
+  Ptr<NetDevice> device = phy->GetDevice ();
+  return device == 0 || device->GetNode ()->GetSystemId () == Simulator::GetSystemId ();
+}
+
+void
+SpectrumChannel::CheckLocalReceiver (Ptr<const SpectrumPhy> rxPhy) const
+{
+  if (!IsLocal (rxPhy))
+    {
+      NS_FATAL_ERROR ("Node " << rxPhy->GetDevice ()->GetNode ()->GetId () << " shares spectrum with a node"
+                      " of logical process " << Simulator::GetSystemId () << " but belongs to another"
+                      " logical process; all the nodes sharing spectrum must belong to the same"
+                      " logical process");
+    }
+}
+
 
 } // namespace
@@ -157,6 +157,21 @@ public:
   typedef void (* SignalParametersTracedCallback) (Ptr<SpectrumSignalParameters> params);
 
 protected:
+  /**
+   * \param phy the SpectrumPhy
+   * \return true if the Partitioned attribute is false, or if the node of the
+   *         given SpectrumPhy belongs to the logical process being simulated by
+   *         this instance (see Simulator::GetSystemId)
+   */
+  bool IsLocal (Ptr<const SpectrumPhy> phy) const;
+  /**
+   * Abort the simulation if the given receiver, which shares spectrum with
+   * a local transmitter, belongs to another logical process while the
+   * Partitioned attribute is true: the signal would be lost.
+   *
+   * \param rxPhy the receiver
+   */
+  void CheckLocalReceiver (Ptr<const SpectrumPhy> rxPhy) const;
 
   /**
    * The `PathLoss` trace source. Exporting the pointers to the Tx and Rx
@@ -198,6 +213,11 @@ protected:
    */
   Ptr<SpectrumPropagationLossModel> m_spectrumPropagationLoss;
 
+  /**
+   * Whether signals are only carried between the nodes of the local logical process.
+   */
+  bool m_partitioned;
+
 
 };
 
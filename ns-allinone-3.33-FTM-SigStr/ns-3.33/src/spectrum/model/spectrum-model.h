@@ -120,6 +120,14 @@ public:
    */
   Bands::const_iterator End () const;
 
+  /**
+   * The width (fh - fl) of each band, stored contiguously so that
+   * integration kernels do not need to walk the BandInfo structures.
+   *
+   * \returns the width of each band in Hz
+   */
+  const std::vector<double>& GetBandWidths () const;
+
   /**
    * Check if another SpectrumModels has bands orthogonal to our bands.
    *
@@ -129,7 +137,13 @@ public:
   bool IsOrthogonal (const SpectrumModel &other) const;
 
 private:
+  /**
+   * Fill m_bandWidths from m_bands.
+   */
+  void InitBandWidths ();
+
   Bands m_bands;         //!< Actual definition of frequency bands within this SpectrumModel
+  std::vector<double> m_bandWidths; //!< Width of each band, in the same order as m_bands
   SpectrumModelUid_t m_uid;        //!< unique id for a given set of frequencies
   static SpectrumModelUid_t m_uidCount;    //!< counter to assign m_uids
 };
@@ -22,6 +22,7 @@
 #include <ns3/spectrum-value.h>
 #include <ns3/math.h>
 #include <ns3/log.h>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -106,17 +107,15 @@ SpectrumValue::ConstBandsEnd () const
 void
 SpectrumValue::Add (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
   NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  double *a = m_values.data ();
+  const double *b = x.m_values.data ();
+  const size_t n = m_values.size ();
+  for (size_t i = 0; i < n; ++i)
     {
-      *it1 += *it2;
-      ++it1;
-      ++it2;
+      a[i] += b[i];
     }
 }
 
@@ -124,12 +123,11 @@ SpectrumValue::Add (const SpectrumValue& x)
 void
 SpectrumValue::Add (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *a = m_values.data ();
+  const size_t n = m_values.size ();
+  for (size_t i = 0; i < n; ++i)
     {
-      *it1 += s;
-      ++it1;
+      a[i] += s;
     }
 }
 
@@ -138,17 +136,15 @@ SpectrumValue::Add (double s)
 void
 SpectrumValue::Subtract (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
   NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  double *a = m_values.data ();
+  const double *b = x.m_values.data ();
+  const size_t n = m_values.size ();
+  for (size_t i = 0; i < n; ++i)
     {
-      *it1 -= *it2;
-      ++it1;
-      ++it2;
+      a[i] -= b[i];
     }
 }
 
@@ -164,17 +160,15 @@ SpectrumValue::Subtract (double s)
 void
 SpectrumValue::Multiply (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
   NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  double *a = m_values.data ();
+  const double *b = x.m_values.data ();
+  const size_t n = m_values.size ();
+  for (size_t i = 0; i < n; ++i)
     {
-      *it1 *= *it2;
-      ++it1;
-      ++it2;
+      a[i] *= b[i];
     }
 }
 
@@ -182,12 +176,11 @@ SpectrumValue::Multiply (const SpectrumValue& x)
 void
 SpectrumValue::Multiply (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *a = m_values.data ();
+  const size_t n = m_values.size ();
+  for (size_t i = 0; i < n; ++i)
     {
-      *it1 *= s;
-      ++it1;
+      a[i] *= s;
     }
 }
 
@@ -197,17 +190,15 @@ SpectrumValue::Multiply (double s)
 void
 SpectrumValue::Divide (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
   NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  double *a = m_values.data ();
+  const double *b = x.m_values.data ();
+  const size_t n = m_values.size ();
+  for (size_t i = 0; i < n; ++i)
     {
-      *it1 /= *it2;
-      ++it1;
-      ++it2;
+      a[i] /= b[i];
     }
 }
 
@@ -216,12 +207,11 @@ void
 SpectrumValue::Divide (double s)
 {
   NS_LOG_FUNCTION (this << s);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *a = m_values.data ();
+  const size_t n = m_values.size ();
+  for (size_t i = 0; i < n; ++i)
     {
-      *it1 /= s;
-      ++it1;
+      a[i] /= s;
     }
 }
 
@@ -348,11 +338,11 @@ double
 Norm (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
+  const double *a = x.m_values.data ();
+  const size_t n = x.m_values.size ();
+  for (size_t i = 0; i < n; ++i)
     {
-      s += (*it1) * (*it1);
-      ++it1;
+      s += a[i] * a[i];
     }
   return std::sqrt (s);
 }
@@ -362,11 +352,11 @@ double
 Sum (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
+  const double *a = x.m_values.data ();
+  const size_t n = x.m_values.size ();
+  for (size_t i = 0; i < n; ++i)
     {
-      s += (*it1);
-      ++it1;
+      s += a[i];
     }
   return s;
 }
@@ -389,17 +379,26 @@ Prod (const SpectrumValue& x)
 double
 Integral (const SpectrumValue& arg)
 {
+  if (arg.m_values.empty ())
+    {
+      return 0;
+    }
+  return Integral (arg, 0, arg.m_values.size () - 1);
+}
+
+double
+Integral (const SpectrumValue& arg, size_t startIndex, size_t stopIndex)
+{
+  const std::vector<double> &widths = arg.m_spectrumModel->GetBandWidths ();
+  NS_ASSERT (widths.size () == arg.m_values.size ());
+  NS_ASSERT (startIndex <= stopIndex && stopIndex < arg.m_values.size ());
+  const double *v = arg.m_values.data ();
+  const double *w = widths.data ();
   double i = 0;
-  Values::const_iterator vit = arg.ConstValuesBegin ();
-  Bands::const_iterator bit = arg.ConstBandsBegin ();
-  while (vit != arg.ConstValuesEnd ())
+  for (size_t k = startIndex; k <= stopIndex; ++k)
     {
-      NS_ASSERT (bit != arg.ConstBandsEnd ());
-      i += (*vit) * (bit->fh - bit->fl);
-      ++vit;
-      ++bit;
+      i += v[k] * w[k];
     }
-  NS_ASSERT (bit == arg.ConstBandsEnd ());
   return i;
 }
 
@@ -467,9 +466,8 @@ operator+ (double lhs, const SpectrumValue& rhs)
 SpectrumValue
 operator- (const SpectrumValue& lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = rhs;
-  res.ChangeSign ();
-  res.Add (lhs);
+  SpectrumValue res = lhs;
+  res.Subtract (rhs);
   return res;
 }
 
@@ -664,12 +662,41 @@ SpectrumValue::operator/= (double rhs)
 SpectrumValue&
 SpectrumValue::operator= (double rhs)
 {
-  Values::iterator it1 = m_values.begin ();
+  std::fill (m_values.begin (), m_values.end (), rhs);
+  return *this;
+}
 
-  while (it1 != m_values.end ())
+SpectrumValue&
+SpectrumValue::MultiplyAdd (const SpectrumValue& x, const SpectrumValue& gain)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_spectrumModel == gain.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  NS_ASSERT (m_values.size () == gain.m_values.size ());
+
+  double *a = m_values.data ();
+  const double *b = x.m_values.data ();
+  const double *g = gain.m_values.data ();
+  const size_t n = m_values.size ();
+  for (size_t i = 0; i < n; ++i)
     {
-      *it1 = rhs;
-      ++it1;
+      a[i] += b[i] * g[i];
+    }
+  return *this;
+}
+
+SpectrumValue&
+SpectrumValue::MultiplyAdd (const SpectrumValue& x, double gain)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+
+  double *a = m_values.data ();
+  const double *b = x.m_values.data ();
+  const size_t n = m_values.size ();
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] += b[i] * gain;
     }
   return *this;
 }
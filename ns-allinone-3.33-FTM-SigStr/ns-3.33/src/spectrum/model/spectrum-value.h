@@ -420,6 +420,28 @@ public:
    */
   SpectrumValue& operator= (double rhs);
 
+  /**
+   * Add the component by component product of x and gain to *this,
+   * i.e., *this += x * gain, without creating a temporary SpectrumValue.
+   *
+   * @param x the operand
+   * @param gain the per-band gain applied to x
+   *
+   * @return a reference to *this
+   */
+  SpectrumValue& MultiplyAdd (const SpectrumValue& x, const SpectrumValue& gain);
+
+  /**
+   * Add x scaled by gain to *this, i.e., *this += x * gain, without
+   * creating a temporary SpectrumValue.
+   *
+   * @param x the operand
+   * @param gain the gain applied to every component of x
+   *
+   * @return a reference to *this
+   */
+  SpectrumValue& MultiplyAdd (const SpectrumValue& x, double gain);
+
 
 
   /**
@@ -508,6 +530,19 @@ public:
    */
   friend double Integral (const SpectrumValue&  arg);
 
+  /**
+   * Integrate over a contiguous range of bands only. This is equivalent to
+   * multiplying arg by a filter which is 1 over [startIndex, stopIndex] and
+   * 0 elsewhere and integrating the result, without building the filter.
+   *
+   * @param arg the argument
+   * @param startIndex the index of the first band to integrate
+   * @param stopIndex the index of the last band to integrate (included)
+   *
+   * @return the value of the integral of g(f) over the bands in the range
+   */
+  friend double Integral (const SpectrumValue&  arg, size_t startIndex, size_t stopIndex);
+
   /**
    *
    * @return a Ptr to a copy of this instance
@@ -630,6 +665,7 @@ SpectrumValue Log10 (const SpectrumValue& arg);
 SpectrumValue Log2 (const SpectrumValue& arg);
 SpectrumValue Log (const SpectrumValue& arg);
 double Integral (const SpectrumValue& arg);
+double Integral (const SpectrumValue& arg, size_t startIndex, size_t stopIndex);
 
 
 } // namespace ns3
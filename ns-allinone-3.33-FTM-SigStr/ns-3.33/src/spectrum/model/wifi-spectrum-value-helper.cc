@@ -24,6 +24,7 @@
 
 #include <map>
 #include <cmath>
+#include <tuple>
 #include "wifi-spectrum-value-helper.h"
 #include "ns3/log.h"
 #include "ns3/fatal-error.h"
@@ -131,9 +132,140 @@ WifiSpectrumValueHelper::GetSpectrumModel (uint32_t centerFrequency, uint16_t ch
   return ret;
 }
 
-// Power allocated to 71 center subbands out of 135 total subbands in the band
+///< Wifi transmit PSD template structure
+struct WifiTxPsdTemplateId
+{
+  /**
+   * Constructor
+   * \param t the type of transmit PSD
+   * \param f the frequency (in MHz)
+   * \param w the channel width (in MHz)
+   * \param g the guard band width (in MHz)
+   * \param i the minimum relative power in the inner band (in dBr)
+   * \param o the minimum relative power in the outer band (in dBr)
+   * \param l the maximum relative power of the outermost subcarriers of the guard band (in dBr)
+   */
+  WifiTxPsdTemplateId (uint8_t t, uint32_t f, uint16_t w, uint16_t g, double i, double o, double l);
+  uint8_t m_type;             ///< type of transmit PSD (DSSS, OFDM, HT OFDM or HE OFDM)
+  uint32_t m_centerFrequency; ///< center frequency (in MHz)
+  uint16_t m_channelWidth;    ///< channel width (in MHz)
+  uint16_t m_guardBandwidth;  ///< guard band width (in MHz)
+  double m_minInnerBandDbr;   ///< minimum relative power in the inner band (in dBr)
+  double m_minOuterBandDbr;   ///< minimum relative power in the outer band (in dBr)
+  double m_lowestPointDbr;    ///< maximum relative power of the outermost subcarriers of the guard band (in dBr)
+};
+
+WifiTxPsdTemplateId::WifiTxPsdTemplateId (uint8_t t, uint32_t f, uint16_t w, uint16_t g, double i, double o, double l)
+  : m_type (t),
+    m_centerFrequency (f),
+    m_channelWidth (w),
+    m_guardBandwidth (g),
+    m_minInnerBandDbr (i),
+    m_minOuterBandDbr (o),
+    m_lowestPointDbr (l)
+{
+}
+
+/**
+ * Less than operator
+ * \param a the first transmit PSD template to compare
+ * \param b the second transmit PSD template to compare
+ * \returns true if the first template is less than the second template
+ */
+bool
+operator < (const WifiTxPsdTemplateId& a, const WifiTxPsdTemplateId& b)
+{
+  return std::tie (a.m_type, a.m_centerFrequency, a.m_channelWidth, a.m_guardBandwidth,
+                   a.m_minInnerBandDbr, a.m_minOuterBandDbr, a.m_lowestPointDbr)
+         < std::tie (b.m_type, b.m_centerFrequency, b.m_channelWidth, b.m_guardBandwidth,
+                     b.m_minInnerBandDbr, b.m_minOuterBandDbr, b.m_lowestPointDbr);
+}
+
+/// Types of transmit PSD templates
+enum WifiTxPsdType : uint8_t
+{
+  WIFI_TX_PSD_DSSS,
+  WIFI_TX_PSD_OFDM,
+  WIFI_TX_PSD_HT_OFDM,
+  WIFI_TX_PSD_HE_OFDM
+};
+
+/// Transmit PSDs normalized to a total power of 1 W
+static std::map<WifiTxPsdTemplateId, Ptr<const SpectrumValue> > g_wifiTxPsdTemplateMap;
+
+Ptr<SpectrumValue>
+WifiSpectrumValueHelper::ScaleTxPsdTemplate (Ptr<const SpectrumValue> psdTemplate, double txPowerW)
+{
+  Ptr<SpectrumValue> c = psdTemplate->Copy ();
+  (*c) *= txPowerW;
+  return c;
+}
+
 Ptr<SpectrumValue>
 WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity (uint32_t centerFrequency, double txPowerW, uint16_t guardBandwidth)
+{
+  NS_LOG_FUNCTION (centerFrequency << txPowerW << +guardBandwidth);
+  WifiTxPsdTemplateId key (WIFI_TX_PSD_DSSS, centerFrequency, 22, guardBandwidth, 0, 0, 0);
+  auto it = g_wifiTxPsdTemplateMap.find (key);
+  if (it == g_wifiTxPsdTemplateMap.end ())
+    {
+      Ptr<SpectrumValue> psd = DoCreateDsssTxPowerSpectralDensity (centerFrequency, 1.0, guardBandwidth);
+      it = g_wifiTxPsdTemplateMap.insert (std::make_pair (key, psd)).first;
+    }
+  return ScaleTxPsdTemplate (it->second, txPowerW);
+}
+
+Ptr<SpectrumValue>
+WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
+                                                           double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
+{
+  NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr << minOuterBandDbr << lowestPointDbr);
+  WifiTxPsdTemplateId key (WIFI_TX_PSD_OFDM, centerFrequency, channelWidth, guardBandwidth, minInnerBandDbr, minOuterBandDbr, lowestPointDbr);
+  auto it = g_wifiTxPsdTemplateMap.find (key);
+  if (it == g_wifiTxPsdTemplateMap.end ())
+    {
+      Ptr<SpectrumValue> psd = DoCreateOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, 1.0, guardBandwidth,
+                                                                   minInnerBandDbr, minOuterBandDbr, lowestPointDbr);
+      it = g_wifiTxPsdTemplateMap.insert (std::make_pair (key, psd)).first;
+    }
+  return ScaleTxPsdTemplate (it->second, txPowerW);
+}
+
+Ptr<SpectrumValue>
+WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
+                                                             double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
+{
+  NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr << minOuterBandDbr << lowestPointDbr);
+  WifiTxPsdTemplateId key (WIFI_TX_PSD_HT_OFDM, centerFrequency, channelWidth, guardBandwidth, minInnerBandDbr, minOuterBandDbr, lowestPointDbr);
+  auto it = g_wifiTxPsdTemplateMap.find (key);
+  if (it == g_wifiTxPsdTemplateMap.end ())
+    {
+      Ptr<SpectrumValue> psd = DoCreateHtOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, 1.0, guardBandwidth,
+                                                                     minInnerBandDbr, minOuterBandDbr, lowestPointDbr);
+      it = g_wifiTxPsdTemplateMap.insert (std::make_pair (key, psd)).first;
+    }
+  return ScaleTxPsdTemplate (it->second, txPowerW);
+}
+
+Ptr<SpectrumValue>
+WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
+                                                             double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
+{
+  NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr << minOuterBandDbr << lowestPointDbr);
+  WifiTxPsdTemplateId key (WIFI_TX_PSD_HE_OFDM, centerFrequency, channelWidth, guardBandwidth, minInnerBandDbr, minOuterBandDbr, lowestPointDbr);
+  auto it = g_wifiTxPsdTemplateMap.find (key);
+  if (it == g_wifiTxPsdTemplateMap.end ())
+    {
+      Ptr<SpectrumValue> psd = DoCreateHeOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, 1.0, guardBandwidth,
+                                                                     minInnerBandDbr, minOuterBandDbr, lowestPointDbr);
+      it = g_wifiTxPsdTemplateMap.insert (std::make_pair (key, psd)).first;
+    }
+  return ScaleTxPsdTemplate (it->second, txPowerW);
+}
+
+// Power allocated to 71 center subbands out of 135 total subbands in the band
+Ptr<SpectrumValue>
+WifiSpectrumValueHelper::DoCreateDsssTxPowerSpectralDensity (uint32_t centerFrequency, double txPowerW, uint16_t guardBandwidth)
 {
   NS_LOG_FUNCTION (centerFrequency << txPowerW << +guardBandwidth);
   uint16_t channelWidth = 22;  // DSSS channels are 22 MHz wide
@@ -157,8 +289,8 @@ WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity (uint32_t centerFreque
 }
 
 Ptr<SpectrumValue>
-WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
-                                                           double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
+WifiSpectrumValueHelper::DoCreateOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
+                                                             double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
 {
   NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr << minOuterBandDbr << lowestPointDbr);
   uint32_t bandBandwidth = 0;
@@ -212,8 +344,8 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (uint32_t centerFreque
 }
 
 Ptr<SpectrumValue>
-WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
-                                                             double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
+WifiSpectrumValueHelper::DoCreateHtOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
+                                                               double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
 {
   NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr << minOuterBandDbr << lowestPointDbr);
   uint32_t bandBandwidth = 312500;
@@ -326,8 +458,8 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (uint32_t centerFreq
 }
 
 Ptr<SpectrumValue>
-WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
-                                                             double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
+WifiSpectrumValueHelper::DoCreateHeOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
+                                                               double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
 {
   NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr << minOuterBandDbr << lowestPointDbr);
   uint32_t bandBandwidth = 78125;
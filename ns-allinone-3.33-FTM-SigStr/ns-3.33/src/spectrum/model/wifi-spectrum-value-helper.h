@@ -39,6 +39,11 @@ typedef std::pair<uint32_t, uint32_t> WifiSpectrumBand;
  *  This class defines all functions to create a spectrum model for
  *  Wi-Fi based on a a spectral model aligned with an OFDM subcarrier
  *  spacing of 312.5 KHz (model also reused for DSSS modulations)
+ *
+ *  Transmit power spectral densities are built once per configuration
+ *  (type, center frequency, channel width, guard bandwidth and mask
+ *  parameters) for a total power of 1 W, and subsequent calls only
+ *  return a copy of that template scaled to the requested power.
  */
 class WifiSpectrumValueHelper
 {
@@ -226,6 +231,76 @@ public:
    * \return the equivalent Watts for the given dBm
    */
   static double DbmToW (double dbm);
+
+
+private:
+  /**
+   * Scale a transmit power spectral density template normalized to 1 W.
+   *
+   * \param psdTemplate the template (in W/Hz for each band) for a total power of 1 W
+   * \param txPowerW total transmit power (W) to allocate
+   * \return a pointer to a newly allocated SpectrumValue holding the scaled template
+   */
+  static Ptr<SpectrumValue> ScaleTxPsdTemplate (Ptr<const SpectrumValue> psdTemplate, double txPowerW);
+
+  /**
+   * Build a transmit power spectral density corresponding to DSSS.
+   * This is the uncached counterpart of CreateDsssTxPowerSpectralDensity.
+   *
+   * \param centerFrequency center frequency (MHz)
+   * \param txPowerW  transmit power (W) to allocate
+   * \param guardBandwidth width of the guard band (MHz)
+   * \returns a pointer to a newly allocated SpectrumValue representing the DSSS Transmit Power Spectral Density in W/Hz
+   */
+  static Ptr<SpectrumValue> DoCreateDsssTxPowerSpectralDensity (uint32_t centerFrequency, double txPowerW, uint16_t guardBandwidth);
+
+  /**
+   * Build a transmit power spectral density corresponding to OFDM (802.11a/g).
+   * This is the uncached counterpart of CreateOfdmTxPowerSpectralDensity.
+   *
+   * \param centerFrequency center frequency (MHz)
+   * \param channelWidth channel width (MHz)
+   * \param txPowerW  transmit power (W) to allocate
+   * \param guardBandwidth width of the guard band (MHz)
+   * \param minInnerBandDbr the minimum relative power in the inner band (in dBr)
+   * \param minOuterbandDbr the minimum relative power in the outer band (in dBr)
+   * \param lowestPointDbr maximum relative power of the outermost subcarriers of the guard band (in dBr)
+   * \return a pointer to a newly allocated SpectrumValue representing the OFDM Transmit Power Spectral Density in W/Hz for each Band
+   */
+  static Ptr<SpectrumValue> DoCreateOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
+                                                                double minInnerBandDbr, double minOuterbandDbr, double lowestPointDbr);
+
+  /**
+   * Build a transmit power spectral density corresponding to OFDM HT (802.11n/ac).
+   * This is the uncached counterpart of CreateHtOfdmTxPowerSpectralDensity.
+   *
+   * \param centerFrequency center frequency (MHz)
+   * \param channelWidth channel width (MHz)
+   * \param txPowerW  transmit power (W) to allocate
+   * \param guardBandwidth width of the guard band (MHz)
+   * \param minInnerBandDbr the minimum relative power in the inner band (in dBr)
+   * \param minOuterbandDbr the minimum relative power in the outer band (in dBr)
+   * \param lowestPointDbr maximum relative power of the outermost subcarriers of the guard band (in dBr)
+   * \return a pointer to a newly allocated SpectrumValue representing the HT OFDM Transmit Power Spectral Density in W/Hz for each Band
+   */
+  static Ptr<SpectrumValue> DoCreateHtOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
+                                                                  double minInnerBandDbr, double minOuterbandDbr, double lowestPointDbr);
+
+  /**
+   * Build a transmit power spectral density corresponding to OFDM HE (802.11ax).
+   * This is the uncached counterpart of CreateHeOfdmTxPowerSpectralDensity.
+   *
+   * \param centerFrequency center frequency (MHz)
+   * \param channelWidth channel width (MHz)
+   * \param txPowerW  transmit power (W) to allocate
+   * \param guardBandwidth width of the guard band (MHz)
+   * \param minInnerBandDbr the minimum relative power in the inner band (in dBr)
+   * \param minOuterbandDbr the minimum relative power in the outer band (in dBr)
+   * \param lowestPointDbr maximum relative power of the outermost subcarriers of the guard band (in dBr)
+   * \return a pointer to a newly allocated SpectrumValue representing the HE OFDM Transmit Power Spectral Density in W/Hz for each Band
+   */
+  static Ptr<SpectrumValue> DoCreateHeOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
+                                                                  double minInnerBandDbr, double minOuterbandDbr, double lowestPointDbr);
 };
 
 /**
@@ -0,0 +1,321 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/boolean.h>
+#include <ns3/net-device.h>
+#include <ns3/node.h>
+#include <ns3/simple-net-device.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/constant-position-mobility-model.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MultiModelSpectrumChannelTest");
+
+/**
+ * \ingroup spectrum-test
+ * \ingroup tests
+ *
+ * Propagation loss model counting how many times it is invoked, with a loss
+ * of 1 dB per meter.
+ */
+class CountingPropagationLossModel : public PropagationLossModel
+{
+public:
+  CountingPropagationLossModel ()
+    : m_nCalls (0)
+  {
+  }
+  uint32_t m_nCalls; ///< number of calls to DoCalcRxPower
+
+private:
+  virtual double DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+  {
+    const_cast<CountingPropagationLossModel *> (this)->m_nCalls++;
+    return txPowerDbm - a->GetDistanceFrom (b);
+  }
+  virtual int64_t DoAssignStreams (int64_t stream)
+  {
+    return 0;
+  }
+};
+
+/**
+ * \ingroup spectrum-test
+ * \ingroup tests
+ *
+ * SpectrumPhy recording the power of the signals it receives.
+ */
+class LinkStateCacheTestPhy : public SpectrumPhy
+{
+public:
+  /**
+   * Constructor
+   * \param model the RX spectrum model
+   */
+  LinkStateCacheTestPhy (Ptr<const SpectrumModel> model)
+    : m_model (model)
+  {
+  }
+  virtual void SetDevice (Ptr<NetDevice> d)
+  {
+    m_device = d;
+  }
+  virtual Ptr<NetDevice> GetDevice () const
+  {
+    return m_device;
+  }
+  virtual void SetMobility (Ptr<MobilityModel> m)
+  {
+    m_mobility = m;
+  }
+  virtual Ptr<MobilityModel> GetMobility ()
+  {
+    return m_mobility;
+  }
+  virtual void SetChannel (Ptr<SpectrumChannel> c)
+  {
+  }
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const
+  {
+    return m_model;
+  }
+  virtual Ptr<AntennaModel> GetRxAntenna ()
+  {
+    return 0;
+  }
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params)
+  {
+    m_rxPowers.push_back (Integral (*params->psd));
+  }
+
+  std::vector<double> m_rxPowers; ///< power of the received signals
+
+private:
+  Ptr<const SpectrumModel> m_model; ///< RX spectrum model
+  Ptr<MobilityModel> m_mobility;    ///< mobility model
+  Ptr<NetDevice> m_device;          ///< net device
+};
+
+/**
+ * \ingroup spectrum-test
+ * \ingroup tests
+ *
+ * Check that the link state cache of the MultiModelSpectrumChannel skips the
+ * propagation loss computation between static nodes, and that it is
+ * invalidated when a node moves.
+ */
+class MultiModelSpectrumChannelLinkStateCacheTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param cache whether the link state cache is enabled
+   */
+  MultiModelSpectrumChannelLinkStateCacheTestCase (bool cache);
+  virtual ~MultiModelSpectrumChannelLinkStateCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Transmit a signal from the given PHY
+   * \param phy the transmitter
+   */
+  void Send (Ptr<LinkStateCacheTestPhy> phy);
+
+  bool m_cache; ///< whether the link state cache is enabled
+  Ptr<MultiModelSpectrumChannel> m_channel; ///< the channel
+  Ptr<const SpectrumModel> m_model;         ///< the spectrum model
+};
+
+MultiModelSpectrumChannelLinkStateCacheTestCase::MultiModelSpectrumChannelLinkStateCacheTestCase (bool cache)
+  : TestCase (std::string ("Link state cache ") + (cache ? "enabled" : "disabled")),
+    m_cache (cache)
+{
+}
+
+MultiModelSpectrumChannelLinkStateCacheTestCase::~MultiModelSpectrumChannelLinkStateCacheTestCase ()
+{
+}
+
+void
+MultiModelSpectrumChannelLinkStateCacheTestCase::Send (Ptr<LinkStateCacheTestPhy> phy)
+{
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->txPhy = phy;
+  params->duration = MicroSeconds (1);
+  params->psd = Create<SpectrumValue> (m_model);
+  (*params->psd) = 1.0;
+  m_channel->StartTx (params);
+}
+
+void
+MultiModelSpectrumChannelLinkStateCacheTestCase::DoRun (void)
+{
+  std::vector<double> freqs {1e9, 1e9 + 1};
+  m_model = Create<SpectrumModel> (freqs);
+  Ptr<CountingPropagationLossModel> loss = CreateObject<CountingPropagationLossModel> ();
+  m_channel = CreateObject<MultiModelSpectrumChannel> ();
+  m_channel->SetAttribute ("LinkStateCache", BooleanValue (m_cache));
+  m_channel->AddPropagationLossModel (loss);
+
+  Ptr<LinkStateCacheTestPhy> tx = Create<LinkStateCacheTestPhy> (m_model);
+  Ptr<LinkStateCacheTestPhy> rx = Create<LinkStateCacheTestPhy> (m_model);
+  Ptr<ConstantPositionMobilityModel> txMobility = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<ConstantPositionMobilityModel> rxMobility = CreateObject<ConstantPositionMobilityModel> ();
+  txMobility->SetPosition (Vector (0, 0, 0));
+  rxMobility->SetPosition (Vector (10, 0, 0));
+  tx->SetMobility (txMobility);
+  rx->SetMobility (rxMobility);
+  m_channel->AddRx (tx);
+  m_channel->AddRx (rx);
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Simulator::Schedule (Seconds (i), &MultiModelSpectrumChannelLinkStateCacheTestCase::Send, this, tx);
+    }
+  Simulator::Schedule (Seconds (3), &ConstantPositionMobilityModel::SetPosition, rxMobility, Vector (20, 0, 0));
+  Simulator::Schedule (Seconds (4), &MultiModelSpectrumChannelLinkStateCacheTestCase::Send, this, tx);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (loss->m_nCalls, (m_cache ? 2 : 4), "Unexpected number of propagation loss computations");
+  NS_TEST_ASSERT_MSG_EQ (rx->m_rxPowers.size (), 4, "Unexpected number of received signals");
+  NS_TEST_ASSERT_MSG_EQ (tx->m_rxPowers.size (), 0, "The transmitter should not receive its own signals");
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (rx->m_rxPowers[i], 0.2, 1e-12, "Unexpected power before the receiver moved");
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (rx->m_rxPowers[3], 0.02, 1e-12, "Unexpected power after the receiver moved");
+
+  m_channel->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup spectrum-test
+ * \ingroup tests
+ *
+ * Check that a partitioned MultiModelSpectrumChannel only carries signals
+ * between the nodes of the local logical process. The remote nodes use a
+ * spectrum model orthogonal to the one of the local nodes, since a remote
+ * node sharing spectrum with a local transmitter is a fatal error.
+ */
+class MultiModelSpectrumChannelPartitionTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param partitioned whether the channel is partitioned
+   */
+  MultiModelSpectrumChannelPartitionTestCase (bool partitioned);
+  virtual ~MultiModelSpectrumChannelPartitionTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  bool m_partitioned; ///< whether the channel is partitioned
+};
+
+MultiModelSpectrumChannelPartitionTestCase::MultiModelSpectrumChannelPartitionTestCase (bool partitioned)
+  : TestCase (std::string ("Partitioned channel ") + (partitioned ? "enabled" : "disabled")),
+    m_partitioned (partitioned)
+{
+}
+
+MultiModelSpectrumChannelPartitionTestCase::~MultiModelSpectrumChannelPartitionTestCase ()
+{
+}
+
+void
+MultiModelSpectrumChannelPartitionTestCase::DoRun (void)
+{
+  std::vector<double> localFreqs {1e9, 1e9 + 1};
+  std::vector<double> remoteFreqs {2e9, 2e9 + 1};
+  Ptr<const SpectrumModel> localModel = Create<SpectrumModel> (localFreqs);
+  Ptr<const SpectrumModel> remoteModel = Create<SpectrumModel> (remoteFreqs);
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  channel->SetAttribute ("Partitioned", BooleanValue (m_partitioned));
+  channel->AddPropagationLossModel (CreateObject<CountingPropagationLossModel> ());
+
+  //one PHY on a node of the local logical process and two on remote nodes,
+  //plus a local PHY without device which is always considered local
+  std::vector<Ptr<LinkStateCacheTestPhy> > phys;
+  for (uint32_t systemId : {0, 1, 1})
+    {
+      Ptr<LinkStateCacheTestPhy> phy = Create<LinkStateCacheTestPhy> (systemId == 0 ? localModel : remoteModel);
+      Ptr<Node> node = CreateObject<Node> (systemId);
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      node->AddDevice (device);
+      phy->SetDevice (device);
+      phys.push_back (phy);
+    }
+  phys.push_back (Create<LinkStateCacheTestPhy> (localModel));
+  for (auto phy : phys)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      phy->SetMobility (mobility);
+      channel->AddRx (phy);
+    }
+
+  for (auto phy : phys)
+    {
+      Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+      params->txPhy = phy;
+      params->duration = MicroSeconds (1);
+      params->psd = Create<SpectrumValue> (phy->GetRxSpectrumModel ());
+      (*params->psd) = 1.0;
+      Simulator::ScheduleNow (&MultiModelSpectrumChannel::StartTx, channel, params);
+    }
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (phys[0]->m_rxPowers.size (), 1, "Unexpected number of signals received by the local node");
+  NS_TEST_ASSERT_MSG_EQ (phys[1]->m_rxPowers.size (), (m_partitioned ? 0 : 1), "Unexpected number of signals received by a remote node");
+  NS_TEST_ASSERT_MSG_EQ (phys[2]->m_rxPowers.size (), (m_partitioned ? 0 : 1), "Unexpected number of signals received by a remote node");
+  NS_TEST_ASSERT_MSG_EQ (phys[3]->m_rxPowers.size (), 1, "Unexpected number of signals received by the PHY without device");
+
+  channel->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup spectrum-test
+ * \ingroup tests
+ *
+ * MultiModelSpectrumChannel test suite
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+public:
+  MultiModelSpectrumChannelTestSuite ();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite ()
+  : TestSuite ("multi-model-spectrum-channel", UNIT)
+{
+  AddTestCase (new MultiModelSpectrumChannelLinkStateCacheTestCase (false), TestCase::QUICK);
+  AddTestCase (new MultiModelSpectrumChannelLinkStateCacheTestCase (true), TestCase::QUICK);
+  AddTestCase (new MultiModelSpectrumChannelPartitionTestCase (false), TestCase::QUICK);
+  AddTestCase (new MultiModelSpectrumChannelPartitionTestCase (true), TestCase::QUICK);
+}
+
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite; ///< the test suite
@@ -77,6 +77,70 @@ SpectrumValueTestCase::DoRun (void)
 
 
 
+/**
+ * Check that integrating over a range of bands gives the same result as
+ * integrating the product of the value with a filter selecting these bands.
+ */
+class SpectrumValueIntegralTestCase : public TestCase
+{
+public:
+  SpectrumValueIntegralTestCase ();
+  virtual ~SpectrumValueIntegralTestCase ();
+  virtual void DoRun (void);
+};
+
+SpectrumValueIntegralTestCase::SpectrumValueIntegralTestCase ()
+  : TestCase ("Integral over a range of bands")
+{
+}
+
+SpectrumValueIntegralTestCase::~SpectrumValueIntegralTestCase ()
+{
+}
+
+void
+SpectrumValueIntegralTestCase::DoRun (void)
+{
+  Bands bands;
+  for (int i = 0; i < 7; i++)
+    {
+      BandInfo bi;
+      bi.fl = i * i;
+      bi.fh = (i + 1) * (i + 1);
+      bi.fc = (bi.fl + bi.fh) / 2;
+      bands.push_back (bi);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (bands);
+  SpectrumValue v (sm);
+  for (size_t i = 0; i < sm->GetNumBands (); i++)
+    {
+      v[i] = 0.25 + std::sin (static_cast<double> (i));
+    }
+
+  double whole = 0;
+  for (size_t i = 0; i < sm->GetNumBands (); i++)
+    {
+      whole += v[i] * (bands[i].fh - bands[i].fl);
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (Integral (v), whole, TOLERANCE, "Integral over all bands");
+
+  for (size_t start = 0; start < sm->GetNumBands (); start++)
+    {
+      for (size_t stop = start; stop < sm->GetNumBands (); stop++)
+        {
+          SpectrumValue filter (sm);
+          for (size_t i = start; i <= stop; i++)
+            {
+              filter[i] = 1;
+            }
+          NS_TEST_ASSERT_MSG_EQ (Integral (v, start, stop), Integral (filter * v),
+                                 "Integral over bands " << start << " to " << stop);
+        }
+    }
+}
+
+
+
 
 
 
@@ -241,6 +305,16 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   tv1rs3 = v1 >> 3;
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
+  SpectrumValue tv11 (f), tv12 (f);
+  tv11 = v3;
+  tv11.MultiplyAdd (v1, v2);
+  tv12 = v1;
+  tv12.MultiplyAdd (v1, doubleValue);
+  AddTestCase (new SpectrumValueTestCase (tv11, v3 + v5, "tv11 = v3 + v1 * v2"), TestCase::QUICK);
+  AddTestCase (new SpectrumValueTestCase (tv12, v1 + v9, "tv12 = v1 + v1 * doubleValue"), TestCase::QUICK);
+
+  AddTestCase (new SpectrumValueIntegralTestCase, TestCase::QUICK);
+
 
 }
 
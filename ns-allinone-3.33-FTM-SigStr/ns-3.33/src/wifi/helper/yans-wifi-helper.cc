@@ -164,4 +164,9 @@ YansWifiPhyHelper::Create (Ptr<Node> node, Ptr<NetDevice> device) const
   return phy;
 }
 
+AbstractWifiPhyHelper::AbstractWifiPhyHelper ()
+{
+  m_phy.SetTypeId ("ns3::AbstractWifiPhy");
+}
+
 } //namespace ns3
@@ -191,6 +191,23 @@ private:
   Ptr<YansWifiChannel> m_channel; ///< YANS wifi channel
 };
 
+/**
+ * \brief Make it easy to create and manage PHY objects for the abstract PHY model.
+ *
+ * The AbstractWifiPhy is connected to a YansWifiChannel like the YansWifiPhy,
+ * so this helper only differs from the YansWifiPhyHelper by the type of the
+ * PHY objects it creates. It can be passed to WifiHelper::Install in place of
+ * a YansWifiPhyHelper.
+ */
+class AbstractWifiPhyHelper : public YansWifiPhyHelper
+{
+public:
+  /**
+   * Create a PHY helper.
+   */
+  AbstractWifiPhyHelper ();
+};
+
 } //namespace ns3
 
 #endif /* YANS_WIFI_HELPER_H */
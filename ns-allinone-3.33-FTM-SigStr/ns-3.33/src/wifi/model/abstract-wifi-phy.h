@@ -0,0 +1,55 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ABSTRACT_WIFI_PHY_H
+#define ABSTRACT_WIFI_PHY_H
+
+#include "yans-wifi-phy.h"
+
+namespace ns3 {
+
+/**
+ * \brief Lightweight 802.11 PHY layer model for large deployments
+ * \ingroup wifi
+ *
+ * This PHY is attached to a YansWifiChannel and keeps the WifiPhy API,
+ * but it abstracts the reception of a PPDU: the noise plus interference
+ * power is averaged over the PPDU, and the PHY header and each MPDU are
+ * evaluated with a single lookup in the error rate model rather than one
+ * lookup per chunk of constant interference. Combined with the
+ * TableBasedErrorRateModel (the default of the AbstractWifiPhyHelper),
+ * every reception decision is a lookup in precomputed SINR to PER tables.
+ *
+ * The abstraction is accurate as long as the interference is roughly
+ * constant over a PPDU, which is the common case in dense deployments
+ * where the simulation cost is dominated by the interference bookkeeping.
+ */
+class AbstractWifiPhy : public YansWifiPhy
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  AbstractWifiPhy ();
+  virtual ~AbstractWifiPhy ();
+};
+
+} //namespace ns3
+
+#endif /* ABSTRACT_WIFI_PHY_H */
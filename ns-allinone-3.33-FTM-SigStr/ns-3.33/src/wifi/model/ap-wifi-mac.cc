@@ -26,7 +26,11 @@
 #include "ns3/pointer.h"
 #include "ns3/string.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/boolean.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
 #include "ap-wifi-mac.h"
+#include "sta-wifi-mac.h"
 #include "mac-low.h"
 #include "mac-tx-middle.h"
 #include "mac-rx-middle.h"
@@ -83,12 +87,28 @@ ApWifiMac::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&ApWifiMac::m_enableNonErpProtection),
                    MakeBooleanChecker ())
+    .AddAttribute ("EnableBeaconTemplate",
+                   "Whether the beacon body is cached and only rebuilt when the state of the BSS "
+                   "it advertises changes, instead of being rebuilt for every beacon.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&ApWifiMac::m_enableBeaconTemplate),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BeaconAbstraction",
+                   "If true, beacons are not transmitted over the channel but handed directly "
+                   "to the MAC of the associated stations. Stations must use active probing to "
+                   "associate. This attribute is ignored if the AP supports PCF.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ApWifiMac::m_beaconAbstraction),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 ApWifiMac::ApWifiMac ()
-  : m_enableBeaconGeneration (false)
+  : m_enableBeaconGeneration (false),
+    m_beaconTemplateValid (false),
+    m_beaconTemplateChannel (0),
+    m_beaconTemplateChannelWidth (0)
 {
   NS_LOG_FUNCTION (this);
   m_beaconTxop = CreateObject<Txop> ();
@@ -125,6 +145,7 @@ ApWifiMac::DoDispose ()
   m_enableBeaconGeneration = false;
   m_beaconEvent.Cancel ();
   m_cfpEvent.Cancel ();
+  m_beaconReceivers.clear ();
   RegularWifiMac::DoDispose ();
 }
 
@@ -201,6 +222,7 @@ ApWifiMac::SetBeaconInterval (Time interval)
       NS_FATAL_ERROR ("beacon interval should be smaller then or equal to 65535 * 1024us (802.11 time unit)");
     }
   m_low->SetBeaconInterval (interval);
+  InvalidateBeaconTemplate ();
 }
 
 void
@@ -212,6 +234,7 @@ ApWifiMac::SetCfpMaxDuration (Time duration)
       NS_LOG_WARN ("CFP max duration should be multiple of 1024us (802.11 time unit)");
     }
   m_low->SetCfpMaxDuration (duration);
+  InvalidateBeaconTemplate ();
 }
 
 int64_t
@@ -814,6 +837,7 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success, bool isReassoc)
         {
           aid = GetNextAssociationId ();
           m_staList.insert (std::make_pair (aid, to));
+          InvalidateBeaconTemplate ();
         }
       assoc.SetAssociationId (aid);
     }
@@ -858,24 +882,29 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success, bool isReassoc)
 }
 
 void
-ApWifiMac::SendOneBeacon (void)
+ApWifiMac::InvalidateBeaconTemplate (void)
 {
   NS_LOG_FUNCTION (this);
-  WifiMacHeader hdr;
-  hdr.SetType (WIFI_MAC_MGT_BEACON);
-  hdr.SetAddr1 (Mac48Address::GetBroadcast ());
-  hdr.SetAddr2 (GetAddress ());
-  hdr.SetAddr3 (GetAddress ());
-  hdr.SetDsNotFrom ();
-  hdr.SetDsNotTo ();
-  Ptr<Packet> packet = Create<Packet> ();
+  m_beaconTemplateValid = false;
+}
+
+const MgtBeaconHeader &
+ApWifiMac::GetBeaconTemplate (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_enableBeaconTemplate && m_beaconTemplateValid
+      && m_beaconTemplateSsid.IsEqual (GetSsid ())
+      && m_beaconTemplateChannel == m_phy->GetChannelNumber ()
+      && m_beaconTemplateChannelWidth == m_phy->GetChannelWidth ())
+    {
+      return m_beaconTemplate;
+    }
+  NS_LOG_DEBUG ("Building beacon template");
   MgtBeaconHeader beacon;
   beacon.SetSsid (GetSsid ());
   beacon.SetSupportedRates (GetSupportedRates ());
   beacon.SetBeaconIntervalUs (GetBeaconInterval ().GetMicroSeconds ());
   beacon.SetCapabilities (GetCapabilities ());
-  m_stationManager->SetShortPreambleEnabled (GetShortPreambleEnabled ());
-  m_stationManager->SetShortSlotTimeEnabled (GetShortSlotTimeEnabled ());
   if (GetPcfSupported ())
     {
       beacon.SetCfParameterSet (GetCfParameterSet ());
@@ -908,10 +937,39 @@ ApWifiMac::SendOneBeacon (void)
       beacon.SetHeCapabilities (GetHeCapabilities ());
       beacon.SetHeOperation (GetHeOperation ());
     }
-  packet->AddHeader (beacon);
+  m_beaconTemplate = beacon;
+  m_beaconTemplateValid = true;
+  m_beaconTemplateSsid = GetSsid ();
+  m_beaconTemplateChannel = m_phy->GetChannelNumber ();
+  m_beaconTemplateChannelWidth = m_phy->GetChannelWidth ();
+  return m_beaconTemplate;
+}
+
+void
+ApWifiMac::SendOneBeacon (void)
+{
+  NS_LOG_FUNCTION (this);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_MGT_BEACON);
+  hdr.SetAddr1 (Mac48Address::GetBroadcast ());
+  hdr.SetAddr2 (GetAddress ());
+  hdr.SetAddr3 (GetAddress ());
+  hdr.SetDsNotFrom ();
+  hdr.SetDsNotTo ();
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (GetBeaconTemplate ());
+  m_stationManager->SetShortPreambleEnabled (GetShortPreambleEnabled ());
+  m_stationManager->SetShortSlotTimeEnabled (GetShortSlotTimeEnabled ());
 
-  //The beacon has it's own special queue, so we load it in there
-  m_beaconTxop->Queue (packet, hdr);
+  if (m_beaconAbstraction && !GetPcfSupported ())
+    {
+      DeliverAbstractBeacon (packet, hdr);
+    }
+  else
+    {
+      //The beacon has it's own special queue, so we load it in there
+      m_beaconTxop->Queue (packet, hdr);
+    }
   m_beaconEvent = Simulator::Schedule (GetBeaconInterval (), &ApWifiMac::SendOneBeacon, this);
 
   //If a STA that does not support Short Slot Time associates,
@@ -965,6 +1023,58 @@ ApWifiMac::SendCfEnd (void)
   m_txop->SendCfFrame (WIFI_MAC_CTL_END, Mac48Address::GetBroadcast ());
 }
 
+void
+ApWifiMac::DeliverAbstractBeacon (Ptr<const Packet> beacon, const WifiMacHeader &hdr)
+{
+  NS_LOG_FUNCTION (this << beacon);
+  for (std::map<uint16_t, Mac48Address>::const_iterator i = m_staList.begin (); i != m_staList.end (); i++)
+    {
+      if (!m_stationManager->IsAssociated (i->second))
+        {
+          continue;
+        }
+      Ptr<StaWifiMac> sta = GetAbstractBeaconReceiver (i->second);
+      if (sta == 0)
+        {
+          NS_LOG_DEBUG ("No local MAC found for station " << i->second);
+          continue;
+        }
+      Ptr<WifiMacQueueItem> mpdu = Create<WifiMacQueueItem> (beacon->Copy (), hdr);
+      Ptr<NetDevice> device = sta->GetDevice ();
+      uint32_t context = device != 0 ? device->GetNode ()->GetId () : Simulator::GetContext ();
+      Simulator::ScheduleWithContext (context, Seconds (0), &StaWifiMac::ReceiveAbstractBeacon, sta, mpdu);
+    }
+}
+
+Ptr<StaWifiMac>
+ApWifiMac::GetAbstractBeaconReceiver (Mac48Address address)
+{
+  NS_LOG_FUNCTION (this << address);
+  std::map<Mac48Address, Ptr<StaWifiMac> >::const_iterator it = m_beaconReceivers.find (address);
+  if (it != m_beaconReceivers.end ())
+    {
+      return it->second;
+    }
+  for (NodeList::Iterator n = NodeList::Begin (); n != NodeList::End (); n++)
+    {
+      for (uint32_t d = 0; d < (*n)->GetNDevices (); d++)
+        {
+          Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice> ((*n)->GetDevice (d));
+          if (device == 0 || device->GetMac () == 0 || device->GetMac ()->GetAddress () != address)
+            {
+              continue;
+            }
+          Ptr<StaWifiMac> sta = DynamicCast<StaWifiMac> (device->GetMac ());
+          if (sta != 0)
+            {
+              m_beaconReceivers[address] = sta;
+              return sta;
+            }
+        }
+    }
+  return 0;
+}
+
 void
 ApWifiMac::TxOk (const WifiMacHeader &hdr)
 {
@@ -1296,6 +1406,7 @@ ApWifiMac::Receive (Ptr<WifiMacQueueItem> mpdu)
                       m_nonErpStations.push_back (hdr->GetAddr2 ());
                       m_nonErpStations.unique ();
                     }
+                  InvalidateBeaconTemplate ();
                   NS_LOG_DEBUG ("Send association response with success status");
                   SendAssocResp (hdr->GetAddr2 (), true, false);
                 }
@@ -1484,6 +1595,7 @@ ApWifiMac::Receive (Ptr<WifiMacQueueItem> mpdu)
                       m_nonErpStations.push_back (hdr->GetAddr2 ());
                       m_nonErpStations.unique ();
                     }
+                  InvalidateBeaconTemplate ();
                   NS_LOG_DEBUG ("Send reassociation response with success status");
                   SendAssocResp (hdr->GetAddr2 (), true, true);
                 }
@@ -1525,6 +1637,8 @@ ApWifiMac::Receive (Ptr<WifiMacQueueItem> mpdu)
                       break;
                     }
                 }
+              m_beaconReceivers.erase (from);
+              InvalidateBeaconTemplate ();
               return;
             }
         }
@@ -24,6 +24,7 @@
 #define AP_WIFI_MAC_H
 
 #include "infrastructure-wifi-mac.h"
+#include "mgt-headers.h"
 
 namespace ns3 {
 
@@ -36,6 +37,7 @@ class HtOperation;
 class VhtOperation;
 class HeOperation;
 class CfParameterSet;
+class StaWifiMac;
 
 /**
  * \brief Wi-Fi AP state machine
@@ -43,6 +45,18 @@ class CfParameterSet;
  *
  * Handle association, dis-association and authentication,
  * of STAs within an infrastructure BSS.
+ *
+ * The beacon body is kept in a template that is only rebuilt
+ * when the BSS state it depends on changes (set of associated stations,
+ * beacon interval, CFP duration, SSID or operating channel). Changes made
+ * at runtime to attributes of other objects that are advertised in the
+ * beacon (e.g., EDCA parameters or HE configuration) must be followed by
+ * a call to InvalidateBeaconTemplate.
+ *
+ * If the BeaconAbstraction attribute is set, beacons are not transmitted
+ * over the channel: a copy is handed directly to the MAC of every associated
+ * station instead. Beacons then neither occupy the medium nor reach stations
+ * that are not associated yet, which must therefore use active probing.
  */
 class ApWifiMac : public InfrastructureWifiMac
 {
@@ -109,6 +123,11 @@ public:
    * \returns the VHT operational channel width (in MHz).
    */
   uint16_t GetVhtOperationalChannelWidth (void) const;
+  /**
+   * Discard the cached beacon template, so that the next beacon is built
+   * from the current state of the AP.
+   */
+  void InvalidateBeaconTemplate (void);
 
   /**
    * Assign a fixed random variable stream number to the random variables
@@ -191,6 +210,28 @@ private:
    * Forward a beacon packet to the beacon special DCF.
    */
   void SendOneBeacon (void);
+  /**
+   * Return the beacon body, rebuilding the cached template if it is no
+   * longer valid.
+   *
+   * \return the beacon body
+   */
+  const MgtBeaconHeader & GetBeaconTemplate (void);
+  /**
+   * Hand a beacon directly to the MAC of every associated station.
+   *
+   * \param beacon the packet holding the beacon body
+   * \param hdr the MAC header of the beacon
+   */
+  void DeliverAbstractBeacon (Ptr<const Packet> beacon, const WifiMacHeader &hdr);
+  /**
+   * Return the MAC of the station with the given address, looking it up
+   * among all the nodes the first time.
+   *
+   * \param address the MAC address of the station
+   * \return the MAC of the station, or 0 if it cannot be found
+   */
+  Ptr<StaWifiMac> GetAbstractBeaconReceiver (Mac48Address address);
   /**
    * Determine what is the next PCF frame and trigger its transmission.
    */
@@ -298,6 +339,14 @@ private:
   std::list<Mac48Address> m_cfPollingList;   //!< List of all PCF stations currently associated to the AP
   std::list<Mac48Address>::iterator m_itCfPollingList; //!< Iterator to the list of all PCF stations currently associated to the AP
   bool m_enableNonErpProtection;             //!< Flag whether protection mechanism is used or not when non-ERP STAs are present within the BSS
+  bool m_enableBeaconTemplate;               //!< Flag whether the beacon body is cached between beacons
+  bool m_beaconAbstraction;                  //!< Flag whether beacons are delivered to associated STAs without going through the PHY
+  MgtBeaconHeader m_beaconTemplate;          //!< Cached beacon body
+  bool m_beaconTemplateValid;                //!< Flag whether the cached beacon body is up to date
+  Ssid m_beaconTemplateSsid;                 //!< SSID advertised in the cached beacon body
+  uint8_t m_beaconTemplateChannel;           //!< Channel number advertised in the cached beacon body
+  uint16_t m_beaconTemplateChannelWidth;     //!< Channel width (MHz) advertised in the cached beacon body
+  std::map<Mac48Address, Ptr<StaWifiMac> > m_beaconReceivers; //!< MACs of the associated STAs receiving abstracted beacons
 };
 
 } //namespace ns3
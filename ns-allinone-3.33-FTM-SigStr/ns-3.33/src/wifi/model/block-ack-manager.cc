@@ -78,6 +78,19 @@ BlockAckManager::~BlockAckManager ()
   m_retryPackets = 0;
 }
 
+std::size_t
+BlockAckManager::AgreementKeyHash::operator() (const std::pair<Mac48Address, uint8_t> &key) const
+{
+  uint8_t buffer[6];
+  key.first.CopyTo (buffer);
+  uint64_t value = key.second;
+  for (uint8_t i = 0; i < 6; i++)
+    {
+      value = (value << 8) | buffer[i];
+    }
+  return std::hash<uint64_t> () (value);
+}
+
 bool
 BlockAckManager::ExistsAgreement (Mac48Address recipient, uint8_t tid) const
 {
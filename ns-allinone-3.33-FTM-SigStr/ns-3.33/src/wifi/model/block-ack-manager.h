@@ -22,6 +22,7 @@
 #define BLOCK_ACK_MANAGER_H
 
 #include <map>
+#include <unordered_map>
 #include "ns3/nstime.h"
 #include "ns3/traced-callback.h"
 #include "wifi-mac-header.h"
@@ -445,20 +446,30 @@ private:
    */
   typedef std::list<Ptr<WifiMacQueueItem>>::const_iterator PacketQueueCI;
   /**
-   * typedef for a map between MAC address and block ack agreement.
+   * Hash function for the (recipient, TID) pairs identifying the agreements.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> > Agreements;
+  struct AgreementKeyHash
+  {
+    /**
+     * \param key the (recipient, TID) pair
+     * \return the hash of the given pair
+     */
+    std::size_t operator() (const std::pair<Mac48Address, uint8_t> &key) const;
+  };
+  /**
+   * typedef for a hash table between (MAC address, TID) and block ack agreement.
+   */
+  typedef std::unordered_map<std::pair<Mac48Address, uint8_t>,
+                             std::pair<OriginatorBlockAckAgreement, PacketQueue>,
+                             AgreementKeyHash> Agreements;
   /**
    * typedef for an iterator for Agreements.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> >::iterator AgreementsI;
+  typedef Agreements::iterator AgreementsI;
   /**
    * typedef for a const iterator for Agreements.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> >::const_iterator AgreementsCI;
+  typedef Agreements::const_iterator AgreementsCI;
 
   /**
    * \param mpdu the packet to insert in the retransmission queue
@@ -18,6 +18,7 @@
  * Author: Stefano Avallone <stavallo@unina.it>
  */
 
+#include <algorithm>
 #include "ns3/log.h"
 #include "block-ack-window.h"
 #include "wifi-utils.h"
@@ -26,8 +27,34 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("BlockAckWindow");
 
+BlockAckWindow::Reference::Reference (uint64_t &word, uint64_t mask)
+  : m_word (word),
+    m_mask (mask)
+{
+}
+
+BlockAckWindow::Reference::operator bool () const
+{
+  return (m_word & m_mask) != 0;
+}
+
+BlockAckWindow::Reference&
+BlockAckWindow::Reference::operator= (bool value)
+{
+  if (value)
+    {
+      m_word |= m_mask;
+    }
+  else
+    {
+      m_word &= ~m_mask;
+    }
+  return *this;
+}
+
 BlockAckWindow::BlockAckWindow ()
   : m_winStart (0),
+    m_winSize (0),
     m_head (0)
 {
 }
@@ -37,14 +64,15 @@ BlockAckWindow::Init (uint16_t winStart, uint16_t winSize)
 {
   NS_LOG_FUNCTION (this << winStart << winSize);
   m_winStart = winStart;
-  m_window.assign (winSize, false);
+  m_winSize = winSize;
+  m_window.assign ((winSize + 63) / 64, 0);
   m_head = 0;
 }
 
 void
 BlockAckWindow::Reset (uint16_t winStart)
 {
-  Init (winStart, m_window.size ());
+  Init (winStart, m_winSize);
 }
 
 uint16_t
@@ -56,21 +84,47 @@ BlockAckWindow::GetWinStart (void) const
 uint16_t
 BlockAckWindow::GetWinEnd (void) const
 {
-  return (m_winStart + m_window.size () - 1) % SEQNO_SPACE_SIZE;
+  return (m_winStart + m_winSize - 1) % SEQNO_SPACE_SIZE;
 }
 
 std::size_t
 BlockAckWindow::GetWinSize (void) const
 {
-  return m_window.size ();
+  return m_winSize;
 }
 
-std::vector<bool>::reference
+BlockAckWindow::Reference
 BlockAckWindow::At (std::size_t distance)
 {
-  NS_ASSERT (distance < m_window.size ());
+  NS_ASSERT (distance < m_winSize);
+
+  std::size_t pos = (m_head + distance) % m_winSize;
+  return Reference (m_window[pos / 64], uint64_t (1) << (pos % 64));
+}
+
+bool
+BlockAckWindow::At (std::size_t distance) const
+{
+  NS_ASSERT (distance < m_winSize);
+
+  std::size_t pos = (m_head + distance) % m_winSize;
+  return (m_window[pos / 64] >> (pos % 64)) & 1;
+}
+
+void
+BlockAckWindow::Clear (std::size_t pos, std::size_t count)
+{
+  NS_ASSERT (pos + count <= m_winSize);
 
-  return m_window.at ((m_head + distance) % m_window.size ());
+  while (count > 0)
+    {
+      std::size_t bit = pos % 64;
+      std::size_t n = std::min<std::size_t> (64 - bit, count);
+      uint64_t mask = (n == 64 ? ~uint64_t (0) : (uint64_t (1) << n) - 1) << bit;
+      m_window[pos / 64] &= ~mask;
+      pos += n;
+      count -= n;
+    }
 }
 
 void
@@ -78,18 +132,50 @@ BlockAckWindow::Advance (std::size_t count)
 {
   NS_LOG_FUNCTION (this << count);
 
-  if (count >= m_window.size ())
+  if (count >= m_winSize)
     {
       Reset ((m_winStart + count) % SEQNO_SPACE_SIZE);
       return;
     }
 
-  for (std::size_t i = 0; i < count; i++)
+  // the elements to clear may wrap around the end of the bitmap
+  std::size_t beforeWrap = std::min (count, m_winSize - m_head);
+  Clear (m_head, beforeWrap);
+  Clear (0, count - beforeWrap);
+  m_head = (m_head + count) % m_winSize;
+  m_winStart = (m_winStart + count) % SEQNO_SPACE_SIZE;
+}
+
+std::size_t
+BlockAckWindow::GetNConsecutiveSet (void) const
+{
+  std::size_t count = 0;
+  std::size_t pos = m_head;
+
+  while (count < m_winSize)
     {
-      m_window[m_head] = false;
-      m_head = (m_head + 1) % m_window.size ();
+      // examine the elements up to the end of the current word, the end of
+      // the bitmap or the end of the window, whichever comes first
+      std::size_t bit = pos % 64;
+      std::size_t n = std::min<std::size_t> (64 - bit, m_winSize - pos);
+      n = std::min (n, m_winSize - count);
+      uint64_t bits = m_window[pos / 64] >> bit;
+      uint64_t mask = (n == 64 ? ~uint64_t (0) : (uint64_t (1) << n) - 1);
+
+      if ((bits & mask) != mask)
+        {
+          // the first unset element is in this word
+          while (bits & 1)
+            {
+              bits >>= 1;
+              count++;
+            }
+          return count;
+        }
+      count += n;
+      pos = (pos + n) % m_winSize;
     }
-  m_winStart = (m_winStart + count) % SEQNO_SPACE_SIZE;
+  return count;
 }
 
 } //namespace ns3
@@ -22,6 +22,7 @@
 #define BLOCK_ACK_WINDOW_H
 
 #include <vector>
+#include <cstdint>
 
 namespace ns3 {
 
@@ -34,10 +35,12 @@ namespace ns3 {
  * a given number of positions. This class can be used to implement both
  * an originator's window and a recipient's window.
  *
- * The window is implemented as a vector of bool and managed as a circular
- * queue. The window is moved forward by advancing the head of the queue and
- * clearing the elements that become part of the tail of the queue. Hence,
- * no element is required to be shifted when the window moves forward.
+ * The window is implemented as a bitmap stored in 64-bit words and managed
+ * as a circular queue. The window is moved forward by advancing the head of
+ * the queue and clearing the elements that become part of the tail of the
+ * queue. Hence, no element is required to be shifted when the window moves
+ * forward. Clearing the elements and searching for the first unset element
+ * are performed one word at a time.
  *
  * Example:
  *
@@ -56,6 +59,39 @@ namespace ns3 {
 class BlockAckWindow
 {
 public:
+  /**
+   * \brief Reference to an element of the window
+   *
+   * Proxy object, similar to std::vector<bool>::reference, allowing to read
+   * and to modify a single bit of the window.
+   */
+  class Reference
+  {
+  public:
+    /**
+     * Constructor
+     *
+     * \param word the word containing the element
+     * \param mask the mask selecting the element within the word
+     */
+    Reference (uint64_t &word, uint64_t mask);
+    /**
+     * \return the value of the element
+     */
+    operator bool () const;
+    /**
+     * Set the value of the element
+     *
+     * \param value the new value of the element
+     * \return this reference
+     */
+    Reference& operator= (bool value);
+
+  private:
+    uint64_t &m_word;  ///< the word containing the element
+    uint64_t m_mask;   ///< the mask selecting the element within the word
+  };
+
   /**
    * Constructor
    */
@@ -101,18 +137,46 @@ public:
    * \return a reference to the element in the window having the given distance
    *         from the current winStart
    */
-  std::vector<bool>::reference At (std::size_t distance);
+  Reference At (std::size_t distance);
+  /**
+   * Get the value of the element in the window having the given distance from
+   * the current winStart. Note that the given distance must be less than the
+   * window size.
+   *
+   * \param distance the given distance
+   * \return the value of the element in the window having the given distance
+   *         from the current winStart
+   */
+  bool At (std::size_t distance) const;
   /**
    * Advance the current winStart by the given number of positions.
    *
    * \param count the number of positions the current winStart must be advanced by
    */
   void Advance (std::size_t count);
+  /**
+   * Get the number of consecutive elements that are set, starting from the
+   * current winStart.
+   *
+   * \return the number of consecutive elements that are set, starting from
+   *         the current winStart
+   */
+  std::size_t GetNConsecutiveSet (void) const;
 
 private:
-  uint16_t m_winStart;         ///< window start (sequence number)
-  std::vector<bool> m_window;  ///< window
-  std::size_t m_head;          ///< index of winStart in the vector
+  /**
+   * Clear the given number of elements of the bitmap, starting from the given
+   * position. The range of positions must not wrap around the end of the bitmap.
+   *
+   * \param pos the position of the first element to clear
+   * \param count the number of elements to clear
+   */
+  void Clear (std::size_t pos, std::size_t count);
+
+  uint16_t m_winStart;            ///< window start (sequence number)
+  std::size_t m_winSize;          ///< window size
+  std::vector<uint64_t> m_window; ///< window, 64 elements per word
+  std::size_t m_head;             ///< index of winStart in the bitmap
 };
 
 } //namespace ns3
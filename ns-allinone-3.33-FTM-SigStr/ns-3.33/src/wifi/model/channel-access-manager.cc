@@ -20,6 +20,7 @@
 
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/boolean.h"
 #include "channel-access-manager.h"
 #include "txop.h"
 #include "wifi-phy-listener.h"
@@ -98,6 +99,27 @@ private:
  *      Implement the channel access manager of all Txop holders
  ****************************************************************/
 
+NS_OBJECT_ENSURE_REGISTERED (ChannelAccessManager);
+
+TypeId
+ChannelAccessManager::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ChannelAccessManager")
+    .SetParent<Object> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<ChannelAccessManager> ()
+    .AddAttribute ("CacheBackoffDeadlines",
+                   "If true, the backoff end times of the Txops requesting access are "
+                   "computed once per update, with the access grant start evaluated once "
+                   "for all the Txops, and the access timeout is only rescheduled when the "
+                   "earliest backoff end time moves earlier than its expiration time.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ChannelAccessManager::m_cacheBackoffDeadlines),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
 ChannelAccessManager::ChannelAccessManager ()
   : m_lastAckTimeoutEnd (MicroSeconds (0)),
     m_lastCtsTimeoutEnd (MicroSeconds (0)),
@@ -114,6 +136,7 @@ ChannelAccessManager::ChannelAccessManager ()
     m_lastSwitchingDuration (MicroSeconds (0)),
     m_sleeping (false),
     m_off (false),
+    m_cacheBackoffDeadlines (false),
     m_phyListener (0)
 {
   NS_LOG_FUNCTION (this);
@@ -303,6 +326,7 @@ ChannelAccessManager::RequestAccess (Ptr<Txop> txop, bool isCfPeriod)
     {
       txop->NotifyAccessRequested ();
       Time delay = (MostRecent ({GetAccessGrantStart (true), Simulator::Now ()}) - Simulator::Now ());
+      m_accessTimeoutTarget = Simulator::Now () + delay;
       m_accessTimeout = Simulator::Schedule (delay, &ChannelAccessManager::DoGrantPcfAccess, this, txop);
       return;
     }
@@ -393,6 +417,19 @@ ChannelAccessManager::AccessTimeout (void)
 {
   NS_LOG_FUNCTION (this);
   UpdateBackoff ();
+  if (m_cacheBackoffDeadlines)
+    {
+      UpdateBackoffDeadlines ();
+      if (m_backoffDeadlines.empty ()
+          || *std::min_element (m_backoffDeadlines.begin (), m_backoffDeadlines.end ()) > Simulator::Now ())
+        {
+          // the medium became busy after the access timeout was scheduled,
+          // hence no backoff is expired yet
+          NS_LOG_DEBUG ("No backoff expired, access timeout rescheduled");
+          ScheduleAccessTimeout ();
+          return;
+        }
+    }
   DoGrantDcfAccess ();
   DoRestartAccessTimeoutIfNeeded ();
 }
@@ -499,10 +536,71 @@ ChannelAccessManager::UpdateBackoff (void)
     }
 }
 
+void
+ChannelAccessManager::UpdateBackoffDeadlines (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_backoffDeadlines.clear ();
+  Time accessGrantStart = GetAccessGrantStart ();
+  for (std::size_t i = 0; i < m_txops.size (); i++)
+    {
+      Ptr<Txop> txop = m_txops[i];
+      if (txop->IsAccessRequested ())
+        {
+          Time backoffStart = std::max (txop->GetBackoffStart (),
+                                        accessGrantStart + (txop->GetAifsn () * GetSlot ()));
+          m_backoffDeadlines.push_back (backoffStart + (txop->GetBackoffSlots () * GetSlot ()));
+        }
+    }
+}
+
+void
+ChannelAccessManager::ScheduleAccessTimeout (void)
+{
+  NS_LOG_FUNCTION (this);
+  // expired backoffs are not considered for the access timeout
+  Time now = Simulator::Now ();
+  Time expectedBackoffEnd = Simulator::GetMaximumSimulationTime ();
+  bool accessTimeoutNeeded = false;
+  for (const auto & deadline : m_backoffDeadlines)
+    {
+      if (deadline > now && deadline < expectedBackoffEnd)
+        {
+          expectedBackoffEnd = deadline;
+          accessTimeoutNeeded = true;
+        }
+    }
+  if (!accessTimeoutNeeded)
+    {
+      NS_LOG_DEBUG ("Access timeout not needed");
+      return;
+    }
+  NS_LOG_DEBUG ("expected backoff end=" << expectedBackoffEnd);
+  if (m_accessTimeout.IsRunning ())
+    {
+      if (m_accessTimeoutTarget <= expectedBackoffEnd)
+        {
+          // the access timeout expires no later than the earliest backoff end,
+          // it will be rescheduled upon expiration if needed
+          return;
+        }
+      m_accessTimeout.Cancel ();
+    }
+  m_accessTimeoutTarget = expectedBackoffEnd;
+  m_accessTimeout = Simulator::Schedule (expectedBackoffEnd - Simulator::Now (),
+                                         &ChannelAccessManager::AccessTimeout, this);
+}
+
 void
 ChannelAccessManager::DoRestartAccessTimeoutIfNeeded (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_cacheBackoffDeadlines)
+    {
+      UpdateBackoffDeadlines ();
+      ScheduleAccessTimeout ();
+      return;
+    }
   /**
    * Is there a Txop which needs to access the medium, and,
    * if there is one, how many slots for AIFS+backoff does it require ?
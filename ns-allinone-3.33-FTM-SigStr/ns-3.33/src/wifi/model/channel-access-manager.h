@@ -51,6 +51,12 @@ class MacLow;
 class ChannelAccessManager : public Object
 {
 public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
   ChannelAccessManager ();
   virtual ~ChannelAccessManager ();
 
@@ -249,6 +255,23 @@ private:
    */
   Time GetBackoffEndFor (Ptr<Txop> txop);
 
+  /**
+   * Recompute the backoff end times of the Txops that requested access and
+   * store them in the cached backoff deadlines. The access grant start
+   * is evaluated once for all the Txops.
+   */
+  void UpdateBackoffDeadlines (void);
+  /**
+   * Schedule the access timeout at the earliest backoff end time in the
+   * future among the cached backoff deadlines, unless it is already
+   * scheduled at an earlier time.
+   */
+  void ScheduleAccessTimeout (void);
+  /**
+   * Schedule the access timeout at the earliest backoff end time in the
+   * future among the Txops that requested access, unless it is already
+   * scheduled at an earlier time.
+   */
   void DoRestartAccessTimeoutIfNeeded (void);
 
   /**
@@ -309,6 +332,9 @@ private:
   bool m_off;                   //!< flag whether it is in off state
   Time m_eifsNoDifs;            //!< EIFS no DIFS time
   EventId m_accessTimeout;      //!< the access timeout ID
+  bool m_cacheBackoffDeadlines; //!< whether backoff deadlines are computed once per update
+  std::vector<Time> m_backoffDeadlines; //!< backoff end times of the Txops requesting access
+  Time m_accessTimeoutTarget;   //!< the expiration time of the access timeout
   Time m_slot;                  //!< the slot time
   Time m_sifs;                  //!< the SIFS time
   PhyListener* m_phyListener;   //!< the PHY listener
@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "error-rate-lookup-table.h"
+#include "wifi-utils.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ErrorRateLookupTable");
+
+/// Per-bit success rate below which SNR values are not tabulated
+static const double MIN_BIT_SUCCESS_RATE = 0.5;
+
+NS_OBJECT_ENSURE_REGISTERED (ErrorRateLookupTable);
+
+TypeId
+ErrorRateLookupTable::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ErrorRateLookupTable")
+    .SetParent<Object> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<ErrorRateLookupTable> ()
+    .AddAttribute ("MinSnr",
+                   "The lowest SNR (dB) covered by the tables. "
+                   "Lower SNR values are evaluated with the analytic model.",
+                   DoubleValue (-10.0),
+                   MakeDoubleAccessor (&ErrorRateLookupTable::m_minSnr),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxSnr",
+                   "The highest SNR (dB) covered by the tables. "
+                   "Higher SNR values are evaluated with the analytic model.",
+                   DoubleValue (50.0),
+                   MakeDoubleAccessor (&ErrorRateLookupTable::m_maxSnr),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Resolution",
+                   "The initial SNR step (dB) between two samples of a table.",
+                   DoubleValue (0.05),
+                   MakeDoubleAccessor (&ErrorRateLookupTable::m_resolution),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("MaxError",
+                   "The maximum absolute difference between the interpolated and the analytic "
+                   "per-bit success rate. The SNR step is halved until this bound is met.",
+                   DoubleValue (1e-5),
+                   MakeDoubleAccessor (&ErrorRateLookupTable::m_maxError),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("MaxRefinements",
+                   "The maximum number of times the SNR step is halved to meet MaxError.",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&ErrorRateLookupTable::m_maxRefinements),
+                   MakeUintegerChecker<uint8_t> ())
+  ;
+  return tid;
+}
+
+ErrorRateLookupTable::ErrorRateLookupTable ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+ErrorRateLookupTable::~ErrorRateLookupTable ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+ErrorRateLookupTable::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_tables.clear ();
+}
+
+double
+ErrorRateLookupTable::GetResolution (const Key &key) const
+{
+  auto it = m_tables.find (key);
+  if (it == m_tables.end ())
+    {
+      return 0;
+    }
+  return it->second.resolution;
+}
+
+ErrorRateLookupTable::SnrTable
+ErrorRateLookupTable::BuildTable (std::function<double (double)> bitSuccessRate) const
+{
+  NS_LOG_FUNCTION (this << m_minSnr << m_maxSnr << m_resolution << m_maxError);
+  NS_ASSERT (m_maxSnr > m_minSnr);
+  NS_ASSERT (m_resolution > 0);
+  SnrTable table;
+  table.resolution = m_resolution;
+  for (uint8_t refinement = 0; ; refinement++)
+    {
+      std::size_t nSamples = static_cast<std::size_t> (std::ceil ((m_maxSnr - m_minSnr) / table.resolution)) + 1;
+      table.inverseResolution = 1.0 / table.resolution;
+      table.logBitSuccess.clear ();
+      table.minSnr = m_maxSnr;
+      for (std::size_t i = 0; i < nSamples; i++)
+        {
+          double snr = m_minSnr + i * table.resolution;
+          double bitSuccess = bitSuccessRate (DbToRatio (snr));
+          if (table.logBitSuccess.empty ())
+            {
+              //The analytic models clip the bit error rate to 1, which creates a kink that cannot
+              //be interpolated accurately. SNR values below the first sample where most bits get
+              //through are left to the analytic model; chunks there are lost anyway.
+              if (bitSuccess < MIN_BIT_SUCCESS_RATE)
+                {
+                  continue;
+                }
+              table.minSnr = snr;
+            }
+          table.logBitSuccess.push_back (std::log (bitSuccess));
+        }
+      double error = 0;
+      for (std::size_t i = 0; i + 1 < table.logBitSuccess.size (); i++)
+        {
+          double interpolated = std::exp (0.5 * (table.logBitSuccess[i] + table.logBitSuccess[i + 1]));
+          double exact = bitSuccessRate (DbToRatio (table.minSnr + (i + 0.5) * table.resolution));
+          error = std::max (error, std::abs (interpolated - exact));
+        }
+      NS_LOG_DEBUG ("resolution=" << table.resolution << "dB samples=" << table.logBitSuccess.size ()
+                    << " minSnr=" << table.minSnr << "dB error=" << error);
+      if (error <= m_maxError)
+        {
+          break;
+        }
+      if (refinement >= m_maxRefinements)
+        {
+          NS_LOG_WARN ("Error " << error << " exceeds the bound " << m_maxError
+                       << " at the finest resolution " << table.resolution << "dB");
+          break;
+        }
+      table.resolution /= 2;
+    }
+  return table;
+}
+
+bool
+ErrorRateLookupTable::Interpolate (const SnrTable &table, double snr, uint64_t nbits, double &chunkSuccessRate) const
+{
+  if (snr <= 0)
+    {
+      return false;
+    }
+  double position = (RatioToDb (snr) - table.minSnr) * table.inverseResolution;
+  if (position < 0 || position + 1 >= table.logBitSuccess.size ())
+    {
+      return false;
+    }
+  std::size_t index = static_cast<std::size_t> (position);
+  double fraction = position - index;
+  double logBitSuccess = table.logBitSuccess[index]
+    + fraction * (table.logBitSuccess[index + 1] - table.logBitSuccess[index]);
+  chunkSuccessRate = std::exp (nbits * logBitSuccess);
+  return true;
+}
+
+} //namespace ns3
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ERROR_RATE_LOOKUP_TABLE_H
+#define ERROR_RATE_LOOKUP_TABLE_H
+
+#include <map>
+#include <tuple>
+#include <vector>
+#include <functional>
+#include "ns3/object.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ * \brief SNR-indexed cache of per-bit success rates for analytic error rate models
+ *
+ * Analytic models such as the NistErrorRateModel and the YansErrorRateModel
+ * compute the success rate of a chunk of nbits bits as (1 - pe)^nbits, where
+ * the per-bit error probability pe depends on the mode and on the SNR only.
+ * This class samples log (1 - pe) on a uniform grid of SNR values (in dB) the
+ * first time a given key is seen, so that subsequent chunk success rates are
+ * obtained through a linear interpolation followed by a single exp ().
+ *
+ * The grid is refined until the per-bit success rate obtained by interpolation
+ * differs from the analytic value by at most MaxError at the middle of every
+ * grid interval. For a chunk of nbits bits, the error on the chunk success rate
+ * is then bounded by nbits * MaxError. SNR values outside of the configured
+ * range, or low enough for the per-bit success rate to fall below one half,
+ * are handed back to the analytic model.
+ */
+class ErrorRateLookupTable : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  ErrorRateLookupTable ();
+  virtual ~ErrorRateLookupTable ();
+
+  /**
+   * Key identifying a table: the TypeId UID of the error rate model, the UID
+   * of the Wi-Fi mode, the channel width (in MHz) and the PHY rate (in bps).
+   * Models whose per-bit error rate does not depend on the last two fields
+   * should set them to zero.
+   */
+  typedef std::tuple<uint16_t, uint32_t, uint16_t, uint64_t> Key;
+
+  /**
+   * Return the success rate of a chunk, using the table associated to the given
+   * key. The table is built on first use from the analytic model.
+   *
+   * \tparam F callable with signature double (double snr, uint64_t nbits)
+   *           returning the analytic chunk success rate
+   * \param key the key identifying the table
+   * \param snr the SNR of the chunk (linear scale)
+   * \param nbits the number of bits in the chunk
+   * \param analytic the analytic chunk success rate computation
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  template <typename F>
+  double GetChunkSuccessRate (const Key &key, double snr, uint64_t nbits, F analytic);
+
+  /**
+   * \param key the key identifying the table
+   * \return the SNR resolution (in dB) of the table, or zero if it has not been built yet
+   */
+  double GetResolution (const Key &key) const;
+
+  /**
+   * Discard all the tables built so far.
+   */
+  void Clear (void);
+
+
+private:
+  /**
+   * Per-bit success rate sampled on a uniform SNR grid.
+   */
+  struct SnrTable
+  {
+    double minSnr;                      //!< SNR of the first sample (dB)
+    double resolution;                  //!< SNR step between two samples (dB)
+    double inverseResolution;           //!< Inverse of the SNR step (1/dB)
+    std::vector<double> logBitSuccess;  //!< Natural logarithm of the per-bit success rate
+  };
+
+  /**
+   * Sample the per-bit success rate on the configured SNR range, refining the
+   * grid until the accuracy bound is met.
+   *
+   * \param bitSuccessRate the analytic per-bit success rate as a function of the SNR (linear scale)
+   * \return the table
+   */
+  SnrTable BuildTable (std::function<double (double)> bitSuccessRate) const;
+
+  /**
+   * \param table the table to interpolate
+   * \param snr the SNR (linear scale)
+   * \param nbits the number of bits in the chunk
+   * \param chunkSuccessRate the interpolated chunk success rate
+   * \return true if the SNR falls within the table, false otherwise
+   */
+  bool Interpolate (const SnrTable &table, double snr, uint64_t nbits, double &chunkSuccessRate) const;
+
+  double m_minSnr;   //!< Lowest SNR covered by the tables (dB)
+  double m_maxSnr;   //!< Highest SNR covered by the tables (dB)
+  double m_resolution; //!< Initial SNR step of the tables (dB)
+  double m_maxError; //!< Maximum absolute error on the per-bit success rate
+  uint8_t m_maxRefinements; //!< Maximum number of times the SNR step is halved
+
+  std::map<Key, SnrTable> m_tables; //!< Tables built so far
+};
+
+template <typename F>
+double
+ErrorRateLookupTable::GetChunkSuccessRate (const Key &key, double snr, uint64_t nbits, F analytic)
+{
+  auto it = m_tables.find (key);
+  if (it == m_tables.end ())
+    {
+      it = m_tables.insert (std::make_pair (key, BuildTable ([&analytic] (double s)
+                                                             {
+                                                               return analytic (s, 1);
+                                                             }))).first;
+    }
+  double chunkSuccessRate;
+  if (Interpolate (it->second, snr, nbits, chunkSuccessRate))
+    {
+      return chunkSuccessRate;
+    }
+  return analytic (snr, nbits);
+}
+
+} //namespace ns3
+
+#endif /* ERROR_RATE_LOOKUP_TABLE_H */
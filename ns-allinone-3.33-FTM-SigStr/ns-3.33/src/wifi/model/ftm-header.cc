@@ -425,31 +425,28 @@ FtmRequestHeader::SetTrigger (uint8_t trigger)
 }
 
 uint8_t
-FtmRequestHeader::GetTrigger (void)
+FtmRequestHeader::GetTrigger (void) const
 {
   return m_trigger;
 }
 
 void
-FtmRequestHeader::SetFtmParams (FtmParams ftm_params)
+FtmRequestHeader::SetFtmParams (const FtmParams &ftm_params)
 {
   m_ftm_params = ftm_params;
   m_ftm_params_set = true;
 }
 
 
-FtmParams
-FtmRequestHeader::GetFtmParams (void)
+const FtmParams &
+FtmRequestHeader::GetFtmParams (void) const
 {
-  if (m_ftm_params_set)
-    {
-      return m_ftm_params;
-    }
-  return FtmParams();
+  //m_ftm_params keeps its default value until SetFtmParams is called
+  return m_ftm_params;
 }
 
 bool
-FtmRequestHeader::GetFtmParamsSet (void)
+FtmRequestHeader::GetFtmParamsSet (void) const
 {
   return m_ftm_params_set;
 }
@@ -617,7 +614,7 @@ FtmResponseHeader::SetDialogToken (uint8_t dialog_token)
 }
 
 uint8_t
-FtmResponseHeader::GetDialogToken (void)
+FtmResponseHeader::GetDialogToken (void) const
 {
   return m_dialog_token;
 }
@@ -629,7 +626,7 @@ FtmResponseHeader::SetFollowUpDialogToken (uint8_t follow_up_dialog_token)
 }
 
 uint8_t
-FtmResponseHeader::GetFollowUpDialogToken (void)
+FtmResponseHeader::GetFollowUpDialogToken (void) const
 {
   return m_follow_up_dialog_token;
 }
@@ -641,7 +638,7 @@ FtmResponseHeader::SetTimeOfDeparture (uint64_t tod)
 }
 
 uint64_t
-FtmResponseHeader::GetTimeOfDeparture (void)
+FtmResponseHeader::GetTimeOfDeparture (void) const
 {
   return m_tod;
 }
@@ -653,7 +650,7 @@ FtmResponseHeader::SetTimeOfArrival (uint64_t toa)
 }
 
 uint64_t
-FtmResponseHeader::GetTimeOfArrival (void)
+FtmResponseHeader::GetTimeOfArrival (void) const
 {
   return m_toa;
 }
@@ -665,7 +662,7 @@ FtmResponseHeader::SetTimeOfDepartureError (uint16_t tod_error)
 }
 
 uint16_t
-FtmResponseHeader::GetTimeOfDepartureError (void)
+FtmResponseHeader::GetTimeOfDepartureError (void) const
 {
   return m_tod_error;
 }
@@ -677,31 +674,28 @@ FtmResponseHeader::SetTimeOfArrivalError (uint16_t toa_error)
 }
 
 uint16_t
-FtmResponseHeader::GetTimeOfArrivalError (void)
+FtmResponseHeader::GetTimeOfArrivalError (void) const
 {
   return m_toa_error;
 }
 
 void
-FtmResponseHeader::SetFtmParams (FtmParams ftm_params)
+FtmResponseHeader::SetFtmParams (const FtmParams &ftm_params)
 {
   m_ftm_params = ftm_params;
   m_ftm_params_set = true;
 }
 
 
-FtmParams
-FtmResponseHeader::GetFtmParams (void)
+const FtmParams &
+FtmResponseHeader::GetFtmParams (void) const
 {
-  if (m_ftm_params_set)
-    {
-      return m_ftm_params;
-    }
-  return FtmParams();
+  //m_ftm_params keeps its default value until SetFtmParams is called
+  return m_ftm_params;
 }
 
 bool
-FtmResponseHeader::GetFtmParamsSet (void)
+FtmResponseHeader::GetFtmParamsSet (void) const
 {
   return m_ftm_params_set;
 }
@@ -336,28 +336,28 @@ public:
    *
    * \return the trigger
    */
-  uint8_t GetTrigger (void);
+  uint8_t GetTrigger (void) const;
 
   /**
    * Set the FTM parameters.
    *
    * \param ftm_params the FtmParams
    */
-  void SetFtmParams (FtmParams ftm_params);
+  void SetFtmParams (const FtmParams &ftm_params);
 
   /**
    * Returns the FTM parameters, if set.
    *
    * \return the FtmParams
    */
-  FtmParams GetFtmParams (void);
+  const FtmParams & GetFtmParams (void) const;
 
   /**
    * Returns true if the FTM parameters have been set.
    *
    * \return if FtmParams have been set
    */
-  bool GetFtmParamsSet (void);
+  bool GetFtmParamsSet (void) const;
 
 private:
   uint8_t m_trigger;
@@ -400,7 +400,7 @@ public:
    *
    * \return the dialog token
    */
-  uint8_t GetDialogToken (void);
+  uint8_t GetDialogToken (void) const;
 
   /**
    * Set the follow up dialog token.
@@ -414,7 +414,7 @@ public:
    *
    * \return the follow up dialog token
    */
-  uint8_t GetFollowUpDialogToken (void);
+  uint8_t GetFollowUpDialogToken (void) const;
 
   /**
    * Set the time of departure.
@@ -428,7 +428,7 @@ public:
    *
    * \return the time of departure
    */
-  uint64_t GetTimeOfDeparture (void);
+  uint64_t GetTimeOfDeparture (void) const;
 
   /**
    * Set the time of arrival.
@@ -442,7 +442,7 @@ public:
    *
    * \return the time of arrival
    */
-  uint64_t GetTimeOfArrival (void);
+  uint64_t GetTimeOfArrival (void) const;
 
   /**
    * Set the time of departure error.
@@ -456,7 +456,7 @@ public:
    *
    * \return the time of departure error
    */
-  uint16_t GetTimeOfDepartureError (void);
+  uint16_t GetTimeOfDepartureError (void) const;
 
   /**
    * Set the time of arrival error.
@@ -470,28 +470,28 @@ public:
    *
    * \return the time of arrival error
    */
-  uint16_t GetTimeOfArrivalError (void);
+  uint16_t GetTimeOfArrivalError (void) const;
 
   /**
    * Set the FTM parameters.
    *
    * \param ftm_params the FtmParams
    */
-  void SetFtmParams (FtmParams ftm_params);
+  void SetFtmParams (const FtmParams &ftm_params);
 
   /**
    * Returns the FTM parameters.
    *
    * \return the FtmParams
    */
-  FtmParams GetFtmParams (void);
+  const FtmParams & GetFtmParams (void) const;
 
   /**
    * Returns true if the FTM parameters have been set.
    *
    * \return if FtmParams have been set
    */
-  bool GetFtmParamsSet (void);
+  bool GetFtmParamsSet (void) const;
 
 private:
   uint8_t m_dialog_token;
@@ -20,6 +20,8 @@
 
 #include "ftm-manager.h"
 #include "ns3/core-module.h"
+#include "wifi-mac-header-view.h"
+#include "wifi-profiler.h"
 
 
 namespace ns3 {
@@ -73,15 +75,21 @@ FtmManager::~FtmManager ()
 void
 FtmManager::PhyTxBegin(Ptr<const Packet> packet, double num)
 {
+  WifiProfiler::Scope profile (WifiProfiler::FTM_MANAGER);
 
   Time now = Simulator::Now();
   int64_t pico_sec = now.GetPicoSeconds();
   pico_sec &= 0x0000FFFFFFFFFFFF;
   sent_packets++;
-  Ptr<Packet> copy = packet->Copy();
-  WifiMacHeader hdr;
-  copy->RemoveHeader(hdr);
-  if(hdr.IsMgt() && hdr.IsAction()) {
+  WifiMacHeaderView view (packet);
+  if (!view.IsValid ())
+    {
+      return;
+    }
+  if(view.IsAction()) {
+      Ptr<Packet> copy = packet->Copy();
+      WifiMacHeader hdr;
+      copy->RemoveHeader(hdr);
       WifiActionHeader action_hdr;
       copy->RemoveHeader(action_hdr);
       if(action_hdr.GetCategory() == WifiActionHeader::PUBLIC_ACTION) {
@@ -107,9 +115,9 @@ FtmManager::PhyTxBegin(Ptr<const Packet> packet, double num)
             }
       }
   }
-  else if(hdr.IsAck()) {
+  else if(view.IsAck()) {
       if(sending_ack && sent_packets == 1) {
-          if(m_ack_to == hdr.GetAddr1()) {
+          if(m_ack_to == view.GetAddr1()) {
               sending_ack = false;
               Ptr<FtmSession> session = FindSession (m_current_rx_packet.mac_hdr.GetAddr2());
               if (session != 0)
@@ -125,15 +133,21 @@ void
 FtmManager::PhyRxBegin(Ptr<const Packet> packet, RxPowerWattPerChannelBand rxPowersW)
 {
   NS_LOG_FUNCTION (this);
+  WifiProfiler::Scope profile (WifiProfiler::FTM_MANAGER);
   Time now = Simulator::Now();
   int64_t pico_sec = now.GetPicoSeconds();
   pico_sec &= 0x0000FFFFFFFFFFFF;
-  Ptr<Packet> copy = packet->Copy();
   received_packets++;
-  WifiMacHeader hdr;
-  copy->RemoveHeader(hdr);
-  if(hdr.GetAddr1() == m_mac_address){
-      if(hdr.IsMgt() && hdr.IsAction()) {
+  WifiMacHeaderView view (packet);
+  if (!view.IsValid ())
+    {
+      return;
+    }
+  if(view.GetAddr1() == m_mac_address){
+      if(view.IsAction()) {
+          Ptr<Packet> copy = packet->Copy();
+          WifiMacHeader hdr;
+          copy->RemoveHeader(hdr);
           WifiActionHeader action_hdr;
           copy->RemoveHeader(action_hdr);
           if(action_hdr.GetCategory() == WifiActionHeader::PUBLIC_ACTION) {
@@ -159,7 +173,7 @@ FtmManager::PhyRxBegin(Ptr<const Packet> packet, RxPowerWattPerChannelBand rxPow
               }
           }
       }
-      if(hdr.IsAck()) {
+      if(view.IsAck()) {
           if(awaiting_ack && received_packets == 1) {
               awaiting_ack = false;
               Ptr<FtmSession> session = FindSession (m_current_tx_packet.mac_hdr.GetAddr1());
@@ -179,14 +193,19 @@ void
 FtmManager::SnifferRxNotify(Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector, MpduInfo aMpdu, SignalNoiseDbm signalNoise, uint16_t staId)
 {
   NS_LOG_FUNCTION (this);
-  Ptr<Packet> copy = packet->Copy();
-
-  WifiMacHeader hdr;
-  copy->RemoveHeader(hdr);
-  if(hdr.GetAddr1() == m_mac_address)
+  WifiProfiler::Scope profile (WifiProfiler::FTM_MANAGER);
+  WifiMacHeaderView view (packet);
+  if (!view.IsValid ())
+    {
+      return;
+    }
+  if(view.GetAddr1() == m_mac_address)
     {
-    if(hdr.IsMgt() && hdr.IsAction())
+    if(view.IsAction())
       {
+      Ptr<Packet> copy = packet->Copy();
+      WifiMacHeader hdr;
+      copy->RemoveHeader(hdr);
       WifiActionHeader action_hdr;
       copy->RemoveHeader(action_hdr);
       if(action_hdr.GetCategory() == WifiActionHeader::PUBLIC_ACTION)
@@ -262,7 +281,7 @@ FtmManager::SessionOver (Mac48Address addr)
 }
 
 void
-FtmManager::ReceivedFtmRequest (Mac48Address partner, FtmRequestHeader ftm_req)
+FtmManager::ReceivedFtmRequest (Mac48Address partner, const FtmRequestHeader &ftm_req)
 {
   Ptr<FtmSession> session = FindSession (partner);
   if (session == 0)
@@ -273,7 +292,7 @@ FtmManager::ReceivedFtmRequest (Mac48Address partner, FtmRequestHeader ftm_req)
 }
 
 void
-FtmManager::ReceivedFtmResponse (Mac48Address partner, FtmResponseHeader ftm_res)
+FtmManager::ReceivedFtmResponse (Mac48Address partner, const FtmResponseHeader &ftm_res)
 {
   Ptr<FtmSession> session = FindSession (partner);
   if (session != 0)
@@ -90,7 +90,7 @@ public:
    * \param partner the partner address
    * \param ftm_req the FTM request
    */
-  void ReceivedFtmRequest (Mac48Address partner, FtmRequestHeader ftm_req);
+  void ReceivedFtmRequest (Mac48Address partner, const FtmRequestHeader &ftm_req);
 
   /**
    * Called from the RegularWifiMac when a FTM response has been received. It then gets forwarded to
@@ -99,7 +99,7 @@ public:
    * \param partner the partner address
    * \param ftm_req the FTM response
    */
-  void ReceivedFtmResponse (Mac48Address partner, FtmResponseHeader ftm_res);
+  void ReceivedFtmResponse (Mac48Address partner, const FtmResponseHeader &ftm_res);
 
 
 private:
@@ -109,7 +109,7 @@ FtmSession::SetPreambleDetectionDuration (Time duration)
 }
 
 void
-FtmSession::SetFtmParams (FtmParams ftm_params)
+FtmSession::SetFtmParams (const FtmParams &ftm_params)
 {
   m_ftm_params = ftm_params;
 }
@@ -121,7 +121,7 @@ FtmSession::GetFtmParams (void)
 }
 
 void
-FtmSession::ProcessFtmRequest (FtmRequestHeader ftm_req)
+FtmSession::ProcessFtmRequest (const FtmRequestHeader &ftm_req)
 {
   if (ftm_req.GetTrigger() == 1)
     {
@@ -163,7 +163,7 @@ FtmSession::ProcessFtmRequest (FtmRequestHeader ftm_req)
 }
 
 void
-FtmSession::ProcessFtmResponse (FtmResponseHeader ftm_res)
+FtmSession::ProcessFtmResponse (const FtmResponseHeader &ftm_res)
 {
   if (ftm_res.GetFtmParamsSet())
     {
@@ -124,7 +124,7 @@ public:
    *
    * \param params the FtmParams
    */
-  void SetFtmParams (FtmParams params);
+  void SetFtmParams (const FtmParams &params);
 
   /**
    * Returns the FTM parameters of the session.
@@ -138,14 +138,14 @@ public:
    *
    * \param ftm_req the FTM request
    */
-  void ProcessFtmRequest (FtmRequestHeader ftm_req);
+  void ProcessFtmRequest (const FtmRequestHeader &ftm_req);
 
   /**
    * Processes a received FTM response frame.
    *
    * \param ftm_res the FTM response
    */
-  void ProcessFtmResponse (FtmResponseHeader ftm_res);
+  void ProcessFtmResponse (const FtmResponseHeader &ftm_res);
 
   /**
    * Starts the FTM session. This should be called by the user after the setup of the session has been completed.
@@ -30,6 +30,7 @@
 #include "wifi-utils.h"
 #include "wifi-ppdu.h"
 #include "wifi-psdu.h"
+#include "wifi-profiler.h"
 
 namespace ns3 {
 
@@ -154,7 +155,8 @@ InterferenceHelper::NiChange::GetEvent (void) const
 InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
     m_numRxAntennas (1),
-    m_rxing (false)
+    m_rxing (false),
+    m_ppduAbstraction (false)
 {
 }
 
@@ -228,6 +230,18 @@ InterferenceHelper::SetNumberOfReceiveAntennas (uint8_t rx)
   m_numRxAntennas = rx;
 }
 
+void
+InterferenceHelper::SetPpduAbstraction (bool enable)
+{
+  m_ppduAbstraction = enable;
+}
+
+bool
+InterferenceHelper::GetPpduAbstraction (void) const
+{
+  return m_ppduAbstraction;
+}
+
 Time
 InterferenceHelper::GetEnergyDuration (double energyW, WifiSpectrumBand band) const
 {
@@ -329,6 +343,66 @@ InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChangesPerB
   return noiseInterferenceW;
 }
 
+double
+InterferenceHelper::CalculateAverageNoiseInterferenceW (Ptr<const Event> event, NiChangesPerBand *nis, WifiSpectrumBand band) const
+{
+  NS_LOG_FUNCTION (this << band.first << band.second);
+  const NiChanges &ni = nis->find (band)->second;
+  auto j = ni.begin ();
+  Time previous = j->first;
+  double noiseInterferenceW = m_firstPowerPerBand.find (band)->second;
+  double powerW = event->GetRxPowerW (band);
+  double energy = 0;
+  while (++j != ni.end ())
+    {
+      energy += noiseInterferenceW * (j->first - previous).GetSeconds ();
+      noiseInterferenceW = j->second.GetPower () - powerW;
+      previous = j->first;
+    }
+  Time duration = event->GetDuration ();
+  if (!duration.IsStrictlyPositive ())
+    {
+      return noiseInterferenceW;
+    }
+  return energy / duration.GetSeconds ();
+}
+
+double
+InterferenceHelper::CalculateAbstractPhyHeaderPer (Ptr<const Event> event, double snr, bool htHeader) const
+{
+  NS_LOG_FUNCTION (this << snr << htHeader);
+  const WifiTxVector txVector = event->GetTxVector ();
+  WifiPreamble preamble = txVector.GetPreambleType ();
+  WifiMode headerMode = WifiPhy::GetPhyHeaderMode (txVector);
+  if (!htHeader)
+    {
+      return 1 - CalculateChunkSuccessRate (snr, WifiPhy::GetPhyHeaderDuration (txVector), headerMode, txVector);
+    }
+  WifiMode mcsHeaderMode;
+  if (IsHt (preamble))
+    {
+      mcsHeaderMode = WifiPhy::GetHtPhyHeaderMode ();
+    }
+  else if (IsVht (preamble))
+    {
+      mcsHeaderMode = WifiPhy::GetVhtPhyHeaderMode ();
+    }
+  else if (IsHe (preamble))
+    {
+      mcsHeaderMode = WifiPhy::GetHePhyHeaderMode ();
+    }
+  else
+    {
+      return 0;
+    }
+  Time sigDuration = WifiPhy::GetPhyHtSigHeaderDuration (preamble) + WifiPhy::GetPhySigA1Duration (preamble) + WifiPhy::GetPhySigA2Duration (preamble);
+  Time trainingDuration = WifiPhy::GetPhyTrainingSymbolDuration (txVector) + WifiPhy::GetPhySigBDuration (preamble);
+  //SIG-A is sent using non-HT OFDM modulation, HT-SIG using the HT header mode
+  double psr = CalculateChunkSuccessRate (snr, sigDuration, (IsVht (preamble) || IsHe (preamble)) ? headerMode : mcsHeaderMode, txVector);
+  psr *= CalculateChunkSuccessRate (snr, trainingDuration, mcsHeaderMode, txVector);
+  return 1 - psr;
+}
+
 double
 InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode, WifiTxVector txVector) const
 {
@@ -796,6 +870,7 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, uint16_t channelWi
                                             uint16_t staId, std::pair<Time, Time> relativeMpduStartStop) const
 {
   NS_LOG_FUNCTION (this << channelWidth << band.first << band.second << staId << relativeMpduStartStop.first << relativeMpduStartStop.second);
+  WifiProfiler::Scope profile (WifiProfiler::SNR_PER);
   NiChangesPerBand ni;
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni, band);
   double snr = CalculateSnr (event->GetRxPowerW (band),
@@ -803,10 +878,24 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, uint16_t channelWi
                              channelWidth,
                              event->GetTxVector ().GetNss (staId));
 
-  /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
-   * all SNIR changes in the SNIR vector.
-   */
-  double per = CalculatePayloadPer (event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+  double per;
+  if (m_ppduAbstraction)
+    {
+      /* evaluate the whole MPDU with the SNIR averaged over the PPDU */
+      double averageSnr = CalculateSnr (event->GetRxPowerW (band),
+                                        CalculateAverageNoiseInterferenceW (event, &ni, band),
+                                        channelWidth,
+                                        event->GetTxVector ().GetNss (staId));
+      per = 1 - CalculatePayloadChunkSuccessRate (averageSnr, relativeMpduStartStop.second - relativeMpduStartStop.first,
+                                                  event->GetTxVector (), staId);
+    }
+  else
+    {
+      /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
+       * all SNIR changes in the SNIR vector.
+       */
+      per = CalculatePayloadPer (event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+    }
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -830,6 +919,7 @@ struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculateNonHtPhyHeaderSnrPer (Ptr<Event> event, WifiSpectrumBand band) const
 {
   NS_LOG_FUNCTION (this << band.first << band.second);
+  WifiProfiler::Scope profile (WifiProfiler::SNR_PER);
   NiChangesPerBand ni;
   uint16_t channelWidth;
   if (event->GetTxVector ().GetChannelWidth () >= 40)
@@ -846,10 +936,22 @@ InterferenceHelper::CalculateNonHtPhyHeaderSnrPer (Ptr<Event> event, WifiSpectru
                              channelWidth,
                              1);
 
-  /* calculate the SNIR at the start of the PHY header and accumulate
-   * all SNIR changes in the SNIR vector.
-   */
-  double per = CalculateNonHtPhyHeaderPer (event, &ni, band);
+  double per;
+  if (m_ppduAbstraction)
+    {
+      double averageSnr = CalculateSnr (event->GetRxPowerW (band),
+                                        CalculateAverageNoiseInterferenceW (event, &ni, band),
+                                        channelWidth,
+                                        1);
+      per = CalculateAbstractPhyHeaderPer (event, averageSnr, false);
+    }
+  else
+    {
+      /* calculate the SNIR at the start of the PHY header and accumulate
+       * all SNIR changes in the SNIR vector.
+       */
+      per = CalculateNonHtPhyHeaderPer (event, &ni, band);
+    }
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -861,6 +963,7 @@ struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculateHtPhyHeaderSnrPer (Ptr<Event> event, WifiSpectrumBand band) const
 {
   NS_LOG_FUNCTION (this << band.first << band.second);
+  WifiProfiler::Scope profile (WifiProfiler::SNR_PER);
   NiChangesPerBand ni;
   uint16_t channelWidth;
   if (event->GetTxVector ().GetChannelWidth () >= 40)
@@ -876,12 +979,24 @@ InterferenceHelper::CalculateHtPhyHeaderSnrPer (Ptr<Event> event, WifiSpectrumBa
                              noiseInterferenceW,
                              channelWidth,
                              1);
-  
-  /* calculate the SNIR at the start of the PHY header and accumulate
-   * all SNIR changes in the SNIR vector.
-   */
-  double per = CalculateHtPhyHeaderPer (event, &ni, band);
-  
+
+  double per;
+  if (m_ppduAbstraction)
+    {
+      double averageSnr = CalculateSnr (event->GetRxPowerW (band),
+                                        CalculateAverageNoiseInterferenceW (event, &ni, band),
+                                        channelWidth,
+                                        1);
+      per = CalculateAbstractPhyHeaderPer (event, averageSnr, true);
+    }
+  else
+    {
+      /* calculate the SNIR at the start of the PHY header and accumulate
+       * all SNIR changes in the SNIR vector.
+       */
+      per = CalculateHtPhyHeaderPer (event, &ni, band);
+    }
+
   struct SnrPer snrPer;
   snrPer.snr = snr;
   snrPer.per = per;
@@ -186,6 +186,19 @@ public:
    * \param rx the number of RX antennas
    */
   void SetNumberOfReceiveAntennas (uint8_t rx);
+  /**
+   * Enable or disable the PPDU-level abstraction. When enabled, the noise plus
+   * interference power is averaged over the whole PPDU and the PHY header and
+   * each MPDU are evaluated with a single error rate model lookup, instead of
+   * one lookup per chunk of constant interference.
+   *
+   * \param enable whether the PPDU-level abstraction is enabled
+   */
+  void SetPpduAbstraction (bool enable);
+  /**
+   * \return whether the PPDU-level abstraction is enabled
+   */
+  bool GetPpduAbstraction (void) const;
 
   /**
    * \param energyW the minimum energy (W) requested
@@ -369,6 +382,28 @@ private:
    * \return noise and interference power
    */
   double CalculateNoiseInterferenceW (Ptr<Event> event, NiChangesPerBand *nis, WifiSpectrumBand band) const;
+  /**
+   * Calculate the noise and interference power in W averaged over the duration
+   * of the event, weighting each chunk of the NiChanges by its duration.
+   *
+   * \param event the event
+   * \param nis the NiChanges filled by CalculateNoiseInterferenceW
+   * \param band the band
+   *
+   * \return the average noise and interference power
+   */
+  double CalculateAverageNoiseInterferenceW (Ptr<const Event> event, NiChangesPerBand *nis, WifiSpectrumBand band) const;
+  /**
+   * Calculate the error rate of the PHY header of the event using a single SNR
+   * for each of its fields. Used when the PPDU-level abstraction is enabled.
+   *
+   * \param event the event
+   * \param snr the SNR averaged over the event (linear scale)
+   * \param htHeader whether to evaluate the HT/VHT/HE PHY header fields rather than L-SIG
+   *
+   * \return the error rate of the PHY header
+   */
+  double CalculateAbstractPhyHeaderPer (Ptr<const Event> event, double snr, bool htHeader) const;
   /**
    * Calculate the success rate of the payload chunk given the SINR, duration, and Wi-Fi mode.
    * The duration and mode are used to calculate how many bits are present in the chunk.
@@ -426,6 +461,7 @@ private:
   NiChangesPerBand m_niChangesPerBand;                     //!< NI Changes for each band
   std::map <WifiSpectrumBand, double> m_firstPowerPerBand; //!< first power of each band in watts
   bool m_rxing;                                            //!< flag whether it is in receiving state
+  bool m_ppduAbstraction;                                  //!< flag whether the PPDU-level abstraction is enabled
 
   /**
    * Returns an iterator to the first NiChange that is later than moment
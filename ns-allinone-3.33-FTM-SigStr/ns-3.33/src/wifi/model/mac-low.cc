@@ -43,6 +43,7 @@
 #include "wifi-mac.h"
 #include <algorithm>
 #include "wifi-ack-policy-selector.h"
+#include "wifi-profiler.h"
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT std::clog << "[mac=" << m_self << "] "
@@ -137,6 +138,7 @@ MacLow::MacLow ()
     m_cfAckInfo ()
 {
   NS_LOG_FUNCTION (this);
+  m_ampduPlan.active = false;
 }
 
 MacLow::~MacLow ()
@@ -605,9 +607,14 @@ MacLow::IsWithinSizeAndTimeLimits (uint32_t mpduSize, Mac48Address receiver, uin
     }
 
   WifiModulationClass modulation = txVector.GetMode ().GetModulationClass ();
+  bool planned = IsAmpduPlanned (receiver, tid, txVector, ppduDurationLimit);
 
   uint32_t maxAmpduSize = 0;
-  if (GetMpduAggregator ())
+  if (planned)
+    {
+      maxAmpduSize = m_ampduPlan.maxAmpduSize;
+    }
+  else if (GetMpduAggregator ())
     {
       maxAmpduSize = GetMpduAggregator ()->GetMaxAmpduSize (receiver, tid, modulation);
     }
@@ -629,13 +636,39 @@ MacLow::IsWithinSizeAndTimeLimits (uint32_t mpduSize, Mac48Address receiver, uin
       return false;
     }
 
-  // Get the maximum PPDU Duration based on the preamble type
-  Time maxPpduDuration = GetPpduMaxTime (txVector.GetPreambleType ());
-
-  Time txTime = m_phy->CalculateTxDuration (ppduPayloadSize, txVector, m_phy->GetPhyBand ());
+  if (planned && ampduSize > 0)
+    {
+      if (!m_ampduPlan.maxPsduSizeValid)
+        {
+          // the transmission time does not decrease as the PSDU size increases, hence
+          // bisect on the PSDU size to find the largest PSDU meeting the duration limits
+          uint32_t low = 0;
+          uint32_t high = maxAmpduSize;
+          while (low < high)
+            {
+              uint32_t mid = low + (high - low + 1) / 2;
+              if (IsWithinTimeLimits (mid, txVector, ppduDurationLimit))
+                {
+                  low = mid;
+                }
+              else
+                {
+                  high = mid - 1;
+                }
+            }
+          m_ampduPlan.maxPsduSize = low;
+          m_ampduPlan.maxPsduSizeValid = true;
+          NS_LOG_DEBUG ("largest PSDU size meeting the duration limits: " << low);
+        }
+      if (ppduPayloadSize > m_ampduPlan.maxPsduSize)
+        {
+          NS_LOG_DEBUG ("the frame does not meet the constraint on max PPDU duration");
+          return false;
+        }
+      return true;
+    }
 
-  if ((ppduDurationLimit.IsStrictlyPositive () && txTime > ppduDurationLimit)
-      || (maxPpduDuration.IsStrictlyPositive () && txTime > maxPpduDuration))
+  if (!IsWithinTimeLimits (ppduPayloadSize, txVector, ppduDurationLimit))
     {
       NS_LOG_DEBUG ("the frame does not meet the constraint on max PPDU duration");
       return false;
@@ -644,6 +677,62 @@ MacLow::IsWithinSizeAndTimeLimits (uint32_t mpduSize, Mac48Address receiver, uin
   return true;
 }
 
+bool
+MacLow::IsWithinTimeLimits (uint32_t psduSize, WifiTxVector txVector, Time ppduDurationLimit) const
+{
+  // Get the maximum PPDU Duration based on the preamble type
+  Time maxPpduDuration = GetPpduMaxTime (txVector.GetPreambleType ());
+
+  Time txTime = m_phy->CalculateTxDuration (psduSize, txVector, m_phy->GetPhyBand ());
+
+  return !((ppduDurationLimit.IsStrictlyPositive () && txTime > ppduDurationLimit)
+           || (maxPpduDuration.IsStrictlyPositive () && txTime > maxPpduDuration));
+}
+
+void
+MacLow::StartAmpduPlanning (Mac48Address receiver, uint8_t tid, WifiTxVector txVector,
+                            Time ppduDurationLimit)
+{
+  NS_LOG_FUNCTION (this << receiver << +tid << txVector << ppduDurationLimit);
+  m_ampduPlan.active = false;
+  m_ampduPlan.receiver = receiver;
+  m_ampduPlan.tid = tid;
+  m_ampduPlan.txVector = txVector;
+  m_ampduPlan.ppduDurationLimit = ppduDurationLimit;
+  m_ampduPlan.maxAmpduSize = 0;
+  if (GetMpduAggregator ())
+    {
+      m_ampduPlan.maxAmpduSize = GetMpduAggregator ()->GetMaxAmpduSize (receiver, tid,
+                                                                         txVector.GetMode ().GetModulationClass ());
+    }
+  m_ampduPlan.maxPsduSizeValid = false;
+  m_ampduPlan.maxPsduSize = 0;
+  m_ampduPlan.active = true;
+}
+
+void
+MacLow::StopAmpduPlanning (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_ampduPlan.active = false;
+}
+
+bool
+MacLow::IsAmpduPlanned (Mac48Address receiver, uint8_t tid, const WifiTxVector &txVector,
+                        Time ppduDurationLimit) const
+{
+  return m_ampduPlan.active
+         && m_ampduPlan.receiver == receiver
+         && m_ampduPlan.tid == tid
+         && m_ampduPlan.ppduDurationLimit == ppduDurationLimit
+         && m_ampduPlan.txVector.GetMode () == txVector.GetMode ()
+         && m_ampduPlan.txVector.GetChannelWidth () == txVector.GetChannelWidth ()
+         && m_ampduPlan.txVector.GetNss () == txVector.GetNss ()
+         && m_ampduPlan.txVector.GetGuardInterval () == txVector.GetGuardInterval ()
+         && m_ampduPlan.txVector.GetPreambleType () == txVector.GetPreambleType ()
+         && m_ampduPlan.txVector.IsStbc () == txVector.IsStbc ();
+}
+
 void
 MacLow::RxStartIndication (WifiTxVector txVector, Time psduDuration)
 {
@@ -2473,6 +2562,7 @@ void
 MacLow::DeaggregateAmpduAndReceive (Ptr<WifiPsdu> psdu, double rxSnr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
 {
   NS_LOG_FUNCTION (this);
+  WifiProfiler::Scope profile (WifiProfiler::MAC_LOW_RECEIVE);
   bool normalAck = false;
   bool ampduSubframe = txVector.IsAggregation (); //flag indicating the packet belongs to an A-MPDU and is not a VHT/HE single MPDU
   //statusPerMpdu is empty for intermediate MPDU forwarding.
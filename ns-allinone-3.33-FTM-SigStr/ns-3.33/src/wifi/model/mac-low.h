@@ -238,6 +238,28 @@ public:
    */
   bool IsWithinSizeAndTimeLimits (uint32_t mpduSize, Mac48Address receiver, uint8_t tid,
                                   WifiTxVector txVector, uint32_t ampduSize, Time ppduDurationLimit);
+  /**
+   * Start planning an A-MPDU destined to the given receiver and belonging to
+   * the given TID, to be transmitted according to the given TX vector within
+   * the given PPDU duration limit. Until StopAmpduPlanning is called, the checks
+   * performed by IsWithinSizeAndTimeLimits for the same receiver, TID, TX vector
+   * and duration limit retrieve the maximum A-MPDU size only once. Also, the
+   * largest PSDU size meeting the duration limits is computed (by bisection)
+   * the first time an MPDU is to be aggregated to an existing A-MPDU, so that
+   * the following checks reduce to a size comparison instead of calculating the
+   * transmission time of every candidate A-MPDU.
+   *
+   * \param receiver the receiver of the A-MPDU
+   * \param tid the TID of the A-MPDU
+   * \param txVector the TX vector used to transmit the A-MPDU
+   * \param ppduDurationLimit the limit on the PPDU duration
+   */
+  void StartAmpduPlanning (Mac48Address receiver, uint8_t tid, WifiTxVector txVector,
+                           Time ppduDurationLimit);
+  /**
+   * Stop planning the A-MPDU whose planning was started by StartAmpduPlanning.
+   */
+  void StopAmpduPlanning (void);
   /**
    * \param packet to send (does not include the 802.11 MAC header and checksum)
    * \param hdr header associated to the packet to send.
@@ -829,6 +851,43 @@ private:
   Ptr<WifiRemoteStationManager> m_stationManager; //!< Pointer to WifiRemoteStationManager (rate control)
   MacLowRxCallback m_rxCallback; //!< Callback to pass packet up
 
+  /**
+   * Check whether the transmission time of a PSDU of the given size, transmitted
+   * according to the given TX vector, exceeds neither the max PPDU duration
+   * (depending on the PPDU format) nor the given PPDU duration limit (if strictly
+   * positive).
+   *
+   * \param psduSize the PSDU size
+   * \param txVector the TX vector used to transmit the PSDU
+   * \param ppduDurationLimit the limit on the PPDU duration
+   * \returns true if the constraint on the duration is met
+   */
+  bool IsWithinTimeLimits (uint32_t psduSize, WifiTxVector txVector, Time ppduDurationLimit) const;
+  /**
+   * \param receiver the receiver
+   * \param tid the TID
+   * \param txVector the TX vector
+   * \param ppduDurationLimit the limit on the PPDU duration
+   * \returns true if an A-MPDU planning is ongoing for the given parameters
+   */
+  bool IsAmpduPlanned (Mac48Address receiver, uint8_t tid, const WifiTxVector &txVector,
+                       Time ppduDurationLimit) const;
+
+  /**
+   * A struct that holds the limits of the A-MPDU being planned.
+   */
+  struct AmpduPlan
+  {
+    bool active;              //!< Flag whether an A-MPDU planning is ongoing
+    Mac48Address receiver;    //!< Receiver of the A-MPDU
+    uint8_t tid;              //!< TID of the A-MPDU
+    WifiTxVector txVector;    //!< TX vector used to transmit the A-MPDU
+    Time ppduDurationLimit;   //!< Limit on the PPDU duration
+    uint32_t maxAmpduSize;    //!< Maximum A-MPDU size
+    bool maxPsduSizeValid;    //!< Flag whether maxPsduSize has been computed
+    uint32_t maxPsduSize;     //!< Largest PSDU size meeting the duration limits
+  };
+
   /**
    * A struct that holds information about Ack piggybacking (CF-Ack).
    */
@@ -906,6 +965,7 @@ private:
   WifiTxVector m_currentTxVector;        //!< TXVECTOR used for the current packet transmission
 
   CfAckInfo m_cfAckInfo; //!< Info about piggyback Acks used in PCF
+  AmpduPlan m_ampduPlan; //!< Limits of the A-MPDU being planned
 };
 
 } //namespace ns3
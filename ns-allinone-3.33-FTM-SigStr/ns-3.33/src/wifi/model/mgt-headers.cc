@@ -1212,6 +1212,12 @@ WifiActionHeader::SetAction (WifiActionHeader::CategoryValue type,
     }
 }
 
+uint8_t
+WifiActionHeader::GetActionField (void) const
+{
+  return m_actionValue;
+}
+
 WifiActionHeader::CategoryValue
 WifiActionHeader::GetCategory ()
 {
@@ -977,6 +977,12 @@ public:
    * \return ActionValue
    */
   ActionValue GetAction ();
+  /**
+   * Return the raw action field, whose meaning depends on the category.
+   *
+   * \return the action field
+   */
+  uint8_t GetActionField (void) const;
 
   /**
    * Register this type.
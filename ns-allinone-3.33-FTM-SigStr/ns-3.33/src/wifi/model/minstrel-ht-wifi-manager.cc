@@ -35,6 +35,7 @@
  */
 
 #include <iomanip>
+#include <algorithm>
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
@@ -50,26 +51,6 @@ NS_LOG_COMPONENT_DEFINE ("MinstrelHtWifiManager");
 
 namespace ns3 {
 
-///MinstrelHtWifiRemoteStation structure
-struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
-{
-  uint8_t m_sampleGroup;     //!< The group that the sample rate belongs to.
-
-  uint32_t m_sampleWait;      //!< How many transmission attempts to wait until a new sample.
-  uint32_t m_sampleTries;     //!< Number of sample tries after waiting sampleWait.
-  uint32_t m_sampleCount;     //!< Max number of samples per update interval.
-  uint32_t m_numSamplesSlow;  //!< Number of times a slow rate was sampled.
-
-  uint32_t m_avgAmpduLen;      //!< Average number of MPDUs in an A-MPDU.
-  uint32_t m_ampduLen;         //!< Number of MPDUs in an A-MPDU.
-  uint32_t m_ampduPacketCount; //!< Number of A-MPDUs transmitted.
-
-  McsGroupData m_groupsTable;  //!< Table of groups with stats.
-  bool m_isHt;                 //!< If the station is HT capable.
-
-  std::ofstream m_statsFile;   //!< File where statistics table is written.
-};
-
 NS_OBJECT_ENSURE_REGISTERED (MinstrelHtWifiManager);
 
 TypeId
@@ -394,6 +375,7 @@ MinstrelHtWifiManager::DoCreateStation (void) const
   station->m_avgAmpduLen = 1;
   station->m_ampduLen = 0;
   station->m_ampduPacketCount = 0;
+  station->m_numStatsUpdates = 0;
 
   // If the device supports HT
   if (GetHtSupported ())
@@ -518,7 +500,7 @@ MinstrelHtWifiManager::DoReportDataFailed (WifiRemoteStation *st)
     {
       uint8_t rateId = GetRateId (station->m_txrate);
       uint8_t groupId = GetGroupId (station->m_txrate);
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++; // Increment the attempts counter for the rate used.
+      AddRateAttempts (station, groupId, rateId, 0, 1); // Increment the attempts counter for the rate used.
       UpdateRate (station);
     }
 }
@@ -559,8 +541,7 @@ MinstrelHtWifiManager::DoReportDataOk (WifiRemoteStation *st, double ackSnr, Wif
     {
       uint8_t rateId = GetRateId (station->m_txrate);
       uint8_t groupId = GetGroupId (station->m_txrate);
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess++;
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++;
+      AddRateAttempts (station, groupId, rateId, 1, 1);
 
       UpdatePacketCounters (station, 1, 0);
 
@@ -656,8 +637,7 @@ MinstrelHtWifiManager::DoReportAmpduTxStatus (WifiRemoteStation *st, uint8_t nSu
 
   uint8_t rateId = GetRateId (station->m_txrate);
   uint8_t groupId = GetGroupId (station->m_txrate);
-  station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess += nSuccessfulMpdus;
-  station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt += nSuccessfulMpdus + nFailedMpdus;
+  AddRateAttempts (station, groupId, rateId, nSuccessfulMpdus, nSuccessfulMpdus + nFailedMpdus);
 
   if (nSuccessfulMpdus == 0 && station->m_longRetry < CountRetries (station))
     {
@@ -1128,7 +1108,7 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
               else
                 {
                   station->m_numSamplesSlow++;
-                  if (sampleRateInfo.numSamplesSkipped >= 20 && station->m_numSamplesSlow <= 2)
+                  if (GetNumSkippedUpdates (station, sampleIdx) >= 20 && station->m_numSamplesSlow <= 2)
                     {
                       /// Set flag that we are currently sampling.
                       station->m_isSampling = true;
@@ -1163,6 +1143,7 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
 
   station->m_numSamplesSlow = 0;
   station->m_sampleCount = 0;
+  station->m_numStatsUpdates++;
 
   double tempProb;
 
@@ -1179,80 +1160,99 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
   station->m_maxTpRate2 = GetLowestIndex (station);
   station->m_maxProbRate = GetLowestIndex (station);
 
-  /// Update throughput and EWMA for each rate inside each group.
+  /// (Re)Initialize the rate indexes of the supported groups.
   for (uint8_t j = 0; j < m_numGroups; j++)
     {
       if (station->m_groupsTable[j].m_supported)
         {
           station->m_sampleCount++;
 
-          /* (re)Initialize group rate indexes */
           station->m_groupsTable[j].m_maxTpRate = GetLowestIndex (station, j);
           station->m_groupsTable[j].m_maxTpRate2 = GetLowestIndex (station, j);
           station->m_groupsTable[j].m_maxProbRate = GetLowestIndex (station, j);
+        }
+    }
 
-          for (uint8_t i = 0; i < m_numRates; i++)
-            {
-              if (station->m_groupsTable[j].m_ratesTable[i].supported)
-                {
-                  station->m_groupsTable[j].m_ratesTable[i].retryUpdated = false;
+  /// Rates which have not been attempted keep their statistics, so only the
+  /// bookkeeping of the rates touched during the previous interval is reset.
+  for (uint16_t index : station->m_prevSampledRates)
+    {
+      HtRateInfo &rate = station->m_groupsTable[GetGroupId (index)].m_ratesTable[GetRateId (index)];
+      rate.prevNumRateSuccess = 0;
+      rate.prevNumRateAttempt = 0;
+    }
+  for (uint16_t index : station->m_retryUpdatedRates)
+    {
+      station->m_groupsTable[GetGroupId (index)].m_ratesTable[GetRateId (index)].retryUpdated = false;
+    }
+  station->m_retryUpdatedRates.clear ();
 
-                  NS_LOG_DEBUG (+i << " " << GetMcsSupported (station, station->m_groupsTable[j].m_ratesTable[i].mcsIndex) <<
-                                "\t attempt=" << station->m_groupsTable[j].m_ratesTable[i].numRateAttempt <<
-                                "\t success=" << station->m_groupsTable[j].m_ratesTable[i].numRateSuccess);
+  /// Update throughput and EWMA for each rate attempted since the last update.
+  for (uint16_t index : station->m_sampledRates)
+    {
+      uint8_t j = GetGroupId (index);
+      uint8_t i = GetRateId (index);
+      HtRateInfo &rate = station->m_groupsTable[j].m_ratesTable[i];
+      NS_ASSERT (station->m_groupsTable[j].m_supported && rate.supported && rate.numRateAttempt > 0);
 
-                  /// If we've attempted something.
-                  if (station->m_groupsTable[j].m_ratesTable[i].numRateAttempt > 0)
-                    {
-                      station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped = 0;
-                      /**
-                       * Calculate the probability of success.
-                       * Assume probability scales from 0 to 100.
-                       */
-                      tempProb = (100 * station->m_groupsTable[j].m_ratesTable[i].numRateSuccess) / station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
+      NS_LOG_DEBUG (+i << " " << GetMcsSupported (station, rate.mcsIndex) <<
+                    "\t attempt=" << rate.numRateAttempt <<
+                    "\t success=" << rate.numRateSuccess);
 
-                      /// Bookkeeping.
-                      station->m_groupsTable[j].m_ratesTable[i].prob = tempProb;
+      rate.lastStatsUpdate = station->m_numStatsUpdates;
+      /**
+       * Calculate the probability of success.
+       * Assume probability scales from 0 to 100.
+       */
+      tempProb = (100 * rate.numRateSuccess) / rate.numRateAttempt;
 
-                      if (station->m_groupsTable[j].m_ratesTable[i].successHist == 0)
-                        {
-                          station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-                      else
-                        {
-                          station->m_groupsTable[j].m_ratesTable[i].ewmsdProb = CalculateEwmsd (station->m_groupsTable[j].m_ratesTable[i].ewmsdProb,
-                                                                                                tempProb, station->m_groupsTable[j].m_ratesTable[i].ewmaProb,
-                                                                                                m_ewmaLevel);
-                          /// EWMA probability
-                          tempProb = (tempProb * (100 - m_ewmaLevel) + station->m_groupsTable[j].m_ratesTable[i].ewmaProb * m_ewmaLevel)  / 100;
-                          station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
+      /// Bookkeeping.
+      rate.prob = tempProb;
 
-                      station->m_groupsTable[j].m_ratesTable[i].throughput = CalculateThroughput (station, j, i, tempProb);
+      if (rate.successHist == 0)
+        {
+          rate.ewmaProb = tempProb;
+        }
+      else
+        {
+          rate.ewmsdProb = CalculateEwmsd (rate.ewmsdProb, tempProb, rate.ewmaProb, m_ewmaLevel);
+          /// EWMA probability
+          tempProb = (tempProb * (100 - m_ewmaLevel) + rate.ewmaProb * m_ewmaLevel)  / 100;
+          rate.ewmaProb = tempProb;
+        }
 
-                      station->m_groupsTable[j].m_ratesTable[i].successHist += station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                      station->m_groupsTable[j].m_ratesTable[i].attemptHist += station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    }
-                  else
-                    {
-                      station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped++;
-                    }
+      bool hadThroughput = (rate.throughput != 0);
+      rate.throughput = CalculateThroughput (station, j, i, tempProb);
+      if (hadThroughput != (rate.throughput != 0))
+        {
+          auto it = std::lower_bound (station->m_tpRates.begin (), station->m_tpRates.end (), index);
+          if (hadThroughput)
+            {
+              station->m_tpRates.erase (it);
+            }
+          else
+            {
+              station->m_tpRates.insert (it, index);
+            }
+        }
 
-                  /// Bookkeeping.
-                  station->m_groupsTable[j].m_ratesTable[i].prevNumRateSuccess = station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                  station->m_groupsTable[j].m_ratesTable[i].prevNumRateAttempt = station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                  station->m_groupsTable[j].m_ratesTable[i].numRateSuccess = 0;
-                  station->m_groupsTable[j].m_ratesTable[i].numRateAttempt = 0;
+      rate.successHist += rate.numRateSuccess;
+      rate.attemptHist += rate.numRateAttempt;
 
-                  if (station->m_groupsTable[j].m_ratesTable[i].throughput != 0)
-                    {
-                      SetBestStationThRates (station, GetIndex (j, i));
-                      SetBestProbabilityRate (station, GetIndex (j, i));
-                    }
+      /// Bookkeeping.
+      rate.prevNumRateSuccess = rate.numRateSuccess;
+      rate.prevNumRateAttempt = rate.numRateAttempt;
+      rate.numRateSuccess = 0;
+      rate.numRateAttempt = 0;
+    }
+  station->m_prevSampledRates.swap (station->m_sampledRates);
+  station->m_sampledRates.clear ();
 
-                }
-            }
-        }
+  /// Select the best rates, in increasing index order.
+  for (uint16_t index : station->m_tpRates)
+    {
+      SetBestStationThRates (station, index);
+      SetBestProbabilityRate (station, index);
     }
 
   //Try to sample all available rates during each interval.
@@ -1270,6 +1270,19 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
     }
 }
 
+void
+MinstrelHtWifiManager::AddRateAttempts (MinstrelHtWifiRemoteStation *station, uint8_t groupId, uint8_t rateId,
+                                        uint32_t nSuccessful, uint32_t nAttempts)
+{
+  HtRateInfo &rate = station->m_groupsTable[groupId].m_ratesTable[rateId];
+  if (rate.numRateAttempt == 0 && nAttempts > 0)
+    {
+      station->m_sampledRates.push_back (GetIndex (groupId, rateId));
+    }
+  rate.numRateSuccess += nSuccessful;
+  rate.numRateAttempt += nAttempts;
+}
+
 double
 MinstrelHtWifiManager::CalculateThroughput (MinstrelHtWifiRemoteStation *station, uint8_t groupId, uint8_t rateId, double ewmaProb)
 {
@@ -1426,6 +1439,10 @@ MinstrelHtWifiManager::RateInit (MinstrelHtWifiRemoteStation *station)
   NS_LOG_FUNCTION (this << station);
 
   station->m_groupsTable = McsGroupData (m_numGroups);
+  station->m_sampledRates.clear ();
+  station->m_prevSampledRates.clear ();
+  station->m_tpRates.clear ();
+  station->m_retryUpdatedRates.clear ();
 
   /**
   * Initialize groups supported by the receiver.
@@ -1484,7 +1501,7 @@ MinstrelHtWifiManager::RateInit (MinstrelHtWifiRemoteStation *station)
                       station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb = 0;
                       station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateAttempt = 0;
                       station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateSuccess = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].numSamplesSkipped = 0;
+                      station->m_groupsTable[groupId].m_ratesTable[rateId].lastStatsUpdate = station->m_numStatsUpdates;
                       station->m_groupsTable[groupId].m_ratesTable[rateId].successHist = 0;
                       station->m_groupsTable[groupId].m_ratesTable[rateId].attemptHist = 0;
                       station->m_groupsTable[groupId].m_ratesTable[rateId].throughput = 0;
@@ -1532,6 +1549,10 @@ MinstrelHtWifiManager::CalculateRetransmits (MinstrelHtWifiRemoteStation *statio
   else
     {
       station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 2;
+      if (!station->m_groupsTable[groupId].m_ratesTable[rateId].retryUpdated)
+        {
+          station->m_retryUpdatedRates.push_back (GetIndex (groupId, rateId));
+        }
       station->m_groupsTable[groupId].m_ratesTable[rateId].retryUpdated = true;
 
       dataTxTime = GetFirstMpduTxTime (groupId, GetMcsSupported (station, station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex)) +
@@ -1726,6 +1747,13 @@ MinstrelHtWifiManager::GetIndex (uint8_t groupId, uint8_t rateId)
   return index;
 }
 
+uint32_t
+MinstrelHtWifiManager::GetNumSkippedUpdates (MinstrelHtWifiRemoteStation *station, uint16_t index)
+{
+  NS_LOG_FUNCTION (this << station << index);
+  return station->m_numStatsUpdates - station->m_groupsTable[GetGroupId (index)].m_ratesTable[GetRateId (index)].lastStatsUpdate;
+}
+
 uint8_t
 MinstrelHtWifiManager::GetRateId (uint16_t index)
 {
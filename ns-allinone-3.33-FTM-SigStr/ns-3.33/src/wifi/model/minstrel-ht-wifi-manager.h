@@ -30,6 +30,8 @@
 #include "minstrel-wifi-manager.h"
 #include "wifi-mpdu-type.h"
 
+class MinstrelHtStatsTest;
+
 namespace ns3 {
 
 /**
@@ -62,7 +64,6 @@ struct McsGroup
  */
 typedef std::vector<McsGroup> MinstrelMcsGroups;
 
-struct MinstrelHtWifiRemoteStation;
 /**
  * A struct to contain all statistics information related to a data rate.
  */
@@ -90,7 +91,7 @@ struct HtRateInfo
   double ewmsdProb;             //!< Exponential weighted moving standard deviation of probability.
   uint32_t prevNumRateAttempt;  //!< Number of transmission attempts with previous rate.
   uint32_t prevNumRateSuccess;  //!< Number of successful frames transmitted with previous rate.
-  uint32_t numSamplesSkipped;   //!< Number of times this rate statistics were not updated because no attempts have been made.
+  uint32_t lastStatsUpdate;     //!< Value of the station statistics update counter when this rate was last attempted.
   uint64_t successHist;         //!< Aggregate of all transmission successes.
   uint64_t attemptHist;         //!< Aggregate of all transmission attempts.
   double throughput;            //!< Throughput of this rate (in packets per second).
@@ -125,6 +126,36 @@ struct GroupInfo
  */
 typedef std::vector<struct GroupInfo> McsGroupData;
 
+/**
+ * \brief hold per-remote-station state for Minstrel-HT Wifi manager.
+ *
+ * This struct extends from MinstrelWifiRemoteStation struct to hold additional
+ * information required by the Minstrel-HT Wifi manager
+ */
+struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
+{
+  uint8_t m_sampleGroup;     //!< The group that the sample rate belongs to.
+
+  uint32_t m_sampleWait;      //!< How many transmission attempts to wait until a new sample.
+  uint32_t m_sampleTries;     //!< Number of sample tries after waiting sampleWait.
+  uint32_t m_sampleCount;     //!< Max number of samples per update interval.
+  uint32_t m_numSamplesSlow;  //!< Number of times a slow rate was sampled.
+
+  uint32_t m_avgAmpduLen;      //!< Average number of MPDUs in an A-MPDU.
+  uint32_t m_ampduLen;         //!< Number of MPDUs in an A-MPDU.
+  uint32_t m_ampduPacketCount; //!< Number of A-MPDUs transmitted.
+
+  McsGroupData m_groupsTable;  //!< Table of groups with stats.
+  uint32_t m_numStatsUpdates;  //!< Number of statistics updates so far.
+  std::vector<uint16_t> m_sampledRates;      //!< Rates attempted since the last statistics update.
+  std::vector<uint16_t> m_prevSampledRates;  //!< Rates attempted in the previous statistics update interval.
+  std::vector<uint16_t> m_tpRates;           //!< Rates with a non-zero throughput, in increasing index order.
+  std::vector<uint16_t> m_retryUpdatedRates; //!< Rates whose retry count has been updated since the last statistics update.
+  bool m_isHt;                 //!< If the station is HT capable.
+
+  std::ofstream m_statsFile;   //!< File where statistics table is written.
+};
+
 /**
  * Constants for maximum values.
  */
@@ -188,6 +219,9 @@ static const uint8_t MAX_VHT_WIDTH = 160;        //!< Maximal channel width in M
 class MinstrelHtWifiManager : public WifiRemoteStationManager
 {
 public:
+  /// allow MinstrelHtStatsTest class access
+  friend class ::MinstrelHtStatsTest;
+
   /**
    * \brief Get the type ID.
    * \return the object TypeId
@@ -315,6 +349,19 @@ private:
    */
   void UpdatePacketCounters (MinstrelHtWifiRemoteStation *station, uint8_t nSuccessfulMpdus, uint8_t nFailedMpdus);
 
+  /**
+   * Add transmission attempts to the statistics of a rate, recording the rate
+   * as sampled if it had no attempts since the last statistics update.
+   *
+   * \param station the wifi remote station
+   * \param groupId the group ID
+   * \param rateId the rate ID
+   * \param nSuccessful the number of successful transmissions
+   * \param nAttempts the number of transmission attempts
+   */
+  void AddRateAttempts (MinstrelHtWifiRemoteStation *station, uint8_t groupId, uint8_t rateId,
+                        uint32_t nSuccessful, uint32_t nAttempts);
+
   /**
    * Getting the next sample from Sample Table.
    *
@@ -341,6 +388,10 @@ private:
   /**
    * Update the Minstrel Table.
    *
+   * Only the rates attempted since the previous update have their
+   * statistics recomputed; the best rates are then selected among the
+   * rates with a non-zero throughput.
+   *
    * \param station the minstrel HT wifi remote station
    */
   void UpdateStats (MinstrelHtWifiRemoteStation *station);
@@ -518,6 +569,16 @@ private:
    */
   uint16_t GetIndex (uint8_t groupId, uint8_t rateId);
 
+  /**
+   * Returns the number of statistics updates since the rate was last
+   * attempted, or since the station was initialized if it never was.
+   *
+   * \param station the minstrel HT wifi remote station
+   * \param index the global index of the rate
+   * \returns the number of statistics updates skipped by the rate
+   */
+  uint32_t GetNumSkippedUpdates (MinstrelHtWifiRemoteStation *station, uint16_t index);
+
   /**
    * Returns the groupId of a HT MCS with the given number of streams, if using SGI and the channel width used.
    *
@@ -37,6 +37,7 @@
 #include "wifi-mac.h"
 #include "ctrl-headers.h"
 #include "wifi-mac-trailer.h"
+#include "wifi-profiler.h"
 
 NS_LOG_COMPONENT_DEFINE ("MpduAggregator");
 
@@ -210,6 +211,7 @@ MpduAggregator::GetNextAmpdu (Ptr<const WifiMacQueueItem> mpdu, WifiTxVector txV
                               Time ppduDurationLimit) const
 {
   NS_LOG_FUNCTION (this << *mpdu << ppduDurationLimit);
+  WifiProfiler::Scope profile (WifiProfiler::AGGREGATION);
   std::vector<Ptr<WifiMacQueueItem>> mpduList;
   Mac48Address recipient = mpdu->GetHeader ().GetAddr1 ();
 
@@ -236,9 +238,11 @@ MpduAggregator::GetNextAmpdu (Ptr<const WifiMacQueueItem> mpdu, WifiTxVector txV
       Ptr<WifiMacQueueItem> nextMpdu;
       uint16_t maxMpdus = edcaIt->second->GetBaBufferSize (recipient, tid);
       uint32_t currentAmpduSize = 0;
+      Ptr<MacLow> low = edcaIt->second->GetLow ();
+      low->StartAmpduPlanning (recipient, tid, txVector, ppduDurationLimit);
 
       // check if the received MPDU meets the size and duration constraints
-      if (edcaIt->second->GetLow ()->IsWithinSizeAndTimeLimits (mpdu, txVector, 0, ppduDurationLimit))
+      if (low->IsWithinSizeAndTimeLimits (mpdu, txVector, 0, ppduDurationLimit))
         {
           // MPDU can be aggregated
           nextMpdu = Copy (mpdu);
@@ -287,6 +291,8 @@ MpduAggregator::GetNextAmpdu (Ptr<const WifiMacQueueItem> mpdu, WifiTxVector txV
                 }
             }
         }
+      low->StopAmpduPlanning ();
+
       if (mpduList.size () == 1)
         {
           // return an empty vector if it was not possible to aggregate at least two MPDUs
@@ -33,6 +33,7 @@
 #include "wifi-mac.h"
 #include "wifi-mac-queue.h"
 #include "wifi-mac-trailer.h"
+#include "wifi-profiler.h"
 #include <algorithm>
 
 namespace ns3 {
@@ -81,6 +82,7 @@ MsduAggregator::GetNextAmsdu (Mac48Address recipient, uint8_t tid,
                               Time ppduDurationLimit) const
 {
   NS_LOG_FUNCTION (recipient << +tid << txVector << ampduSize << ppduDurationLimit);
+  WifiProfiler::Scope profile (WifiProfiler::AGGREGATION);
 
   /* "The Address 1 field of an MPDU carrying an A-MSDU shall be set to an
    * individual address or to the GCR concealment address" (Section 10.12
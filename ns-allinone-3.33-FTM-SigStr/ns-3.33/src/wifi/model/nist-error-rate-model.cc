@@ -22,6 +22,7 @@
 #include <cmath>
 #include <bitset>
 #include "ns3/log.h"
+#include "ns3/pointer.h"
 #include "nist-error-rate-model.h"
 #include "wifi-tx-vector.h"
 
@@ -38,6 +39,12 @@ NistErrorRateModel::GetTypeId (void)
     .SetParent<ErrorRateModel> ()
     .SetGroupName ("Wifi")
     .AddConstructor<NistErrorRateModel> ()
+    .AddAttribute ("LookupTable",
+                   "If set, chunk success rates are interpolated from SNR tables built "
+                   "from this model instead of being computed analytically for every chunk.",
+                   PointerValue (),
+                   MakePointerAccessor (&NistErrorRateModel::m_lookupTable),
+                   MakePointerChecker<ErrorRateLookupTable> ())
   ;
   return tid;
 }
@@ -218,6 +225,22 @@ NistErrorRateModel::GetBValue (WifiCodeRate codeRate) const
 
 double
 NistErrorRateModel::DoGetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
+  NS_LOG_FUNCTION (this << mode << snr << nbits);
+  if (m_lookupTable)
+    {
+      ErrorRateLookupTable::Key key = std::make_tuple (GetInstanceTypeId ().GetUid (), mode.GetUid (), 0, 0);
+      return m_lookupTable->GetChunkSuccessRate (key, snr, nbits,
+                                                 [this, &mode, &txVector] (double s, uint64_t n)
+                                                 {
+                                                   return CalculateChunkSuccessRate (mode, txVector, s, n);
+                                                 });
+    }
+  return CalculateChunkSuccessRate (mode, txVector, snr, nbits);
+}
+
+double
+NistErrorRateModel::CalculateChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
 {
   NS_LOG_FUNCTION (this << mode << snr << nbits);
   if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM
@@ -22,6 +22,7 @@
 #define NIST_ERROR_RATE_MODEL_H
 
 #include "error-rate-model.h"
+#include "error-rate-lookup-table.h"
 #include "wifi-mode.h"
 
 namespace ns3 {
@@ -49,6 +50,17 @@ public:
 private:
   //Inherited from ErrorRateModel
   double DoGetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+  /**
+   * Compute the chunk success rate from the analytic model.
+   *
+   * \param mode the Wi-Fi mode applicable to this chunk
+   * \param txVector TXVECTOR of the overall transmission
+   * \param snr the SNR of the chunk
+   * \param nbits the number of bits in this chunk
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  double CalculateChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
   /**
    * Return the bValue such that coding rate = bValue / (bValue + 1).
    *
@@ -121,6 +133,8 @@ private:
    * \return BER of QAM for a given constellation size at the given SNR after applying FEC
    */
   double GetFecQamBer (uint16_t constellationSize, double snr, uint64_t nbits, uint8_t bValue) const;
+
+  Ptr<ErrorRateLookupTable> m_lookupTable; //!< Optional SNR lookup table replacing the analytic computation
 };
 
 } //namespace ns3
@@ -101,10 +101,7 @@ OriginatorBlockAckAgreement::InitTxWindow (void)
 void
 OriginatorBlockAckAgreement::AdvanceTxWindow (void)
 {
-  while (m_txWindow.At (0))
-    {
-      m_txWindow.Advance (1); // reset the current head -- ensures loop termination
-    }
+  m_txWindow.Advance (m_txWindow.GetNConsecutiveSet ());
 }
 
 void
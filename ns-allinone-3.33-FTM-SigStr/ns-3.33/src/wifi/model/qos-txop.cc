@@ -1151,7 +1151,7 @@ QosTxop::TerminateTxop (void)
     {
       NS_LOG_DEBUG ("Terminating TXOP. Duration = " << Simulator::Now () - m_startTxop);
     }
-  m_txopTrace (m_startTxop, Simulator::Now () - m_startTxop);
+  NS_TRACE (m_txopTrace, m_startTxop, Simulator::Now () - m_startTxop);
   GenerateBackoff ();
   RestartAccessIfNeeded ();
 }
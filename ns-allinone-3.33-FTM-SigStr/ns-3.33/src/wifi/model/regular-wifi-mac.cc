@@ -69,6 +69,17 @@ RegularWifiMac::RegularWifiMac ()
   m_txop->SetTxFailedCallback (MakeCallback (&RegularWifiMac::TxFailed, this));
   m_txop->SetTxDroppedCallback (MakeCallback (&RegularWifiMac::NotifyTxDrop, this));
 
+  WifiActionHeader::ActionValue action;
+  action.blockAck = WifiActionHeader::BLOCK_ACK_ADDBA_REQUEST;
+  SetActionFrameHandler (WifiActionHeader::BLOCK_ACK, action.blockAck,
+                         MakeCallback (&RegularWifiMac::ReceiveAddBaRequest, this));
+  action.blockAck = WifiActionHeader::BLOCK_ACK_ADDBA_RESPONSE;
+  SetActionFrameHandler (WifiActionHeader::BLOCK_ACK, action.blockAck,
+                         MakeCallback (&RegularWifiMac::ReceiveAddBaResponse, this));
+  action.blockAck = WifiActionHeader::BLOCK_ACK_DELBA;
+  SetActionFrameHandler (WifiActionHeader::BLOCK_ACK, action.blockAck,
+                         MakeCallback (&RegularWifiMac::ReceiveDelBa, this));
+
   //Construct the EDCAFs. The ordering is important - highest
   //priority (Table 9-1 UP-to-AC mapping; IEEE 802.11-2012) must be created
   //first.
@@ -126,6 +137,7 @@ RegularWifiMac::DoDispose ()
   m_channelAccessManager = 0;
   
   m_ftm_manager = 0;
+  m_actionFrameHandlers.clear ();
 
   WifiMac::DoDispose ();
 }
@@ -709,7 +721,6 @@ RegularWifiMac::Receive (Ptr<WifiMacQueueItem> mpdu)
   const WifiMacHeader* hdr = &mpdu->GetHeader ();
   Ptr<Packet> packet = mpdu->GetPacket ()->Copy ();
   Mac48Address to = hdr->GetAddr1 ();
-  Mac48Address from = hdr->GetAddr2 ();
 
   //We don't know how to deal with any frame that is not addressed to
   //us (and odds are there is nothing sensible we could do anyway),
@@ -724,110 +735,112 @@ RegularWifiMac::Receive (Ptr<WifiMacQueueItem> mpdu)
 
   if (hdr->IsMgt () && hdr->IsAction ())
     {
-      //There is currently only any reason for Management Action
-      //frames to be flying about if we are a QoS STA.
-      //FTM does not need QoS to transmit its frames, moved to blockAck case
-//      NS_ASSERT (m_qosSupported);
-
       WifiActionHeader actionHdr;
       packet->RemoveHeader (actionHdr);
-
-      switch (actionHdr.GetCategory ())
+      ActionFrameHandlers::const_iterator it = m_actionFrameHandlers.find (std::make_pair (actionHdr.GetCategory (),
+                                                                                         actionHdr.GetActionField ()));
+      if (it == m_actionFrameHandlers.end ())
         {
-        case WifiActionHeader::BLOCK_ACK:
-          {
-          NS_ASSERT (m_qosSupported);
-          switch (actionHdr.GetAction ().blockAck)
-            {
-            case WifiActionHeader::BLOCK_ACK_ADDBA_REQUEST:
-              {
-                MgtAddBaRequestHeader reqHdr;
-                packet->RemoveHeader (reqHdr);
-
-                //We've received an ADDBA Request. Our policy here is
-                //to automatically accept it, so we get the ADDBA
-                //Response on it's way immediately.
-                SendAddBaResponse (&reqHdr, from);
-                //This frame is now completely dealt with, so we're done.
-                return;
-              }
-            case WifiActionHeader::BLOCK_ACK_ADDBA_RESPONSE:
-              {
-                MgtAddBaResponseHeader respHdr;
-                packet->RemoveHeader (respHdr);
-
-                //We've received an ADDBA Response. We assume that it
-                //indicates success after an ADDBA Request we have
-                //sent (we could, in principle, check this, but it
-                //seems a waste given the level of the current model)
-                //and act by locally establishing the agreement on
-                //the appropriate queue.
-                AcIndex ac = QosUtilsMapTidToAc (respHdr.GetTid ());
-                m_edca[ac]->GotAddBaResponse (&respHdr, from);
-                //This frame is now completely dealt with, so we're done.
-                return;
-              }
-            case WifiActionHeader::BLOCK_ACK_DELBA:
-              {
-                MgtDelBaHeader delBaHdr;
-                packet->RemoveHeader (delBaHdr);
-
-                if (delBaHdr.IsByOriginator ())
-                  {
-                    //This DELBA frame was sent by the originator, so
-                    //this means that an ingoing established
-                    //agreement exists in MacLow and we need to
-                    //destroy it.
-                    m_low->DestroyBlockAckAgreement (from, delBaHdr.GetTid ());
-                  }
-                else
-                  {
-                    //We must have been the originator. We need to
-                    //tell the correct queue that the agreement has
-                    //been torn down
-                    AcIndex ac = QosUtilsMapTidToAc (delBaHdr.GetTid ());
-                    m_edca[ac]->GotDelBaFrame (&delBaHdr, from);
-                  }
-                //This frame is now completely dealt with, so we're done.
-                return;
-              }
-            default:
-              NS_FATAL_ERROR ("Unsupported Action field in Block Ack Action frame");
-              return;
-            }
-          }
-        case WifiActionHeader::PUBLIC_ACTION: //Take care of FTM frames.
-          {
-            NS_ASSERT_MSG (m_ftm_enabled, "Received Public Action frame but FTM is not enabled!");
-            switch (actionHdr.GetAction().publicAction)
-            {
-              case WifiActionHeader::FTM_REQUEST:
-                {
-                  FtmRequestHeader ftm_req;
-                  packet->RemoveHeader (ftm_req);
-                  m_ftm_manager->ReceivedFtmRequest (from, ftm_req);
-                  return;
-                }
-              case WifiActionHeader::FTM_RESPONSE:
-                {
-                  FtmResponseHeader ftm_res;
-                  packet->RemoveHeader (ftm_res);
-                  m_ftm_manager->ReceivedFtmResponse (from, ftm_res);
-                  return;
-                }
-              default:
-                NS_FATAL_ERROR("Unsupported Public Action frame received");
-                return;
-            }
-          }
-        default:
-          NS_FATAL_ERROR ("Unsupported Action frame received");
-          return;
+          NS_FATAL_ERROR ("Unsupported Action frame received (category=" << +actionHdr.GetCategory ()
+                          << ", action=" << +actionHdr.GetActionField () << ")");
         }
+      it->second (packet, *hdr);
+      return;
     }
   NS_FATAL_ERROR ("Don't know how to handle frame (type=" << hdr->GetType ());
 }
 
+void
+RegularWifiMac::SetActionFrameHandler (WifiActionHeader::CategoryValue category, uint8_t action,
+                                       ActionFrameHandler handler)
+{
+  NS_LOG_FUNCTION (this << category << +action);
+  if (handler.IsNull ())
+    {
+      m_actionFrameHandlers.erase (std::make_pair (category, action));
+    }
+  else
+    {
+      m_actionFrameHandlers[std::make_pair (category, action)] = handler;
+    }
+}
+
+void
+RegularWifiMac::ReceiveAddBaRequest (Ptr<Packet> packet, const WifiMacHeader &hdr)
+{
+  NS_LOG_FUNCTION (this << packet << hdr);
+  NS_ASSERT (m_qosSupported);
+  MgtAddBaRequestHeader reqHdr;
+  packet->RemoveHeader (reqHdr);
+
+  //We've received an ADDBA Request. Our policy here is
+  //to automatically accept it, so we get the ADDBA
+  //Response on it's way immediately.
+  SendAddBaResponse (&reqHdr, hdr.GetAddr2 ());
+}
+
+void
+RegularWifiMac::ReceiveAddBaResponse (Ptr<Packet> packet, const WifiMacHeader &hdr)
+{
+  NS_LOG_FUNCTION (this << packet << hdr);
+  NS_ASSERT (m_qosSupported);
+  MgtAddBaResponseHeader respHdr;
+  packet->RemoveHeader (respHdr);
+
+  //We've received an ADDBA Response. We assume that it
+  //indicates success after an ADDBA Request we have
+  //sent (we could, in principle, check this, but it
+  //seems a waste given the level of the current model)
+  //and act by locally establishing the agreement on
+  //the appropriate queue.
+  AcIndex ac = QosUtilsMapTidToAc (respHdr.GetTid ());
+  m_edca[ac]->GotAddBaResponse (&respHdr, hdr.GetAddr2 ());
+}
+
+void
+RegularWifiMac::ReceiveDelBa (Ptr<Packet> packet, const WifiMacHeader &hdr)
+{
+  NS_LOG_FUNCTION (this << packet << hdr);
+  NS_ASSERT (m_qosSupported);
+  MgtDelBaHeader delBaHdr;
+  packet->RemoveHeader (delBaHdr);
+
+  if (delBaHdr.IsByOriginator ())
+    {
+      //This DELBA frame was sent by the originator, so
+      //this means that an ingoing established
+      //agreement exists in MacLow and we need to
+      //destroy it.
+      m_low->DestroyBlockAckAgreement (hdr.GetAddr2 (), delBaHdr.GetTid ());
+    }
+  else
+    {
+      //We must have been the originator. We need to
+      //tell the correct queue that the agreement has
+      //been torn down
+      AcIndex ac = QosUtilsMapTidToAc (delBaHdr.GetTid ());
+      m_edca[ac]->GotDelBaFrame (&delBaHdr, hdr.GetAddr2 ());
+    }
+}
+
+void
+RegularWifiMac::ReceiveFtmRequest (Ptr<Packet> packet, const WifiMacHeader &hdr)
+{
+  NS_LOG_FUNCTION (this << packet << hdr);
+  FtmRequestHeader ftmReq;
+  packet->RemoveHeader (ftmReq);
+  m_ftm_manager->ReceivedFtmRequest (hdr.GetAddr2 (), ftmReq);
+}
+
+void
+RegularWifiMac::ReceiveFtmResponse (Ptr<Packet> packet, const WifiMacHeader &hdr)
+{
+  NS_LOG_FUNCTION (this << packet << hdr);
+  FtmResponseHeader ftmRes;
+  packet->RemoveHeader (ftmRes);
+  m_ftm_manager->ReceivedFtmResponse (hdr.GetAddr2 (), ftmRes);
+}
+
 void
 RegularWifiMac::DeaggregateAmsduAndForward (Ptr<WifiMacQueueItem> mpdu)
 {
@@ -1213,6 +1226,13 @@ RegularWifiMac::EnableFtm (void)
   m_ftm_enabled = true;
   m_ftm_manager = CreateObject<FtmManager> (GetWifiPhy (), GetTxop ());
   m_ftm_manager->SetMacAddress(GetAddress());
+  WifiActionHeader::ActionValue action;
+  action.publicAction = WifiActionHeader::FTM_REQUEST;
+  SetActionFrameHandler (WifiActionHeader::PUBLIC_ACTION, action.publicAction,
+                         MakeCallback (&RegularWifiMac::ReceiveFtmRequest, this));
+  action.publicAction = WifiActionHeader::FTM_RESPONSE;
+  SetActionFrameHandler (WifiActionHeader::PUBLIC_ACTION, action.publicAction,
+                         MakeCallback (&RegularWifiMac::ReceiveFtmResponse, this));
   Time::Unit resolution = Time::GetResolution();
   if (resolution != Time::PS && resolution != Time::FS)
     {
@@ -1226,6 +1246,11 @@ RegularWifiMac::DisableFtm (void)
   NS_LOG_FUNCTION (this);
   m_ftm_enabled = false;
   m_ftm_manager = 0;
+  WifiActionHeader::ActionValue action;
+  action.publicAction = WifiActionHeader::FTM_REQUEST;
+  SetActionFrameHandler (WifiActionHeader::PUBLIC_ACTION, action.publicAction, MakeNullCallback<void, Ptr<Packet>, const WifiMacHeader &> ());
+  action.publicAction = WifiActionHeader::FTM_RESPONSE;
+  SetActionFrameHandler (WifiActionHeader::PUBLIC_ACTION, action.publicAction, MakeNullCallback<void, Ptr<Packet>, const WifiMacHeader &> ());
 }
 
 Ptr<FtmSession>
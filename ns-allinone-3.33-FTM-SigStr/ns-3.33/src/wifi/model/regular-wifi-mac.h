@@ -25,6 +25,7 @@
 #include "qos-txop.h"
 #include "ssid.h"
 #include "ftm-manager.h"
+#include "mgt-headers.h"
 
 namespace ns3 {
 
@@ -163,6 +164,25 @@ public:
    */
   Ptr<FtmSession> NewFtmSession (Mac48Address partner);
 
+  /**
+   * Handler of a received Action frame. It is given the frame body that
+   * follows the Action header and the MAC header of the frame.
+   */
+  typedef Callback<void, Ptr<Packet>, const WifiMacHeader &> ActionFrameHandler;
+
+  /**
+   * Register the handler of the Action frames with the given category and
+   * action field, replacing the handler previously registered for them, if
+   * any. A null callback unregisters the handler. Receiving an Action frame
+   * for which no handler is registered is a fatal error.
+   *
+   * \param category the category of the Action frames
+   * \param action the action field of the Action frames
+   * \param handler the handler
+   */
+  void SetActionFrameHandler (WifiActionHeader::CategoryValue category, uint8_t action,
+                              ActionFrameHandler handler);
+
 protected:
   virtual void DoInitialize ();
   virtual void DoDispose ();
@@ -461,6 +481,46 @@ private:
   /// Disable aggregation function
   void DisableAggregation (void);
 
+  /**
+   * Handle a received ADDBA Request frame.
+   *
+   * \param packet the frame body following the Action header
+   * \param hdr the MAC header of the frame
+   */
+  void ReceiveAddBaRequest (Ptr<Packet> packet, const WifiMacHeader &hdr);
+  /**
+   * Handle a received ADDBA Response frame.
+   *
+   * \param packet the frame body following the Action header
+   * \param hdr the MAC header of the frame
+   */
+  void ReceiveAddBaResponse (Ptr<Packet> packet, const WifiMacHeader &hdr);
+  /**
+   * Handle a received DELBA frame.
+   *
+   * \param packet the frame body following the Action header
+   * \param hdr the MAC header of the frame
+   */
+  void ReceiveDelBa (Ptr<Packet> packet, const WifiMacHeader &hdr);
+  /**
+   * Handle a received FTM Request frame.
+   *
+   * \param packet the frame body following the Action header
+   * \param hdr the MAC header of the frame
+   */
+  void ReceiveFtmRequest (Ptr<Packet> packet, const WifiMacHeader &hdr);
+  /**
+   * Handle a received FTM Response frame.
+   *
+   * \param packet the frame body following the Action header
+   * \param hdr the MAC header of the frame
+   */
+  void ReceiveFtmResponse (Ptr<Packet> packet, const WifiMacHeader &hdr);
+
+  /// Action frame handlers, indexed by category and action field
+  typedef std::map<std::pair<uint8_t, uint8_t>, ActionFrameHandler> ActionFrameHandlers;
+  ActionFrameHandlers m_actionFrameHandlers; //!< Action frame handlers
+
   uint16_t m_voMaxAmsduSize; ///< maximum A-MSDU size for AC_VO (in bytes)
   uint16_t m_viMaxAmsduSize; ///< maximum A-MSDU size for AC_VI (in bytes)
   uint16_t m_beMaxAmsduSize; ///< maximum A-MSDU size for AC_BE (in bytes)
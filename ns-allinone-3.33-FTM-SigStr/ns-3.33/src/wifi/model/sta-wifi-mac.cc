@@ -501,6 +501,14 @@ StaWifiMac::Enqueue (Ptr<Packet> packet, Mac48Address to)
     }
 }
 
+void
+StaWifiMac::ReceiveAbstractBeacon (Ptr<WifiMacQueueItem> mpdu)
+{
+  NS_LOG_FUNCTION (this << *mpdu);
+  NS_ASSERT (mpdu->GetHeader ().IsBeacon ());
+  Receive (mpdu);
+}
+
 void
 StaWifiMac::Receive (Ptr<WifiMacQueueItem> mpdu)
 {
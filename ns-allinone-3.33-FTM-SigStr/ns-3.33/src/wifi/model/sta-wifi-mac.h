@@ -157,6 +157,14 @@ public:
    */
   uint16_t GetAssociationId (void) const;
 
+  /**
+   * Process a beacon handed over by the AP without going through the PHY
+   * (see the BeaconAbstraction attribute of ApWifiMac).
+   *
+   * \param mpdu the beacon MPDU
+   */
+  void ReceiveAbstractBeacon (Ptr<WifiMacQueueItem> mpdu);
+
 private:
   /**
    * The current MAC state of the STA.
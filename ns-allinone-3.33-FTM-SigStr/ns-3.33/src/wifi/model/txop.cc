@@ -554,7 +554,7 @@ Txop::GenerateBackoff (void)
 {
   NS_LOG_FUNCTION (this);
   m_backoff = m_rng->GetInteger (0, GetCw ());
-  m_backoffTrace (m_backoff);
+  NS_TRACE (m_backoffTrace, m_backoff);
   StartBackoffNow (m_backoff);
 }
 
@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "ns3/assert.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "wifi-mac-header-view.h"
+
+namespace ns3 {
+
+/// offsets of the fixed fields of the MAC header
+enum
+{
+  OFFSET_FRAME_CONTROL = 0,
+  OFFSET_DURATION = 2,
+  OFFSET_ADDR1 = 4,
+  OFFSET_ADDR2 = 10,
+  OFFSET_ADDR3 = 16,
+  OFFSET_SEQUENCE_CONTROL = 22,
+  OFFSET_ADDR4 = 24
+};
+
+const uint32_t WifiMacHeaderView::MAX_SIZE;
+
+WifiMacHeaderView::WifiMacHeaderView (Ptr<const Packet> packet)
+{
+  m_length = packet->CopyData (m_buffer, MAX_SIZE);
+}
+
+WifiMacHeaderView::WifiMacHeaderView (const uint8_t *buffer, uint32_t size)
+  : m_length (std::min (size, MAX_SIZE))
+{
+  std::memcpy (m_buffer, buffer, m_length);
+}
+
+uint16_t
+WifiMacHeaderView::ReadU16 (uint32_t offset) const
+{
+  NS_ASSERT (offset + 2 <= m_length);
+  return static_cast<uint16_t> (m_buffer[offset] | (m_buffer[offset + 1] << 8));
+}
+
+Mac48Address
+WifiMacHeaderView::ReadAddress (uint32_t offset) const
+{
+  NS_ASSERT (offset + 6 <= m_length);
+  Mac48Address address;
+  address.CopyFrom (m_buffer + offset);
+  return address;
+}
+
+bool
+WifiMacHeaderView::IsValid (void) const
+{
+  if (m_length < OFFSET_DURATION)
+    {
+      return false;
+    }
+  uint32_t size = GetSize ();
+  return size > 0 && size <= m_length;
+}
+
+uint32_t
+WifiMacHeaderView::GetSize (void) const
+{
+  WifiMacHeader hdr;
+  hdr.SetFrameControl (GetFrameControl ());
+  return hdr.GetSize ();
+}
+
+uint16_t
+WifiMacHeaderView::GetFrameControl (void) const
+{
+  return ReadU16 (OFFSET_FRAME_CONTROL);
+}
+
+WifiMacType
+WifiMacHeaderView::GetType (void) const
+{
+  WifiMacHeader hdr;
+  hdr.SetFrameControl (GetFrameControl ());
+  return hdr.GetType ();
+}
+
+bool
+WifiMacHeaderView::IsMgt (void) const
+{
+  return ((GetFrameControl () >> 2) & 0x03) == 0;
+}
+
+bool
+WifiMacHeaderView::IsCtl (void) const
+{
+  return ((GetFrameControl () >> 2) & 0x03) == 1;
+}
+
+bool
+WifiMacHeaderView::IsData (void) const
+{
+  return ((GetFrameControl () >> 2) & 0x03) == 2;
+}
+
+bool
+WifiMacHeaderView::IsQosData (void) const
+{
+  return IsData () && ((GetFrameControl () >> 4) & 0x08);
+}
+
+bool
+WifiMacHeaderView::IsAction (void) const
+{
+  return IsMgt () && ((GetFrameControl () >> 4) & 0x0f) == 13;
+}
+
+bool
+WifiMacHeaderView::IsAck (void) const
+{
+  return IsCtl () && ((GetFrameControl () >> 4) & 0x0f) == 13;
+}
+
+bool
+WifiMacHeaderView::IsToDs (void) const
+{
+  return (GetFrameControl () >> 8) & 0x01;
+}
+
+bool
+WifiMacHeaderView::IsFromDs (void) const
+{
+  return (GetFrameControl () >> 9) & 0x01;
+}
+
+bool
+WifiMacHeaderView::IsRetry (void) const
+{
+  return (GetFrameControl () >> 11) & 0x01;
+}
+
+uint16_t
+WifiMacHeaderView::GetRawDuration (void) const
+{
+  return ReadU16 (OFFSET_DURATION);
+}
+
+Time
+WifiMacHeaderView::GetDuration (void) const
+{
+  return MicroSeconds (GetRawDuration ());
+}
+
+Mac48Address
+WifiMacHeaderView::GetAddr1 (void) const
+{
+  return ReadAddress (OFFSET_ADDR1);
+}
+
+Mac48Address
+WifiMacHeaderView::GetAddr2 (void) const
+{
+  NS_ASSERT (GetSize () >= OFFSET_ADDR2 + 6);
+  return ReadAddress (OFFSET_ADDR2);
+}
+
+Mac48Address
+WifiMacHeaderView::GetAddr3 (void) const
+{
+  NS_ASSERT (IsMgt () || IsData ());
+  return ReadAddress (OFFSET_ADDR3);
+}
+
+Mac48Address
+WifiMacHeaderView::GetAddr4 (void) const
+{
+  NS_ASSERT (IsData () && IsToDs () && IsFromDs ());
+  return ReadAddress (OFFSET_ADDR4);
+}
+
+uint16_t
+WifiMacHeaderView::GetSequenceControl (void) const
+{
+  NS_ASSERT (IsMgt () || IsData ());
+  return ReadU16 (OFFSET_SEQUENCE_CONTROL);
+}
+
+uint16_t
+WifiMacHeaderView::GetSequenceNumber (void) const
+{
+  return (GetSequenceControl () >> 4) & 0x0fff;
+}
+
+uint8_t
+WifiMacHeaderView::GetFragmentNumber (void) const
+{
+  return GetSequenceControl () & 0x0f;
+}
+
+uint32_t
+WifiMacHeaderView::GetQosControlOffset (void) const
+{
+  return (IsToDs () && IsFromDs ()) ? OFFSET_ADDR4 + 6 : OFFSET_ADDR4;
+}
+
+uint8_t
+WifiMacHeaderView::GetQosTid (void) const
+{
+  NS_ASSERT (IsQosData ());
+  return ReadU16 (GetQosControlOffset ()) & 0x000f;
+}
+
+} //namespace ns3
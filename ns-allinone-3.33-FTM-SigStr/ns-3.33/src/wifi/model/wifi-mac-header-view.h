@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_MAC_HEADER_VIEW_H
+#define WIFI_MAC_HEADER_VIEW_H
+
+#include "ns3/ptr.h"
+#include "ns3/mac48-address.h"
+#include "wifi-mac-header.h"
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \ingroup wifi
+ *
+ * Read-only view of the 802.11 MAC header at the start of a packet.
+ *
+ * Trace sinks and other code that only need to classify a frame usually copy
+ * the packet and remove a WifiMacHeader from the copy, which allocates a new
+ * packet and deserializes every field of the header. A WifiMacHeaderView
+ * instead copies the first bytes of the packet into a fixed-size buffer held
+ * by the view itself (no heap allocation) and decodes the fields on demand.
+ * A full WifiMacHeader is only needed when the rest of the frame has to be
+ * parsed as well.
+ */
+class WifiMacHeaderView
+{
+public:
+  /**
+   * Create a view of the MAC header at the start of the given packet.
+   *
+   * \param packet the packet starting with a MAC header
+   */
+  WifiMacHeaderView (Ptr<const Packet> packet);
+  /**
+   * Create a view of the MAC header at the start of the given buffer.
+   *
+   * \param buffer the serialized bytes starting with a MAC header
+   * \param size the number of bytes in the buffer
+   */
+  WifiMacHeaderView (const uint8_t *buffer, uint32_t size);
+
+  /**
+   * \return true if the buffer holds a complete MAC header of a known type
+   */
+  bool IsValid (void) const;
+  /**
+   * \return the size of the serialized MAC header, as returned by WifiMacHeader::GetSerializedSize
+   */
+  uint32_t GetSize (void) const;
+
+  /**
+   * \return the raw Frame Control field
+   */
+  uint16_t GetFrameControl (void) const;
+  /**
+   * \return the type (enum WifiMacType)
+   */
+  WifiMacType GetType (void) const;
+  /**
+   * \return true if the header is a management header, false otherwise
+   */
+  bool IsMgt (void) const;
+  /**
+   * \return true if the header is a control header, false otherwise
+   */
+  bool IsCtl (void) const;
+  /**
+   * \return true if the header is a data header, false otherwise
+   */
+  bool IsData (void) const;
+  /**
+   * \return true if the header is a QoS data header, false otherwise
+   */
+  bool IsQosData (void) const;
+  /**
+   * \return true if the header is an Action header, false otherwise
+   */
+  bool IsAction (void) const;
+  /**
+   * \return true if the header is an Ack header, false otherwise
+   */
+  bool IsAck (void) const;
+  /**
+   * \return true if the To DS bit is set, false otherwise
+   */
+  bool IsToDs (void) const;
+  /**
+   * \return true if the From DS bit is set, false otherwise
+   */
+  bool IsFromDs (void) const;
+  /**
+   * \return true if the Retry bit is set, false otherwise
+   */
+  bool IsRetry (void) const;
+
+  /**
+   * \return the raw duration from the Duration/ID field
+   */
+  uint16_t GetRawDuration (void) const;
+  /**
+   * \return the duration from the Duration/ID field
+   */
+  Time GetDuration (void) const;
+  /**
+   * \return the address in the Address 1 field
+   */
+  Mac48Address GetAddr1 (void) const;
+  /**
+   * \return the address in the Address 2 field
+   */
+  Mac48Address GetAddr2 (void) const;
+  /**
+   * \return the address in the Address 3 field
+   */
+  Mac48Address GetAddr3 (void) const;
+  /**
+   * \return the address in the Address 4 field
+   */
+  Mac48Address GetAddr4 (void) const;
+  /**
+   * \return the raw Sequence Control field
+   */
+  uint16_t GetSequenceControl (void) const;
+  /**
+   * \return the sequence number of the header
+   */
+  uint16_t GetSequenceNumber (void) const;
+  /**
+   * \return the fragment number of the header
+   */
+  uint8_t GetFragmentNumber (void) const;
+  /**
+   * \return the TID of a QoS data header
+   */
+  uint8_t GetQosTid (void) const;
+
+  /// Size of the largest MAC header (QoS data frame with four addresses)
+  static const uint32_t MAX_SIZE = 32;
+
+
+private:
+  /**
+   * \param offset the offset of the field in the header
+   * \return the little-endian 16-bit field at the given offset
+   */
+  uint16_t ReadU16 (uint32_t offset) const;
+  /**
+   * \param offset the offset of the field in the header
+   * \return the address at the given offset
+   */
+  Mac48Address ReadAddress (uint32_t offset) const;
+  /**
+   * \return the offset of the QoS Control field
+   */
+  uint32_t GetQosControlOffset (void) const;
+
+  uint8_t m_buffer[MAX_SIZE]; //!< first bytes of the frame
+  uint32_t m_length;          //!< number of valid bytes in the buffer
+};
+
+} //namespace ns3
+
+#endif /* WIFI_MAC_HEADER_VIEW_H */
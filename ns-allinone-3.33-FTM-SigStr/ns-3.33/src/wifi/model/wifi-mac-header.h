@@ -567,6 +567,8 @@ public:
 
 
 private:
+  friend class WifiMacHeaderView;
+
   /**
    * Return the raw Frame Control field.
    *
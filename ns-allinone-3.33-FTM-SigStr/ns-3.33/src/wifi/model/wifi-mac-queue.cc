@@ -21,6 +21,7 @@
  *          Stefano Avallone <stavallo@unina.it>
  */
 
+#include <algorithm>
 #include "ns3/simulator.h"
 #include "wifi-mac-queue.h"
 #include "qos-blocked-destinations.h"
@@ -98,7 +99,7 @@ WifiMacQueue::TtlExceeded (ConstIterator &it)
     {
       NS_LOG_DEBUG ("Removing packet that stayed in the queue for too long (" <<
                     Simulator::Now () - (*it)->GetTimeStamp () << ")");
-      m_traceExpired (*it);
+      NS_TRACE (m_traceExpired, *it);
       auto curr = it++;
       DoRemove (curr);
       return true;
@@ -106,6 +107,82 @@ WifiMacQueue::TtlExceeded (ConstIterator &it)
   return false;
 }
 
+bool
+WifiMacQueue::DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item)
+{
+  NS_LOG_FUNCTION (this << *item);
+  bool atFront = (pos == begin ());
+
+  if (!Queue<WifiMacQueueItem>::DoEnqueue (pos, item))
+    {
+      return false;
+    }
+  if (!item->GetHeader ().IsQosData ())
+    {
+      return true;
+    }
+
+  ConstIterator inserted = std::prev (pos);
+  FlowIndex &flow = m_flows[FlowId (item->GetHeader ().GetQosTid (), item->GetDestinationAddress ())];
+  if (atFront)
+    {
+      flow.push_front (inserted);
+      return true;
+    }
+  // keep the flow in queue order: insert before the first item of the same
+  // flow that follows the new one (if any)
+  FlowIndex::iterator flowIt = flow.end ();
+  for (ConstIterator it = pos; it != end () && !flow.empty (); it++)
+    {
+      if ((*it)->GetHeader ().IsQosData ()
+          && (*it)->GetHeader ().GetQosTid () == item->GetHeader ().GetQosTid ()
+          && (*it)->GetDestinationAddress () == item->GetDestinationAddress ())
+        {
+          flowIt = std::find (flow.begin (), flow.end (), it);
+          NS_ASSERT (flowIt != flow.end ());
+          break;
+        }
+    }
+  flow.insert (flowIt, inserted);
+  return true;
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueue::DoDequeue (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this);
+  RemoveFromFlowIndex (pos);
+  return Queue<WifiMacQueueItem>::DoDequeue (pos);
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueue::DoRemove (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this);
+  RemoveFromFlowIndex (pos);
+  return Queue<WifiMacQueueItem>::DoRemove (pos);
+}
+
+void
+WifiMacQueue::RemoveFromFlowIndex (ConstIterator pos)
+{
+  if (pos == end () || !(*pos)->GetHeader ().IsQosData ())
+    {
+      return;
+    }
+  auto flowMapIt = m_flows.find (FlowId ((*pos)->GetHeader ().GetQosTid (), (*pos)->GetDestinationAddress ()));
+  NS_ASSERT (flowMapIt != m_flows.end ());
+  FlowIndex &flow = flowMapIt->second;
+  // items are most often removed from the head of their flow
+  FlowIndex::iterator flowIt = std::find (flow.begin (), flow.end (), pos);
+  NS_ASSERT (flowIt != flow.end ());
+  flow.erase (flowIt);
+  if (flow.empty ())
+    {
+      m_flows.erase (flowMapIt);
+    }
+}
+
 bool
 WifiMacQueue::Enqueue (Ptr<WifiMacQueueItem> item)
 {
@@ -344,7 +421,32 @@ WifiMacQueue::ConstIterator
 WifiMacQueue::PeekByTidAndAddress (uint8_t tid, Mac48Address dest, ConstIterator pos) const
 {
   NS_LOG_FUNCTION (this << +tid << dest);
-  ConstIterator it = (pos != EMPTY ? pos : begin ());
+  auto flowMapIt = m_flows.find (FlowId (tid, dest));
+  if (flowMapIt == m_flows.end ())
+    {
+      NS_LOG_DEBUG ("The queue is empty");
+      return end ();
+    }
+
+  if (pos == EMPTY)
+    {
+      // use the index to get to the head of the flow directly
+      for (const auto &it : flowMapIt->second)
+        {
+          // skip packets that stayed in the queue for too long. They will be
+          // actually removed from the queue by the next call to a non-const method
+          if (Simulator::Now () <= (*it)->GetTimeStamp () + m_maxDelay)
+            {
+              return it;
+            }
+          // signal the presence of expired packets
+          m_expiredPacketsPresent = true;
+        }
+      NS_LOG_DEBUG ("The queue is empty");
+      return end ();
+    }
+
+  ConstIterator it = pos;
   while (it != end ())
     {
       // skip packets that stayed in the queue for too long. They will be
@@ -494,18 +596,27 @@ uint32_t
 WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  uint32_t nPackets = 0;
-  for (ConstIterator it = begin (); it != end (); )
+  auto flowMapIt = m_flows.find (FlowId (tid, dest));
+  if (flowMapIt == m_flows.end ())
     {
+      NS_LOG_DEBUG ("returns 0");
+      return 0;
+    }
+  // remove the packets at the head of the flow that stayed in the queue for
+  // too long. The flow is kept in queue order, hence oldest packets first
+  uint32_t nPackets = flowMapIt->second.size ();
+  while (nPackets > 0)
+    {
+      ConstIterator it = flowMapIt->second.front ();
       if (!TtlExceeded (it))
         {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              nPackets++;
-            }
-
-          it++;
+          break;
+        }
+      // the flow entry is erased along with its last packet
+      nPackets--;
+      if (nPackets == 0)
+        {
+          break;
         }
     }
   NS_LOG_DEBUG ("returns " << nPackets);
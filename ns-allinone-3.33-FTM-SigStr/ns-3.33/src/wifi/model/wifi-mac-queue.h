@@ -24,6 +24,7 @@
 #ifndef WIFI_MAC_QUEUE_H
 #define WIFI_MAC_QUEUE_H
 
+#include <map>
 #include "wifi-mac-queue-item.h"
 #include "ns3/queue.h"
 
@@ -53,6 +54,12 @@ extern template class Queue<WifiMacQueueItem>;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * In addition to the global FIFO order, the queue maintains an index of
+ * the QoS data frames per (TID, destination) pair, in the same order as
+ * the global queue. Looking up the first frame of a given TID and
+ * destination, or counting the frames of such a pair, does not require
+ * scanning the frames addressed to other stations.
  */
 class WifiMacQueue : public Queue<WifiMacQueueItem>
 {
@@ -269,7 +276,9 @@ public:
   uint32_t GetNPacketsByAddress (Mac48Address dest);
   /**
    * Return the number of QoS packets having TID equal to <i>tid</i> and
-   * destination address equal to <i>dest</i>.
+   * destination address equal to <i>dest</i>. Packets whose lifetime expired
+   * are removed from the head of the corresponding flow first; the count is
+   * then obtained from the per-(TID, destination) index in constant time.
    *
    * \param tid the given TID
    * \param dest the given destination
@@ -313,6 +322,46 @@ private:
    */
   bool TtlExceeded (ConstIterator &it);
 
+  /**
+   * Wrapper for the DoEnqueue method provided by the base class that
+   * additionally updates the per-(TID, destination) index.
+   *
+   * \param pos the position before which the item is inserted
+   * \param item the item to enqueue
+   * \return true if success, false if the packet has been dropped.
+   */
+  bool DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item);
+  /**
+   * Wrapper for the DoDequeue method provided by the base class that
+   * additionally updates the per-(TID, destination) index.
+   *
+   * \param pos the position of the item to dequeue
+   * \return the item.
+   */
+  Ptr<WifiMacQueueItem> DoDequeue (ConstIterator pos);
+  /**
+   * Wrapper for the DoRemove method provided by the base class that
+   * additionally updates the per-(TID, destination) index.
+   *
+   * \param pos the position of the item to drop
+   * \return the item.
+   */
+  Ptr<WifiMacQueueItem> DoRemove (ConstIterator pos);
+  /**
+   * Remove the item at the given position from the per-(TID, destination)
+   * index, if it is a QoS data frame.
+   *
+   * \param pos the position of the item in the queue
+   */
+  void RemoveFromFlowIndex (ConstIterator pos);
+
+  /// (TID, destination) pair identifying a flow of QoS data frames
+  typedef std::pair<uint8_t, Mac48Address> FlowId;
+  /// positions in the queue of the QoS data frames of a flow, in queue order
+  typedef std::list<ConstIterator> FlowIndex;
+
+  std::map<FlowId, FlowIndex> m_flows;      //!< Per-(TID, destination) index of QoS data frames
+
   Time m_maxDelay;                          //!< Time to live for packets in the queue
   DropPolicy m_dropPolicy;                  //!< Drop behavior of queue
   mutable bool m_expiredPacketsPresent;     //!< True if expired packets are in the queue
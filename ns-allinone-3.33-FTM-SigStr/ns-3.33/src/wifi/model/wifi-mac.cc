@@ -93,31 +93,31 @@ WifiMac::GetDevice (void) const
 void
 WifiMac::NotifyTx (Ptr<const Packet> packet)
 {
-  m_macTxTrace (packet);
+  NS_TRACE (m_macTxTrace, packet);
 }
 
 void
 WifiMac::NotifyTxDrop (Ptr<const Packet> packet)
 {
-  m_macTxDropTrace (packet);
+  NS_TRACE (m_macTxDropTrace, packet);
 }
 
 void
 WifiMac::NotifyRx (Ptr<const Packet> packet)
 {
-  m_macRxTrace (packet);
+  NS_TRACE (m_macRxTrace, packet);
 }
 
 void
 WifiMac::NotifyPromiscRx (Ptr<const Packet> packet)
 {
-  m_macPromiscRxTrace (packet);
+  NS_TRACE (m_macPromiscRxTrace, packet);
 }
 
 void
 WifiMac::NotifyRxDrop (Ptr<const Packet> packet)
 {
-  m_macRxDropTrace (packet);
+  NS_TRACE (m_macRxDropTrace, packet);
 }
 
 void
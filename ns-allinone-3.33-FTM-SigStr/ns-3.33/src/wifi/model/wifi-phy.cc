@@ -2573,8 +2573,12 @@ WifiPhy::CalculateTxDuration (WifiConstPsduMap psduMap, WifiTxVector txVector, W
 }
 
 void
-WifiPhy::NotifyTxBegin (WifiConstPsduMap psdus, double txPowerW)
+WifiPhy::NotifyTxBegin (const WifiConstPsduMap &psdus, double txPowerW)
 {
+  if (m_phyTxBeginTrace.IsEmpty ())
+    {
+      return;
+    }
   for (auto const& psdu : psdus)
     {
       for (auto& mpdu : *PeekPointer (psdu.second))
@@ -2585,8 +2589,12 @@ WifiPhy::NotifyTxBegin (WifiConstPsduMap psdus, double txPowerW)
 }
 
 void
-WifiPhy::NotifyTxEnd (WifiConstPsduMap psdus)
+WifiPhy::NotifyTxEnd (const WifiConstPsduMap &psdus)
 {
+  if (m_phyTxEndTrace.IsEmpty ())
+    {
+      return;
+    }
   for (auto const& psdu : psdus)
     {
       for (auto& mpdu : *PeekPointer (psdu.second))
@@ -2599,6 +2607,10 @@ WifiPhy::NotifyTxEnd (WifiConstPsduMap psdus)
 void
 WifiPhy::NotifyTxDrop (Ptr<const WifiPsdu> psdu)
 {
+  if (m_phyTxDropTrace.IsEmpty ())
+    {
+      return;
+    }
   for (auto& mpdu : *PeekPointer (psdu))
     {
       m_phyTxDropTrace (mpdu->GetProtocolDataUnit ());
@@ -2606,9 +2618,9 @@ WifiPhy::NotifyTxDrop (Ptr<const WifiPsdu> psdu)
 }
 
 void
-WifiPhy::NotifyRxBegin (Ptr<const WifiPsdu> psdu, RxPowerWattPerChannelBand rxPowersW)
+WifiPhy::NotifyRxBegin (Ptr<const WifiPsdu> psdu, const RxPowerWattPerChannelBand &rxPowersW)
 {
-  if (psdu)
+  if (psdu && !m_phyRxBeginTrace.IsEmpty ())
     {
       for (auto& mpdu : *PeekPointer (psdu))
         {
@@ -2620,7 +2632,7 @@ WifiPhy::NotifyRxBegin (Ptr<const WifiPsdu> psdu, RxPowerWattPerChannelBand rxPo
 void
 WifiPhy::NotifyRxEnd (Ptr<const WifiPsdu> psdu)
 {
-  if (psdu)
+  if (psdu && !m_phyRxEndTrace.IsEmpty ())
     {
       for (auto& mpdu : *PeekPointer (psdu))
         {
@@ -2632,7 +2644,7 @@ WifiPhy::NotifyRxEnd (Ptr<const WifiPsdu> psdu)
 void
 WifiPhy::NotifyRxDrop (Ptr<const WifiPsdu> psdu, WifiPhyRxfailureReason reason)
 {
-  if (psdu)
+  if (psdu && !m_phyRxDropTrace.IsEmpty ())
     {
       for (auto& mpdu : *PeekPointer (psdu))
         {
@@ -2643,7 +2655,7 @@ WifiPhy::NotifyRxDrop (Ptr<const WifiPsdu> psdu, WifiPhyRxfailureReason reason)
 
 void
 WifiPhy::NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz, WifiTxVector txVector,
-                               SignalNoiseDbm signalNoise, std::vector<bool> statusPerMpdu, uint16_t staId)
+                               SignalNoiseDbm signalNoise, const std::vector<bool> &statusPerMpdu, uint16_t staId)
 {
   MpduInfo aMpdu;
   if (psdu->IsAggregate ())
@@ -2658,7 +2670,7 @@ WifiPhy::NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz
         {
           if (statusPerMpdu.at (i)) //packet received without error, hand over to sniffer
             {
-              m_phyMonitorSniffRxTrace (psdu->GetAmpduSubframe (i), channelFreqMhz, txVector, aMpdu, signalNoise, staId);
+              NS_TRACE (m_phyMonitorSniffRxTrace, psdu->GetAmpduSubframe (i), channelFreqMhz, txVector, aMpdu, signalNoise, staId);
             }
           ++i;
           aMpdu.type = (i == (nMpdus - 1)) ? LAST_MPDU_IN_AGGREGATE : MIDDLE_MPDU_IN_AGGREGATE;
@@ -2668,7 +2680,7 @@ WifiPhy::NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz
     {
       aMpdu.type = NORMAL_MPDU;
       NS_ASSERT_MSG (statusPerMpdu.size () == 1, "Should have one reception status for normal MPDU");
-      m_phyMonitorSniffRxTrace (psdu->GetPacket (), channelFreqMhz, txVector, aMpdu, signalNoise, staId);
+      NS_TRACE (m_phyMonitorSniffRxTrace, psdu->GetPacket (), channelFreqMhz, txVector, aMpdu, signalNoise, staId);
     }
 }
 
@@ -2685,7 +2697,7 @@ WifiPhy::NotifyMonitorSniffTx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz
       aMpdu.type = (psdu->IsSingle ()) ? SINGLE_MPDU: FIRST_MPDU_IN_AGGREGATE;
       for (size_t i = 0; i < nMpdus;)
         {
-          m_phyMonitorSniffTxTrace (psdu->GetAmpduSubframe (i), channelFreqMhz, txVector, aMpdu, staId);
+          NS_TRACE (m_phyMonitorSniffTxTrace, psdu->GetAmpduSubframe (i), channelFreqMhz, txVector, aMpdu, staId);
           ++i;
           aMpdu.type = (i == (nMpdus - 1)) ? LAST_MPDU_IN_AGGREGATE : MIDDLE_MPDU_IN_AGGREGATE;
         }
@@ -2693,14 +2705,14 @@ WifiPhy::NotifyMonitorSniffTx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz
   else
     {
       aMpdu.type = NORMAL_MPDU;
-      m_phyMonitorSniffTxTrace (psdu->GetPacket (), channelFreqMhz, txVector, aMpdu, staId);
+      NS_TRACE (m_phyMonitorSniffTxTrace, psdu->GetPacket (), channelFreqMhz, txVector, aMpdu, staId);
     }
 }
 
 void
 WifiPhy::NotifyEndOfHePreamble (HePreambleParameters params)
 {
-  m_phyEndOfHePreambleTrace (params);
+  NS_TRACE (m_phyEndOfHePreambleTrace, params);
 }
 
 void
@@ -2770,7 +2782,7 @@ WifiPhy::Send (WifiConstPsduMap psdus, WifiTxVector txVector)
 
   double txPowerW = DbmToW (GetTxPowerForTransmission (txVector) + GetTxGain ());
   NotifyTxBegin (psdus, txPowerW);
-  m_phyTxPsduBeginTrace (psdus, txVector, txPowerW);
+  NS_TRACE (m_phyTxPsduBeginTrace, psdus, txVector, txPowerW);
   for (auto const& psdu : psdus)
     {
       NotifyMonitorSniffTx (psdu.second, GetFrequency (), txVector, psdu.first);
@@ -2818,7 +2830,10 @@ WifiPhy::StartReceiveHeader (Ptr<Event> event)
 
   if (!m_preambleDetectionModel || (m_preambleDetectionModel->IsPreambleDetected (event->GetRxPowerW (band), snr, m_channelWidth)))
     {
-      NotifyRxBegin (GetAddressedPsduInPpdu (event->GetPpdu ()), event->GetRxPowerWPerBand ());
+      if (!m_phyRxBeginTrace.IsEmpty ())
+        {
+          NotifyRxBegin (GetAddressedPsduInPpdu (event->GetPpdu ()), event->GetRxPowerWPerBand ());
+        }
 
       m_timeLastPreambleDetected = Simulator::Now ();
       WifiTxVector txVector = event->GetTxVector ();
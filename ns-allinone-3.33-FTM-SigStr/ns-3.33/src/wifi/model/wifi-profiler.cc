@@ -0,0 +1,293 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <array>
+#include <map>
+#include <set>
+#include <mutex>
+#include <iomanip>
+#include <iostream>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "wifi-profiler.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WifiProfiler");
+
+namespace {
+
+/**
+ * Counters of a stage
+ */
+struct StageCounters
+{
+  uint64_t count = 0;                                    //!< Number of times the stage was entered
+  std::chrono::steady_clock::duration elapsed {0};       //!< Wall-clock time spent in the stage
+};
+
+/// Counters of all the stages, indexed by context (node ID)
+typedef std::map<uint32_t, std::array<StageCounters, WifiProfiler::STAGE_COUNT> > ProfilerCounters;
+
+/**
+ * Add counters to other counters
+ *
+ * \param to the counters to add to
+ * \param from the counters to add
+ */
+void
+Merge (ProfilerCounters &to, const ProfilerCounters &from)
+{
+  for (const auto & context : from)
+    {
+      for (uint8_t stage = 0; stage < WifiProfiler::STAGE_COUNT; stage++)
+        {
+          to[context.first][stage].count += context.second[stage].count;
+          to[context.first][stage].elapsed += context.second[stage].elapsed;
+        }
+    }
+}
+
+/**
+ * Counters recorded by a thread. They are registered on construction and
+ * merged into the counters of the exited threads on destruction.
+ */
+struct ThreadCounters
+{
+  ThreadCounters ();
+  ~ThreadCounters ();
+
+  std::mutex mutex;             //!< Protects the counters against the readers of the other threads
+  ProfilerCounters counters;    //!< Counters of all the contexts run by the thread
+};
+
+/**
+ * Counters of all the threads
+ */
+struct ProfilerRegistry
+{
+  std::mutex mutex;                     //!< Protects the registry
+  std::set<ThreadCounters *> threads;   //!< Counters of the running threads
+  ProfilerCounters exited;              //!< Counters of the exited threads
+};
+
+/**
+ * \return the counters of all the threads
+ */
+ProfilerRegistry &
+GetRegistry (void)
+{
+  static ProfilerRegistry registry;
+  return registry;
+}
+
+ThreadCounters::ThreadCounters ()
+{
+  ProfilerRegistry &registry = GetRegistry ();
+  std::lock_guard<std::mutex> lock (registry.mutex);
+  registry.threads.insert (this);
+}
+
+ThreadCounters::~ThreadCounters ()
+{
+  ProfilerRegistry &registry = GetRegistry ();
+  std::lock_guard<std::mutex> lock (registry.mutex);
+  Merge (registry.exited, counters);
+  registry.threads.erase (this);
+}
+
+/**
+ * \return the counters of the calling thread
+ */
+ThreadCounters &
+GetThreadCounters (void)
+{
+  static thread_local ThreadCounters counters;
+  return counters;
+}
+
+/**
+ * \return the counters of all the threads, merged
+ */
+ProfilerCounters
+GetCounters (void)
+{
+  ProfilerRegistry &registry = GetRegistry ();
+  std::lock_guard<std::mutex> lock (registry.mutex);
+  ProfilerCounters counters = registry.exited;
+  for (const auto & thread : registry.threads)
+    {
+      std::lock_guard<std::mutex> threadLock (thread->mutex);
+      Merge (counters, thread->counters);
+    }
+  return counters;
+}
+
+} //unnamed namespace
+
+std::atomic<bool> WifiProfiler::m_enabled (false);
+bool WifiProfiler::m_report = true;
+bool WifiProfiler::m_finishScheduled = false;
+thread_local uint32_t WifiProfiler::m_depth[WifiProfiler::STAGE_COUNT] = {};
+
+void
+WifiProfiler::Enable (bool report)
+{
+  NS_LOG_FUNCTION (report);
+  m_enabled.store (true, std::memory_order_relaxed);
+  m_report = report;
+  if (!m_finishScheduled)
+    {
+      Simulator::ScheduleDestroy (&WifiProfiler::Finish);
+      m_finishScheduled = true;
+    }
+}
+
+void
+WifiProfiler::Disable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled.store (false, std::memory_order_relaxed);
+}
+
+void
+WifiProfiler::Reset (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  ProfilerRegistry &registry = GetRegistry ();
+  std::lock_guard<std::mutex> lock (registry.mutex);
+  registry.exited.clear ();
+  for (const auto & thread : registry.threads)
+    {
+      std::lock_guard<std::mutex> threadLock (thread->mutex);
+      thread->counters.clear ();
+    }
+}
+
+void
+WifiProfiler::Finish (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (m_report)
+    {
+      Print (std::clog);
+    }
+  Reset ();
+  m_enabled.store (false, std::memory_order_relaxed);
+  m_finishScheduled = false;
+}
+
+void
+WifiProfiler::Record (Stage stage, std::chrono::steady_clock::duration elapsed)
+{
+  NS_ASSERT (stage < STAGE_COUNT);
+  uint32_t context = Simulator::GetContext ();
+  ThreadCounters &thread = GetThreadCounters ();
+  std::lock_guard<std::mutex> lock (thread.mutex);
+  StageCounters &counters = thread.counters[context][stage];
+  counters.count++;
+  counters.elapsed += elapsed;
+}
+
+uint64_t
+WifiProfiler::GetCount (uint32_t context, Stage stage)
+{
+  NS_ASSERT (stage < STAGE_COUNT);
+  ProfilerCounters counters = GetCounters ();
+  ProfilerCounters::const_iterator it = counters.find (context);
+  if (it == counters.end ())
+    {
+      return 0;
+    }
+  return it->second[stage].count;
+}
+
+double
+WifiProfiler::GetSeconds (uint32_t context, Stage stage)
+{
+  NS_ASSERT (stage < STAGE_COUNT);
+  ProfilerCounters counters = GetCounters ();
+  ProfilerCounters::const_iterator it = counters.find (context);
+  if (it == counters.end ())
+    {
+      return 0;
+    }
+  return std::chrono::duration<double> (it->second[stage].elapsed).count ();
+}
+
+const char *
+WifiProfiler::GetStageName (Stage stage)
+{
+  switch (stage)
+    {
+    case CHANNEL_SEND:
+      return "ChannelSend";
+    case SNR_PER:
+      return "SnrPer";
+    case MAC_LOW_RECEIVE:
+      return "MacLowReceive";
+    case STATION_LOOKUP:
+      return "StationLookup";
+    case AGGREGATION:
+      return "Aggregation";
+    case FTM_MANAGER:
+      return "FtmManager";
+    default:
+      NS_FATAL_ERROR ("Unknown stage " << stage);
+      return "";
+    }
+}
+
+void
+WifiProfiler::Print (std::ostream &os)
+{
+  std::ios_base::fmtflags flags = os.flags ();
+  std::streamsize precision = os.precision ();
+  os << "Wi-Fi profiling report" << std::endl
+     << std::left << std::setw (8) << "Node" << std::setw (16) << "Stage"
+     << std::right << std::setw (14) << "Count" << std::setw (14) << "Total (ms)"
+     << std::setw (14) << "Mean (us)" << std::endl;
+  for (const auto & context : GetCounters ())
+    {
+      for (uint8_t stage = 0; stage < STAGE_COUNT; stage++)
+        {
+          const StageCounters &counters = context.second[stage];
+          if (counters.count == 0)
+            {
+              continue;
+            }
+          double seconds = std::chrono::duration<double> (counters.elapsed).count ();
+          os << std::left << std::setw (8);
+          if (context.first == Simulator::NO_CONTEXT)
+            {
+              os << "-";
+            }
+          else
+            {
+              os << context.first;
+            }
+          os << std::setw (16) << GetStageName (static_cast<Stage> (stage))
+             << std::right << std::setw (14) << counters.count
+             << std::setw (14) << std::fixed << std::setprecision (3) << seconds * 1e3
+             << std::setw (14) << seconds * 1e6 / counters.count
+             << std::endl;
+        }
+    }
+  os.flags (flags);
+  os.precision (precision);
+}
+
+} //namespace ns3
@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_PROFILER_H
+#define WIFI_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * Optional counters and wall-clock timers for the hot paths of the wifi module.
+ *
+ * When profiling is enabled, every instrumented stage records, for the node in
+ * whose context it runs, how many times it was entered and how much wall-clock
+ * time was spent in it. Times are inclusive: a stage entered from within
+ * another stage (e.g., a station manager lookup made while MacLow processes a
+ * received frame) is accounted to both. A stage entered again from within
+ * itself (e.g., the A-MSDU aggregation made while building an A-MPDU) is only
+ * accounted once, by its outermost scope. When profiling is disabled, which
+ * is the default, entering a stage costs a single test of a static flag.
+ *
+ * The stages may run in several threads, e.g., with the multithreaded
+ * simulator: each thread keeps its own scope depths and counters, which are
+ * merged when they are read. The counters are meant to be read once the
+ * simulation threads are idle, e.g., after Simulator::Run returns.
+ *
+ * Profiling lasts until the simulator is destroyed: at that point, the
+ * per-node, per-stage report is printed to std::clog (unless disabled when
+ * enabling profiling), the counters are reset and profiling is disabled.
+ *
+ * A stage is instrumented by declaring a WifiProfiler::Scope at the start
+ * of the code to be measured:
+ * \code
+ *   WifiProfiler::Scope profile (WifiProfiler::CHANNEL_SEND);
+ * \endcode
+ */
+class WifiProfiler
+{
+public:
+  /**
+   * The instrumented stages
+   */
+  enum Stage
+  {
+    CHANNEL_SEND = 0,   //!< YansWifiChannel::Send fan-out to the receivers
+    SNR_PER,            //!< SNR and PER computation by the InterferenceHelper
+    MAC_LOW_RECEIVE,    //!< Processing of a received PSDU by MacLow
+    STATION_LOOKUP,     //!< Lookup of a remote station by the WifiRemoteStationManager
+    AGGREGATION,        //!< A-MSDU and A-MPDU aggregation
+    FTM_MANAGER,        //!< PHY trace hooks of the FtmManager
+    STAGE_COUNT         //!< Number of stages
+  };
+
+  /**
+   * Start profiling until the simulator is destroyed.
+   *
+   * \param report whether the report is printed to std::clog when the
+   *               simulator is destroyed
+   */
+  static void Enable (bool report = true);
+  /**
+   * Stop profiling. The counters are left untouched.
+   */
+  static void Disable (void);
+  /**
+   * \return true if profiling is enabled
+   */
+  static bool IsEnabled (void);
+  /**
+   * Discard all the counters.
+   */
+  static void Reset (void);
+
+  /**
+   * Account one execution of a stage to the node of the current context.
+   *
+   * \param stage the stage
+   * \param elapsed the wall-clock time spent in the stage
+   */
+  static void Record (Stage stage, std::chrono::steady_clock::duration elapsed);
+  /**
+   * \param context the context (node ID) of interest
+   * \param stage the stage of interest
+   * \return the number of times the stage was entered in the given context
+   */
+  static uint64_t GetCount (uint32_t context, Stage stage);
+  /**
+   * \param context the context (node ID) of interest
+   * \param stage the stage of interest
+   * \return the wall-clock time (in seconds) spent in the stage in the given context
+   */
+  static double GetSeconds (uint32_t context, Stage stage);
+  /**
+   * \param stage the stage
+   * \return the name of the stage
+   */
+  static const char * GetStageName (Stage stage);
+  /**
+   * Print the per-node, per-stage counters. The format flags and the
+   * precision of the stream are left unchanged.
+   *
+   * \param os the output stream
+   */
+  static void Print (std::ostream &os);
+
+  /**
+   * Measures the wall-clock time elapsed between its construction and its
+   * destruction and accounts it to a stage, if profiling is enabled and no
+   * other scope of the same stage is in progress.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * \param stage the stage the enclosing code belongs to
+     */
+    Scope (Stage stage);
+    ~Scope ();
+
+  private:
+    Stage m_stage;                                  //!< Stage being measured
+    bool m_enabled;                                 //!< Whether profiling was enabled on construction
+    bool m_outermost;                               //!< Whether no scope of the same stage was in progress on construction
+    std::chrono::steady_clock::time_point m_start;  //!< Wall-clock time on construction
+  };
+
+private:
+  /**
+   * Print the report if requested, then reset the counters and disable
+   * profiling. Invoked when the simulator is destroyed.
+   */
+  static void Finish (void);
+
+  static std::atomic<bool> m_enabled; //!< Whether profiling is enabled
+  static bool m_report;          //!< Whether the report is printed when the simulator is destroyed
+  static bool m_finishScheduled; //!< Whether Finish is scheduled on simulator destruction
+  static thread_local uint32_t m_depth[STAGE_COUNT]; //!< Number of scopes of the calling thread in progress for each stage
+};
+
+inline bool
+WifiProfiler::IsEnabled (void)
+{
+  return m_enabled.load (std::memory_order_relaxed);
+}
+
+inline
+WifiProfiler::Scope::Scope (Stage stage)
+  : m_stage (stage),
+    m_enabled (WifiProfiler::IsEnabled ()),
+    m_outermost (false)
+{
+  if (m_enabled)
+    {
+      m_outermost = (WifiProfiler::m_depth[m_stage]++ == 0);
+      if (m_outermost)
+        {
+          m_start = std::chrono::steady_clock::now ();
+        }
+    }
+}
+
+inline
+WifiProfiler::Scope::~Scope ()
+{
+  if (m_enabled)
+    {
+      WifiProfiler::m_depth[m_stage]--;
+      if (m_outermost)
+        {
+          WifiProfiler::Record (m_stage, std::chrono::steady_clock::now () - m_start);
+        }
+    }
+}
+
+} //namespace ns3
+
+#endif /* WIFI_PROFILER_H */
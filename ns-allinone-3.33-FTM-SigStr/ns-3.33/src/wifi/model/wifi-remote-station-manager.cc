@@ -32,6 +32,7 @@
 #include "vht-configuration.h"
 #include "he-configuration.h"
 #include "wifi-net-device.h"
+#include "wifi-profiler.h"
 
 namespace ns3 {
 
@@ -615,7 +616,7 @@ WifiRemoteStationManager::ReportRtsFailed (Mac48Address address, const WifiMacHe
   NS_ASSERT (!address.IsGroup ());
   AcIndex ac = QosUtilsMapTidToAc ((header->IsQosData ()) ? header->GetQosTid () : 0);
   m_ssrc[ac]++;
-  m_macTxRtsFailed (address);
+  NS_TRACE (m_macTxRtsFailed, address);
   DoReportRtsFailed (Lookup (address));
 }
 
@@ -635,7 +636,7 @@ WifiRemoteStationManager::ReportDataFailed (Mac48Address address, const WifiMacH
     {
       m_ssrc[ac]++;
     }
-  m_macTxDataFailed (address);
+  NS_TRACE (m_macTxDataFailed, address);
   DoReportDataFailed (Lookup (address));
 }
 
@@ -684,7 +685,7 @@ WifiRemoteStationManager::ReportFinalRtsFailed (Mac48Address address, const Wifi
   AcIndex ac = QosUtilsMapTidToAc ((header->IsQosData ()) ? header->GetQosTid () : 0);
   station->m_state->m_info.NotifyTxFailed ();
   m_ssrc[ac] = 0;
-  m_macTxFinalRtsFailed (address);
+  NS_TRACE (m_macTxFinalRtsFailed, address);
   DoReportFinalRtsFailed (station);
 }
 
@@ -706,7 +707,7 @@ WifiRemoteStationManager::ReportFinalDataFailed (Mac48Address address, const Wif
     {
       m_ssrc[ac] = 0;
     }
-  m_macTxFinalDataFailed (address);
+  NS_TRACE (m_macTxFinalDataFailed, address);
   DoReportFinalDataFailed (station);
 }
 
@@ -730,7 +731,7 @@ WifiRemoteStationManager::ReportAmpduTxStatus (Mac48Address address,
   NS_ASSERT (!address.IsGroup ());
   for (uint8_t i = 0; i < nFailedMpdus; i++)
     {
-      m_macTxDataFailed (address);
+      NS_TRACE (m_macTxDataFailed, address);
     }
   DoReportAmpduTxStatus (Lookup (address), nSuccessfulMpdus, nFailedMpdus, rxSnr, dataSnr, dataTxVector.GetChannelWidth (), dataTxVector.GetNss ());
 }
@@ -1025,6 +1026,7 @@ WifiRemoteStationState *
 WifiRemoteStationManager::LookupState (Mac48Address address) const
 {
   NS_LOG_FUNCTION (this << address);
+  WifiProfiler::Scope profile (WifiProfiler::STATION_LOOKUP);
   for (StationStates::const_iterator i = m_states.begin (); i != m_states.end (); i++)
     {
       if ((*i)->m_address == address)
@@ -1055,6 +1057,7 @@ WifiRemoteStation *
 WifiRemoteStationManager::Lookup (Mac48Address address) const
 {
   NS_LOG_FUNCTION (this << address);
+  WifiProfiler::Scope profile (WifiProfiler::STATION_LOOKUP);
   for (Stations::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
     {
       if ((*i)->m_state->m_address == address)
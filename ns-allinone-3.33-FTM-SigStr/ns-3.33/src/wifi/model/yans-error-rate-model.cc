@@ -20,6 +20,7 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/pointer.h"
 #include "yans-error-rate-model.h"
 #include "wifi-utils.h"
 #include "wifi-phy.h"
@@ -37,6 +38,12 @@ YansErrorRateModel::GetTypeId (void)
     .SetParent<ErrorRateModel> ()
     .SetGroupName ("Wifi")
     .AddConstructor<YansErrorRateModel> ()
+    .AddAttribute ("LookupTable",
+                   "If set, chunk success rates are interpolated from SNR tables built "
+                   "from this model instead of being computed analytically for every chunk.",
+                   PointerValue (),
+                   MakePointerAccessor (&YansErrorRateModel::m_lookupTable),
+                   MakePointerChecker<ErrorRateLookupTable> ())
   ;
   return tid;
 }
@@ -180,6 +187,23 @@ YansErrorRateModel::GetFecQamBer (double snr, uint64_t nbits,
 
 double
 YansErrorRateModel::DoGetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
+  NS_LOG_FUNCTION (this << mode << snr << nbits);
+  if (m_lookupTable)
+    {
+      ErrorRateLookupTable::Key key = std::make_tuple (GetInstanceTypeId ().GetUid (), mode.GetUid (),
+                                                       txVector.GetChannelWidth (), mode.GetPhyRate (txVector));
+      return m_lookupTable->GetChunkSuccessRate (key, snr, nbits,
+                                                 [this, &mode, &txVector] (double s, uint64_t n)
+                                                 {
+                                                   return CalculateChunkSuccessRate (mode, txVector, s, n);
+                                                 });
+    }
+  return CalculateChunkSuccessRate (mode, txVector, snr, nbits);
+}
+
+double
+YansErrorRateModel::CalculateChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
 {
   NS_LOG_FUNCTION (this << mode << txVector.GetMode () << snr << nbits);
   if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM
@@ -22,6 +22,7 @@
 #define YANS_ERROR_RATE_MODEL_H
 
 #include "error-rate-model.h"
+#include "error-rate-lookup-table.h"
 
 namespace ns3 {
 
@@ -65,6 +66,17 @@ public:
 private:
   //Inherited from ErrorRateModel
   double DoGetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+  /**
+   * Compute the chunk success rate from the analytic model.
+   *
+   * \param mode the Wi-Fi mode applicable to this chunk
+   * \param txVector TXVECTOR of the overall transmission
+   * \param snr the SNR of the chunk
+   * \param nbits the number of bits in this chunk
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  double CalculateChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
   /**
    * Return BER of BPSK with the given parameters.
    *
@@ -155,6 +167,8 @@ private:
                        uint64_t phyRate,
                        uint32_t m, uint32_t dfree,
                        uint32_t adFree, uint32_t adFreePlusOne) const;
+
+  Ptr<ErrorRateLookupTable> m_lookupTable; //!< Optional SNR lookup table replacing the analytic computation
 };
 
 } //namespace ns3
@@ -21,6 +21,7 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/propagation-loss-model.h"
@@ -31,6 +32,7 @@
 #include "wifi-utils.h"
 #include "wifi-ppdu.h"
 #include "wifi-psdu.h"
+#include "wifi-profiler.h"
 
 namespace ns3 {
 
@@ -53,11 +55,24 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("Partitioned",
+                   "If true, signals are only carried between the nodes of the local "
+                   "logical process (see Simulator::GetSystemId). This allows a distributed "
+                   "simulation to be partitioned by channel number: every node tuned to a "
+                   "given channel must then belong to the same logical process, otherwise "
+                   "the simulation is aborted when a signal would cross logical processes. "
+                   "Only the signals are partitioned: the MAC of the remote nodes (e.g., "
+                   "beacons and probing) still runs in every logical process, and its "
+                   "transmissions are discarded by the channel.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_partitioned),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_partitioned (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -86,6 +101,12 @@ void
 YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double txPowerDbm) const
 {
   NS_LOG_FUNCTION (this << sender << ppdu << txPowerDbm);
+  WifiProfiler::Scope profile (WifiProfiler::CHANNEL_SEND);
+  if (m_partitioned && !IsLocal (sender))
+    {
+      //the transmission is simulated by the logical process owning the sender
+      return;
+    }
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
   for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
@@ -97,6 +118,12 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
             {
               continue;
             }
+          if (m_partitioned && !IsLocal (*i))
+            {
+              NS_FATAL_ERROR ("Node " << (*i)->GetDevice ()->GetNode ()->GetId () << " is tuned to channel "
+                              << +sender->GetChannelNumber () << " but belongs to another logical process;"
+                              " all the nodes tuned to a channel must belong to the same logical process");
+            }
 
           Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
           Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
@@ -122,6 +149,13 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
     }
 }
 
+bool
+YansWifiChannel::IsLocal (Ptr<const YansWifiPhy> phy)
+{
+  Ptr<NetDevice> device = phy->GetDevice ();
+  return device == 0 || device->GetNode ()->GetSystemId () == Simulator::GetSystemId ();
+}
+
 void
 YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<WifiPpdu> ppdu, double rxPowerDbm)
 {
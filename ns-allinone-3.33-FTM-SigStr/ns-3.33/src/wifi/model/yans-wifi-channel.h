@@ -114,10 +114,17 @@ private:
    * \param txPowerDbm the TX power associated to the packet being sent (dBm)
    */
   static void Receive (Ptr<YansWifiPhy> receiver, Ptr<WifiPpdu> ppdu, double txPowerDbm);
+  /**
+   * \param phy the PHY
+   * \return true if the node of the given PHY belongs to the logical process
+   *         being simulated by this instance (see Simulator::GetSystemId)
+   */
+  static bool IsLocal (Ptr<const YansWifiPhy> phy);
 
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  bool m_partitioned;                  //!< Whether signals only reach the nodes of the local logical process
 };
 
 } //namespace ns3
@@ -22,6 +22,7 @@
 #include "ns3/string.h"
 #include "ns3/qos-utils.h"
 #include "ns3/ctrl-headers.h"
+#include "ns3/block-ack-window.h"
 #include "ns3/packet.h"
 #include "ns3/wifi-net-device.h"
 #include "ns3/ap-wifi-mac.h"
@@ -546,6 +547,79 @@ OriginatorBlockAckWindowTest::DoRun (void)
 }
 
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test for a block ack window spanning several words of the bitmap
+ */
+class MultiWordBlockAckWindowTest : public TestCase
+{
+public:
+  MultiWordBlockAckWindowTest ();
+private:
+  virtual void DoRun ();
+};
+
+MultiWordBlockAckWindowTest::MultiWordBlockAckWindowTest ()
+  : TestCase ("Check the correctness of a block ack window spanning several words")
+{
+}
+
+void
+MultiWordBlockAckWindowTest::DoRun (void)
+{
+  uint16_t winSize = 256;
+  uint16_t startingSeq = 4000;
+
+  BlockAckWindow window;
+  window.Init (startingSeq, winSize);
+  NS_TEST_EXPECT_MSG_EQ (window.GetNConsecutiveSet (), 0, "Incorrect number of consecutive elements set after initialization");
+
+  // set the first 150 elements, except for the 70th
+  for (uint16_t i = 0; i < 150; i++)
+    {
+      window.At (i) = (i != 69);
+    }
+  NS_TEST_EXPECT_MSG_EQ (window.GetNConsecutiveSet (), 69, "Incorrect number of consecutive elements set");
+
+  window.At (69) = true;
+  NS_TEST_EXPECT_MSG_EQ (window.GetNConsecutiveSet (), 150, "Incorrect number of consecutive elements set");
+
+  // move the window forward so that it wraps around the end of the bitmap
+  window.Advance (150);
+  startingSeq = (startingSeq + 150) % SEQNO_SPACE_SIZE;
+  NS_TEST_EXPECT_MSG_EQ (window.GetWinStart (), startingSeq, "Incorrect winStart");
+  for (uint16_t i = 0; i < winSize; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (window.At (i), false, "Not all flags are cleared after advancing the window");
+    }
+
+  // set elements across the end of the bitmap, up to (and excluding) the 200th
+  for (uint16_t i = 0; i < 199; i++)
+    {
+      window.At (i) = true;
+    }
+  NS_TEST_EXPECT_MSG_EQ (window.GetNConsecutiveSet (), 199, "Incorrect number of consecutive elements set across the end of the bitmap");
+
+  // clear a range of elements across the end of the bitmap
+  window.Advance (120);
+  startingSeq = (startingSeq + 120) % SEQNO_SPACE_SIZE;
+  NS_TEST_EXPECT_MSG_EQ (window.GetWinStart (), startingSeq, "Incorrect winStart");
+  NS_TEST_EXPECT_MSG_EQ (window.GetNConsecutiveSet (), 79, "Incorrect number of consecutive elements set");
+  for (uint16_t i = 79; i < winSize; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (window.At (i), false, "Flags not cleared after advancing the window");
+    }
+
+  // set all the elements
+  for (uint16_t i = 0; i < winSize; i++)
+    {
+      window.At (i) = true;
+    }
+  NS_TEST_EXPECT_MSG_EQ (window.GetNConsecutiveSet (), winSize, "Not all the elements are set");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -951,6 +1025,7 @@ BlockAckTestSuite::BlockAckTestSuite ()
   AddTestCase (new PacketBufferingCaseA, TestCase::QUICK);
   AddTestCase (new PacketBufferingCaseB, TestCase::QUICK);
   AddTestCase (new OriginatorBlockAckWindowTest, TestCase::QUICK);
+  AddTestCase (new MultiWordBlockAckWindowTest, TestCase::QUICK);
   AddTestCase (new CtrlBAckResponseHeaderTest, TestCase::QUICK);
   AddTestCase (new BlockAckAggregationDisabledTest (false), TestCase::QUICK);
   AddTestCase (new BlockAckAggregationDisabledTest (true), TestCase::QUICK);
@@ -20,6 +20,7 @@
 
 #include "ns3/test.h"
 #include "ns3/simulator.h"
+#include "ns3/boolean.h"
 #include "ns3/channel-access-manager.h"
 #include "ns3/qos-txop.h"
 #include "ns3/mac-low.h"
@@ -216,7 +217,12 @@ template <typename TxopType>
 class ChannelAccessManagerTest : public TestCase
 {
 public:
-  ChannelAccessManagerTest ();
+  /**
+   * Constructor
+   * \param cacheBackoffDeadlines whether the channel access manager computes
+   *                              the backoff end times once per update
+   */
+  ChannelAccessManagerTest (bool cacheBackoffDeadlines);
   virtual void DoRun (void);
 
   /**
@@ -390,6 +396,7 @@ private:
   Ptr<ChannelAccessManagerStub> m_ChannelAccessManager; //!< the channel access manager
   TxopTests m_txop; //!< the vector of Txop test instances
   uint32_t m_ackTimeoutValue; //!< the Ack timeout value
+  bool m_cacheBackoffDeadlines; //!< whether the backoff end times are computed once per update
 };
 
 template <typename TxopType>
@@ -478,8 +485,9 @@ TxopTest<TxopType>::NotifyWakeUp (void)
 }
 
 template <typename TxopType>
-ChannelAccessManagerTest<TxopType>::ChannelAccessManagerTest ()
-  : TestCase ("ChannelAccessManager")
+ChannelAccessManagerTest<TxopType>::ChannelAccessManagerTest (bool cacheBackoffDeadlines)
+  : TestCase (std::string ("ChannelAccessManager") + (cacheBackoffDeadlines ? " with cached backoff deadlines" : "")),
+    m_cacheBackoffDeadlines (cacheBackoffDeadlines)
 {
 }
 
@@ -594,6 +602,7 @@ void
 ChannelAccessManagerTest<TxopType>::StartTest (uint64_t slotTime, uint64_t sifs, uint64_t eifsNoDifsNoSifs, uint32_t ackTimeoutValue)
 {
   m_ChannelAccessManager = CreateObject<ChannelAccessManagerStub> ();
+  m_ChannelAccessManager->SetAttribute ("CacheBackoffDeadlines", BooleanValue (m_cacheBackoffDeadlines));
   m_low = CreateObject<MacLowStub> ();
   m_ChannelAccessManager->SetupLow (m_low);
   m_ChannelAccessManager->SetSlot (MicroSeconds (slotTime));
@@ -1236,7 +1245,8 @@ public:
 TxopTestSuite::TxopTestSuite ()
   : TestSuite ("wifi-devices-dcf", UNIT)
 {
-  AddTestCase (new ChannelAccessManagerTest<Txop>, TestCase::QUICK);
+  AddTestCase (new ChannelAccessManagerTest<Txop> (false), TestCase::QUICK);
+  AddTestCase (new ChannelAccessManagerTest<Txop> (true), TestCase::QUICK);
 }
 
 static TxopTestSuite g_dcfTestSuite;
@@ -1256,7 +1266,8 @@ public:
 QosTxopTestSuite::QosTxopTestSuite ()
   : TestSuite ("wifi-devices-edca", UNIT)
 {
-  AddTestCase (new ChannelAccessManagerTest<QosTxop>, TestCase::QUICK);
+  AddTestCase (new ChannelAccessManagerTest<QosTxop> (false), TestCase::QUICK);
+  AddTestCase (new ChannelAccessManagerTest<QosTxop> (true), TestCase::QUICK);
 }
 
 static QosTxopTestSuite g_edcaTestSuite;
@@ -239,6 +239,31 @@ AmpduAggregationTest::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_mac->GetBEQueue ()->m_currentPacket, 0, "packet should be discarded");
   m_mac->GetBEQueue ()->GetWifiMacQueue ()->Remove (pkt3);
 
+  //-----------------------------------------------------------------------------------------------------
+
+  /*
+   * Test that the size and duration checks performed while planning an A-MPDU
+   * give the same results as the checks performed without planning.
+   */
+  Ptr<MacLow> low = m_mac->GetBEQueue ()->GetLow ();
+  Time ppduDurationLimit = MicroSeconds (1504);
+  std::vector<bool> expected;
+  for (uint32_t ampduSize = 0; ampduSize < 65535; ampduSize += 997)
+    {
+      expected.push_back (low->IsWithinSizeAndTimeLimits (1500, hdr.GetAddr1 (), 0, txVector,
+                                                          ampduSize, ppduDurationLimit));
+    }
+  NS_TEST_EXPECT_MSG_EQ (expected.front (), true, "an MPDU of 1500 bytes should meet the limits");
+  NS_TEST_EXPECT_MSG_EQ (expected.back (), false, "a 64 KB A-MPDU should not meet the duration limit");
+  low->StartAmpduPlanning (hdr.GetAddr1 (), 0, txVector, ppduDurationLimit);
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (low->IsWithinSizeAndTimeLimits (1500, hdr.GetAddr1 (), 0, txVector,
+                                                             i * 997, ppduDurationLimit),
+                             expected[i], "Unexpected result of the check while planning an A-MPDU");
+    }
+  low->StopAmpduPlanning ();
+
   Simulator::Destroy ();
 
   m_manager->Dispose ();
@@ -27,6 +27,14 @@
 #include "ns3/wifi-phy.h"
 #include "ns3/wifi-utils.h"
 #include "ns3/table-based-error-rate-model.h"
+#include "ns3/error-rate-lookup-table.h"
+#include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-ppdu.h"
+#include "ns3/interference-helper.h"
 
 using namespace ns3;
 
@@ -1051,6 +1059,203 @@ TableBasedErrorRateTestCase::DoRun (void)
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the SNR lookup tables of the NIST and YANS error rate
+ * models stay within the configured accuracy bound of the analytic model
+ */
+class ErrorRateLookupTableTestCase : public TestCase
+{
+public:
+  ErrorRateLookupTableTestCase ();
+  virtual ~ErrorRateLookupTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare the chunk success rates returned by an error rate model configured
+   * with a lookup table against the ones returned by the analytic model.
+   *
+   * \param analytic the analytic error rate model
+   * \param tabulated the same error rate model with a lookup table
+   * \param maxError the per-bit accuracy bound of the lookup table
+   */
+  void CompareModels (Ptr<ErrorRateModel> analytic, Ptr<ErrorRateModel> tabulated, double maxError);
+};
+
+ErrorRateLookupTableTestCase::ErrorRateLookupTableTestCase ()
+  : TestCase ("WifiErrorRateModel test case lookup table")
+{
+}
+
+ErrorRateLookupTableTestCase::~ErrorRateLookupTableTestCase ()
+{
+}
+
+void
+ErrorRateLookupTableTestCase::CompareModels (Ptr<ErrorRateModel> analytic, Ptr<ErrorRateModel> tabulated, double maxError)
+{
+  std::vector<WifiMode> modes {WifiPhy::GetOfdmRate6Mbps (), WifiPhy::GetOfdmRate54Mbps (),
+                               WifiPhy::GetHtMcs0 (), WifiPhy::GetHtMcs4 (), WifiPhy::GetVhtMcs8 (),
+                               WifiPhy::GetHeMcs11 ()};
+  for (const auto &mode : modes)
+    {
+      WifiTxVector txVector;
+      txVector.SetMode (mode);
+      txVector.SetChannelWidth (20);
+      for (uint64_t nbits : {8, 32 * 8, 1500 * 8})
+        {
+          for (double snr = -5.0; snr <= 45.0; snr += 0.37)
+            {
+              double expected = analytic->GetChunkSuccessRate (mode, txVector, std::pow (10.0, snr / 10.0), nbits);
+              double actual = tabulated->GetChunkSuccessRate (mode, txVector, std::pow (10.0, snr / 10.0), nbits);
+              NS_TEST_ASSERT_MSG_EQ_TOL (actual, expected, nbits * maxError,
+                                         mode << " snr=" << snr << "dB nbits=" << nbits << ": not equal within tolerance");
+            }
+        }
+    }
+}
+
+void
+ErrorRateLookupTableTestCase::DoRun (void)
+{
+  double maxError = 1e-6;
+  Ptr<ErrorRateLookupTable> table = CreateObject<ErrorRateLookupTable> ();
+  table->SetAttribute ("MaxError", DoubleValue (maxError));
+
+  Ptr<NistErrorRateModel> nist = CreateObject<NistErrorRateModel> ();
+  Ptr<NistErrorRateModel> nistTable = CreateObject<NistErrorRateModel> ();
+  nistTable->SetAttribute ("LookupTable", PointerValue (table));
+  CompareModels (nist, nistTable, maxError);
+
+  //the same table object can be shared by models of different types
+  Ptr<YansErrorRateModel> yans = CreateObject<YansErrorRateModel> ();
+  Ptr<YansErrorRateModel> yansTable = CreateObject<YansErrorRateModel> ();
+  yansTable->SetAttribute ("LookupTable", PointerValue (table));
+  CompareModels (yans, yansTable, maxError);
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief PPDU-level abstraction of the InterferenceHelper
+ *
+ * A HT PPDU is received with or without a foreign signal covering its second
+ * half. Without interference, the abstraction must yield the same PHY header
+ * and payload error rates as the chunk-based evaluation; with interference,
+ * both evaluations must report a degraded payload.
+ */
+class PpduAbstractionTestCase : public TestCase
+{
+public:
+  PpduAbstractionTestCase ();
+  virtual ~PpduAbstractionTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Receive a PPDU and store the resulting error rates.
+   *
+   * \param abstraction whether the PPDU-level abstraction is enabled
+   * \param interferenceW the power of the foreign signal (W), or zero for none
+   */
+  void Receive (bool abstraction, double interferenceW);
+  /**
+   * Evaluate the error rates of the PPDU being received.
+   *
+   * \param event the event of the PPDU
+   */
+  void Evaluate (Ptr<Event> event);
+
+  InterferenceHelper *m_interference; //!< the interference helper under test
+  WifiTxVector m_txVector;            //!< TXVECTOR of the PPDU
+  Time m_payloadDuration;             //!< duration of the PPDU payload
+  double m_headerPer;                 //!< HT PHY header error rate
+  double m_lSigPer;                   //!< L-SIG error rate
+  double m_payloadPer;                //!< payload error rate
+};
+
+PpduAbstractionTestCase::PpduAbstractionTestCase ()
+  : TestCase ("PPDU-level abstraction of the InterferenceHelper")
+{
+}
+
+PpduAbstractionTestCase::~PpduAbstractionTestCase ()
+{
+}
+
+void
+PpduAbstractionTestCase::Evaluate (Ptr<Event> event)
+{
+  WifiSpectrumBand band = std::make_pair (0, 0);
+  m_lSigPer = m_interference->CalculateNonHtPhyHeaderSnrPer (event, band).per;
+  m_headerPer = m_interference->CalculateHtPhyHeaderSnrPer (event, band).per;
+  m_payloadPer = m_interference->CalculatePayloadSnrPer (event, 20, band, SU_STA_ID,
+                                                         std::make_pair (Seconds (0), m_payloadDuration)).per;
+}
+
+void
+PpduAbstractionTestCase::Receive (bool abstraction, double interferenceW)
+{
+  WifiSpectrumBand band = std::make_pair (0, 0);
+  InterferenceHelper interference;
+  m_interference = &interference;
+  interference.AddBand (band);
+  interference.SetNoiseFigure (DbToRatio (7));
+  interference.SetErrorRateModel (CreateObject<TableBasedErrorRateModel> ());
+  interference.SetPpduAbstraction (abstraction);
+
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (Create<Packet> (1000), hdr);
+  Time duration = WifiPhy::CalculateTxDuration (psdu->GetSize (), m_txVector, WIFI_PHY_BAND_5GHZ);
+  m_payloadDuration = duration - WifiPhy::CalculatePhyPreambleAndHeaderDuration (m_txVector);
+  Ptr<WifiPpdu> ppdu = Create<WifiPpdu> (psdu, m_txVector, duration, WIFI_PHY_BAND_5GHZ);
+
+  RxPowerWattPerChannelBand rxPower;
+  rxPower[band] = DbmToW (-72);
+  Ptr<Event> event = interference.Add (ppdu, m_txVector, duration, rxPower);
+  interference.NotifyRxStart ();
+  if (interferenceW > 0)
+    {
+      rxPower[band] = interferenceW;
+      Simulator::Schedule (duration / 2, &InterferenceHelper::AddForeignSignal, &interference, duration, rxPower);
+    }
+  Simulator::Schedule (duration, &PpduAbstractionTestCase::Evaluate, this, event);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_interference = 0;
+}
+
+void
+PpduAbstractionTestCase::DoRun (void)
+{
+  m_txVector.SetMode (WifiPhy::GetHtMcs7 ());
+  m_txVector.SetPreambleType (WIFI_PREAMBLE_HT_MF);
+  m_txVector.SetChannelWidth (20);
+
+  Receive (false, 0);
+  double lSigPer = m_lSigPer;
+  double headerPer = m_headerPer;
+  double payloadPer = m_payloadPer;
+  Receive (true, 0);
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_lSigPer, lSigPer, 1e-12, "L-SIG error rate differs without interference");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_headerPer, headerPer, 1e-12, "HT PHY header error rate differs without interference");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_payloadPer, payloadPer, 1e-12, "Payload error rate differs without interference");
+  NS_TEST_ASSERT_MSG_LT (payloadPer, 0.1, "Payload should be received without interference");
+
+  double interferenceW = DbmToW (-85);
+  Receive (false, interferenceW);
+  NS_TEST_ASSERT_MSG_GT (m_payloadPer, payloadPer, "Interference should degrade the payload");
+  double chunkPayloadPer = m_payloadPer;
+  Receive (true, interferenceW);
+  NS_TEST_ASSERT_MSG_GT (m_payloadPer, payloadPer, "Interference should degrade the abstracted payload");
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (m_payloadPer, chunkPayloadPer, "Averaging cannot be more pessimistic than the worst chunk");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1069,6 +1274,8 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
   AddTestCase (new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseMimo, TestCase::QUICK);
+  AddTestCase (new ErrorRateLookupTableTestCase, TestCase::QUICK);
+  AddTestCase (new PpduAbstractionTestCase, TestCase::QUICK);
   AddTestCase (new TableBasedErrorRateTestCase ("DefaultTableBasedHtMcs0-1458bytes", WifiPhy::GetHtMcs0 (), 1458), TestCase::QUICK);
   AddTestCase (new TableBasedErrorRateTestCase ("DefaultTableBasedHtMcs0-32bytes", WifiPhy::GetHtMcs0 (), 32), TestCase::QUICK);
   AddTestCase (new TableBasedErrorRateTestCase ("DefaultTableBasedHtMcs0-1000bytes", WifiPhy::GetHtMcs0 (), 1000), TestCase::QUICK);
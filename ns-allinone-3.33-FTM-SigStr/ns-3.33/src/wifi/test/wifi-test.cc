@@ -22,6 +22,8 @@
  */
 
 #include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/wifi-net-device.h"
@@ -48,6 +50,17 @@
 #include "ns3/wifi-ppdu.h"
 #include "ns3/wifi-psdu.h"
 #include "ns3/waypoint-mobility-model.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/wifi-mac-header-view.h"
+#include "ns3/wifi-mac-trailer.h"
+#include "ns3/sta-wifi-mac.h"
+#include "ns3/wifi-profiler.h"
+#include "ns3/regular-wifi-mac.h"
+#include "ns3/minstrel-ht-wifi-manager.h"
+#include "ns3/ht-capabilities.h"
+
+#include <sstream>
+#include <thread>
 
 using namespace ns3;
 
@@ -3050,6 +3063,893 @@ HeRuMcsDataRateTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (retval, true, "Data rate verification for RUs above 52-tone RU (included) failed");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief WifiMacQueue per-(TID, destination) index test
+ *
+ * QoS data frames for several TIDs and destinations are enqueued, pushed at
+ * the front, inserted in the middle and removed in an interleaved order. After
+ * each operation, the first frame and the number of frames of every
+ * (TID, destination) pair are checked against a scan of the whole queue.
+ */
+class WifiMacQueueFlowIndexTest : public TestCase
+{
+public:
+  WifiMacQueueFlowIndexTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Create a QoS data frame
+   * \param tid the TID
+   * \param dest the destination
+   * \param seqNo the sequence number
+   * \return the frame
+   */
+  Ptr<WifiMacQueueItem> CreateItem (uint8_t tid, Mac48Address dest, uint16_t seqNo) const;
+  /**
+   * Check that the index agrees with a scan of the queue for all flows
+   * \param queue the queue
+   * \param step the step of the test
+   */
+  void CheckFlows (Ptr<WifiMacQueue> queue, uint32_t step);
+
+  std::vector<Mac48Address> m_dests; ///< destination addresses
+};
+
+WifiMacQueueFlowIndexTest::WifiMacQueueFlowIndexTest ()
+  : TestCase ("Check the per-(TID, destination) index of the WifiMacQueue")
+{
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueueFlowIndexTest::CreateItem (uint8_t tid, Mac48Address dest, uint16_t seqNo) const
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetAddr1 (dest);
+  hdr.SetQosTid (tid);
+  hdr.SetSequenceNumber (seqNo);
+  return Create<WifiMacQueueItem> (Create<Packet> (100), hdr);
+}
+
+void
+WifiMacQueueFlowIndexTest::CheckFlows (Ptr<WifiMacQueue> queue, uint32_t step)
+{
+  for (uint8_t tid = 0; tid < 3; tid++)
+    {
+      for (const auto &dest : m_dests)
+        {
+          WifiMacQueue::ConstIterator first = queue->end ();
+          uint32_t count = 0;
+          for (auto it = queue->begin (); it != queue->end (); it++)
+            {
+              if ((*it)->GetHeader ().GetQosTid () == tid && (*it)->GetDestinationAddress () == dest)
+                {
+                  if (count++ == 0)
+                    {
+                      first = it;
+                    }
+                }
+            }
+          NS_TEST_EXPECT_MSG_EQ ((queue->PeekByTidAndAddress (tid, dest) == first), true,
+                                 "Unexpected first frame for TID " << +tid << " and " << dest << " at step " << step);
+          NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (tid, dest), count,
+                                 "Unexpected number of frames for TID " << +tid << " and " << dest << " at step " << step);
+        }
+    }
+}
+
+void
+WifiMacQueueFlowIndexTest::DoRun (void)
+{
+  Ptr<WifiMacQueue> queue = CreateObject<WifiMacQueue> ();
+  m_dests = {Mac48Address ("00:00:00:00:00:01"), Mac48Address ("00:00:00:00:00:02"), Mac48Address ("00:00:00:00:00:03")};
+  uint32_t step = 0;
+  uint16_t seqNo = 0;
+
+  // interleaved enqueue
+  for (uint8_t i = 0; i < 18; i++)
+    {
+      queue->Enqueue (CreateItem (i % 3, m_dests[(i / 3) % 3], seqNo++));
+    }
+  CheckFlows (queue, step++);
+
+  // push at the front a frame of a flow already in the queue and of a new flow
+  queue->PushFront (CreateItem (1, m_dests[2], seqNo++));
+  queue->PushFront (CreateItem (2, Mac48Address ("00:00:00:00:00:04"), seqNo++));
+  m_dests.push_back (Mac48Address ("00:00:00:00:00:04"));
+  CheckFlows (queue, step++);
+
+  // insert in the middle of the queue, before a frame of another flow
+  auto pos = queue->PeekByTidAndAddress (0, m_dests[1]);
+  pos = queue->PeekByTidAndAddress (0, m_dests[1], ++pos);
+  queue->Insert (pos, CreateItem (1, m_dests[2], seqNo++));
+  queue->Insert (pos, CreateItem (0, m_dests[1], seqNo++));
+  CheckFlows (queue, step++);
+
+  // dequeue the head of a flow, then remove a frame in the middle of another one
+  Ptr<WifiMacQueueItem> item = queue->DequeueByTidAndAddress (1, m_dests[2]);
+  NS_TEST_ASSERT_MSG_NE (item, 0, "Expected a frame to be dequeued");
+  NS_TEST_EXPECT_MSG_EQ (item->GetHeader ().GetSequenceNumber (), 18, "Unexpected frame dequeued");
+  CheckFlows (queue, step++);
+  pos = queue->PeekByTidAndAddress (2, m_dests[0]);
+  pos = queue->PeekByTidAndAddress (2, m_dests[0], ++pos);
+  queue->Remove (pos);
+  CheckFlows (queue, step++);
+
+  // drain the queue in FIFO order
+  while (queue->Dequeue () != 0)
+    {
+      CheckFlows (queue, step++);
+    }
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPackets (), 0, "The queue should be empty");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that a WifiMacHeaderView decodes the same fields as a
+ * deserialized WifiMacHeader, for every address layout of the MAC header.
+ */
+class WifiMacHeaderViewTest : public TestCase
+{
+public:
+  WifiMacHeaderViewTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Serialize the given header in front of a payload and compare the view
+   * of the resulting packet with the header.
+   *
+   * \param hdr the MAC header
+   */
+  void CheckView (const WifiMacHeader &hdr);
+};
+
+WifiMacHeaderViewTest::WifiMacHeaderViewTest ()
+  : TestCase ("Check the decoding of MAC headers by WifiMacHeaderView")
+{
+}
+
+void
+WifiMacHeaderViewTest::CheckView (const WifiMacHeader &hdr)
+{
+  Ptr<Packet> packet = Create<Packet> (100);
+  packet->AddHeader (hdr);
+  WifiMacHeaderView view (packet);
+  std::string type = hdr.GetTypeString ();
+
+  NS_TEST_ASSERT_MSG_EQ (view.IsValid (), true, "View of a " << type << " header should be valid");
+  NS_TEST_EXPECT_MSG_EQ (view.GetSize (), hdr.GetSerializedSize (), "Unexpected size of a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.GetType (), hdr.GetType (), "Unexpected type of a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.IsMgt (), hdr.IsMgt (), "Unexpected IsMgt for a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.IsCtl (), hdr.IsCtl (), "Unexpected IsCtl for a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.IsData (), hdr.IsData (), "Unexpected IsData for a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.IsQosData (), hdr.IsQosData (), "Unexpected IsQosData for a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.IsAction (), hdr.IsAction (), "Unexpected IsAction for a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.IsAck (), hdr.IsAck (), "Unexpected IsAck for a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.IsToDs (), hdr.IsToDs (), "Unexpected IsToDs for a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.IsFromDs (), hdr.IsFromDs (), "Unexpected IsFromDs for a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.IsRetry (), hdr.IsRetry (), "Unexpected IsRetry for a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.GetDuration (), hdr.GetDuration (), "Unexpected duration of a " << type << " header");
+  NS_TEST_EXPECT_MSG_EQ (view.GetAddr1 (), hdr.GetAddr1 (), "Unexpected Address 1 of a " << type << " header");
+  if (hdr.GetSerializedSize () >= 16)
+    {
+      NS_TEST_EXPECT_MSG_EQ (view.GetAddr2 (), hdr.GetAddr2 (), "Unexpected Address 2 of a " << type << " header");
+    }
+  if (hdr.IsMgt () || hdr.IsData ())
+    {
+      NS_TEST_EXPECT_MSG_EQ (view.GetAddr3 (), hdr.GetAddr3 (), "Unexpected Address 3 of a " << type << " header");
+      NS_TEST_EXPECT_MSG_EQ (view.GetSequenceNumber (), hdr.GetSequenceNumber (), "Unexpected sequence number of a " << type << " header");
+      NS_TEST_EXPECT_MSG_EQ (+view.GetFragmentNumber (), +hdr.GetFragmentNumber (), "Unexpected fragment number of a " << type << " header");
+    }
+  if (hdr.IsData () && hdr.IsToDs () && hdr.IsFromDs ())
+    {
+      NS_TEST_EXPECT_MSG_EQ (view.GetAddr4 (), hdr.GetAddr4 (), "Unexpected Address 4 of a " << type << " header");
+    }
+  if (hdr.IsQosData ())
+    {
+      NS_TEST_EXPECT_MSG_EQ (+view.GetQosTid (), +hdr.GetQosTid (), "Unexpected TID of a " << type << " header");
+    }
+
+  uint8_t buffer[WifiMacHeaderView::MAX_SIZE];
+  uint32_t size = packet->CopyData (buffer, hdr.GetSerializedSize () - 1);
+  NS_TEST_EXPECT_MSG_EQ (WifiMacHeaderView (buffer, size).IsValid (), false, "View of a truncated " << type << " header should be invalid");
+}
+
+void
+WifiMacHeaderViewTest::DoRun (void)
+{
+  WifiMacHeader hdr;
+  hdr.SetAddr1 (Mac48Address ("00:00:00:00:00:01"));
+  hdr.SetAddr2 (Mac48Address ("00:00:00:00:00:02"));
+  hdr.SetAddr3 (Mac48Address ("00:00:00:00:00:03"));
+  hdr.SetAddr4 (Mac48Address ("00:00:00:00:00:04"));
+  hdr.SetDuration (MicroSeconds (44));
+  hdr.SetSequenceNumber (1234);
+  hdr.SetFragmentNumber (3);
+  hdr.SetRetry ();
+
+  for (WifiMacType type : {WIFI_MAC_QOSDATA, WIFI_MAC_DATA, WIFI_MAC_MGT_ACTION, WIFI_MAC_MGT_BEACON,
+                           WIFI_MAC_CTL_ACK, WIFI_MAC_CTL_RTS, WIFI_MAC_CTL_BACKRESP})
+    {
+      hdr.SetType (type);
+      if (hdr.IsQosData ())
+        {
+          hdr.SetQosTid (5);
+        }
+      for (uint8_t ds = 0; ds < 4; ds++)
+        {
+          (ds & 0x01) ? hdr.SetDsTo () : hdr.SetDsNotTo ();
+          (ds & 0x02) ? hdr.SetDsFrom () : hdr.SetDsNotFrom ();
+          CheckView (hdr);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the partitioning of a YansWifiChannel by logical process.
+ *
+ * Two pairs of ad hoc nodes share one YansWifiChannel: the first pair is tuned
+ * to channel 36 and belongs to the local logical process (system ID 0), the
+ * second pair is tuned to channel 40 and belongs to another logical process
+ * (system ID 1). Each pair exchanges a broadcast frame. When the channel is
+ * partitioned, the frame sent by the remote pair is left to the logical
+ * process owning it and is not received locally.
+ */
+class YansWifiChannelPartitionTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param partitioned whether the channel is partitioned
+   */
+  YansWifiChannelPartitionTest (bool partitioned);
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Callback when a PHY starts receiving a PPDU
+   * \param context the index of the node
+   * \param p the packet
+   * \param rxPowersW the received power per band
+   */
+  void PhyRxBegin (std::string context, Ptr<const Packet> p, RxPowerWattPerChannelBand rxPowersW);
+  /**
+   * Send a broadcast frame
+   * \param dev the device
+   */
+  void SendBroadcast (Ptr<NetDevice> dev);
+
+  bool m_partitioned;              ///< whether the channel is partitioned
+  std::vector<uint32_t> m_rxCount; ///< number of PPDUs received per node
+};
+
+YansWifiChannelPartitionTest::YansWifiChannelPartitionTest (bool partitioned)
+  : TestCase (std::string ("Check partitioning of a YansWifiChannel by logical process, partitioned=") + (partitioned ? "true" : "false")),
+    m_partitioned (partitioned)
+{
+}
+
+void
+YansWifiChannelPartitionTest::PhyRxBegin (std::string context, Ptr<const Packet> p, RxPowerWattPerChannelBand rxPowersW)
+{
+  m_rxCount.at (std::stoul (context))++;
+}
+
+void
+YansWifiChannelPartitionTest::SendBroadcast (Ptr<NetDevice> dev)
+{
+  dev->Send (Create<Packet> (100), dev->GetBroadcast (), 1);
+}
+
+void
+YansWifiChannelPartitionTest::DoRun (void)
+{
+  NodeContainer localNodes;
+  localNodes.Create (2, 0);
+  NodeContainer remoteNodes;
+  remoteNodes.Create (2, 1);
+
+  YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default ();
+  Ptr<YansWifiChannel> channel = channelHelper.Create ();
+  channel->SetAttribute ("Partitioned", BooleanValue (m_partitioned));
+  YansWifiPhyHelper phy;
+  phy.SetChannel (channel);
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager");
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+
+  phy.Set ("ChannelNumber", UintegerValue (36));
+  NetDeviceContainer devices = wifi.Install (phy, mac, localNodes);
+  phy.Set ("ChannelNumber", UintegerValue (40));
+  devices.Add (wifi.Install (phy, mac, remoteNodes));
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (localNodes);
+  mobility.Install (remoteNodes);
+
+  m_rxCount.assign (devices.GetN (), 0);
+  for (uint32_t i = 0; i < devices.GetN (); i++)
+    {
+      DynamicCast<WifiNetDevice> (devices.Get (i))->GetPhy ()->TraceConnect ("PhyRxBegin", std::to_string (i),
+                                                                             MakeCallback (&YansWifiChannelPartitionTest::PhyRxBegin, this));
+    }
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannelPartitionTest::SendBroadcast, this, devices.Get (0));
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannelPartitionTest::SendBroadcast, this, devices.Get (2));
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_rxCount[0], 0, "The sender should not receive its own frame");
+  NS_TEST_EXPECT_MSG_EQ (m_rxCount[1], 1, "The local frame should be received on channel 36");
+  NS_TEST_EXPECT_MSG_EQ (m_rxCount[2], 0, "The sender should not receive its own frame");
+  NS_TEST_EXPECT_MSG_EQ (m_rxCount[3], (m_partitioned ? 0 : 1), "The remote frame should only be received when the channel is not partitioned");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the beacon template and the beacon abstraction of ApWifiMac
+ *
+ * An 802.11ax AP and a STA using active probing are simulated for two
+ * seconds. The bodies of the beacons transmitted by the AP must not depend
+ * on whether the beacon template is enabled. When the beacon abstraction is
+ * enabled, no beacon must be transmitted over the channel, while the STA
+ * must keep receiving beacons and stay associated.
+ */
+class BeaconTemplateTest : public TestCase
+{
+public:
+  BeaconTemplateTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Run the simulation
+   * \param enableTemplate the value of the EnableBeaconTemplate attribute
+   * \param abstraction the value of the BeaconAbstraction attribute
+   */
+  void RunOne (bool enableTemplate, bool abstraction);
+  /**
+   * Callback when the AP PHY starts transmitting a PSDU
+   * \param p the packet
+   * \param txPowerW the transmit power in Watts
+   */
+  void PhyTxBegin (Ptr<const Packet> p, double txPowerW);
+  /**
+   * Callback when the STA receives a beacon from its AP
+   * \param time the time of arrival
+   */
+  void BeaconArrival (Time time);
+
+  std::vector<std::vector<uint8_t> > m_beacons; ///< bodies of the beacons transmitted by the AP
+  uint32_t m_beaconArrivals;                    ///< number of beacons received by the STA from its AP
+  bool m_associated;                            ///< whether the STA is associated at the end of the simulation
+};
+
+BeaconTemplateTest::BeaconTemplateTest ()
+  : TestCase ("Check the beacon template and the beacon abstraction of ApWifiMac"),
+    m_beaconArrivals (0),
+    m_associated (false)
+{
+}
+
+void
+BeaconTemplateTest::PhyTxBegin (Ptr<const Packet> p, double txPowerW)
+{
+  Ptr<Packet> copy = p->Copy ();
+  WifiMacHeader hdr;
+  copy->RemoveHeader (hdr);
+  if (!hdr.IsBeacon ())
+    {
+      return;
+    }
+  WifiMacTrailer fcs;
+  copy->RemoveTrailer (fcs);
+  std::vector<uint8_t> body (copy->GetSize ());
+  copy->CopyData (body.data (), body.size ());
+  m_beacons.push_back (body);
+}
+
+void
+BeaconTemplateTest::BeaconArrival (Time time)
+{
+  m_beaconArrivals++;
+}
+
+void
+BeaconTemplateTest::RunOne (bool enableTemplate, bool abstraction)
+{
+  m_beacons.clear ();
+  m_beaconArrivals = 0;
+  m_associated = false;
+
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+  int64_t streamNumber = 1;
+
+  NodeContainer apNode;
+  apNode.Create (1);
+  NodeContainer staNode;
+  staNode.Create (1);
+
+  YansWifiPhyHelper phy;
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211ax_5GHZ);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager");
+
+  WifiMacHelper mac;
+  mac.SetType ("ns3::ApWifiMac",
+               "EnableBeaconTemplate", BooleanValue (enableTemplate),
+               "BeaconAbstraction", BooleanValue (abstraction));
+  NetDeviceContainer apDevice = wifi.Install (phy, mac, apNode);
+  mac.SetType ("ns3::StaWifiMac",
+               "ActiveProbing", BooleanValue (true));
+  NetDeviceContainer staDevice = wifi.Install (phy, mac, staNode);
+
+  wifi.AssignStreams (apDevice, streamNumber);
+  wifi.AssignStreams (staDevice, streamNumber + 1);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (1.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (apNode);
+  mobility.Install (staNode);
+
+  DynamicCast<WifiNetDevice> (apDevice.Get (0))->GetPhy ()->TraceConnectWithoutContext ("PhyTxBegin", MakeCallback (&BeaconTemplateTest::PhyTxBegin, this));
+  Ptr<StaWifiMac> staMac = DynamicCast<StaWifiMac> (DynamicCast<WifiNetDevice> (staDevice.Get (0))->GetMac ());
+  staMac->TraceConnectWithoutContext ("BeaconArrival", MakeCallback (&BeaconTemplateTest::BeaconArrival, this));
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+  m_associated = staMac->IsAssociated ();
+  Simulator::Destroy ();
+}
+
+void
+BeaconTemplateTest::DoRun (void)
+{
+  RunOne (false, false);
+  std::vector<std::vector<uint8_t> > reference = m_beacons;
+  NS_TEST_ASSERT_MSG_GT (reference.size (), 10, "Beacons should be transmitted over the channel");
+
+  RunOne (true, false);
+  NS_TEST_ASSERT_MSG_EQ (m_beacons.size (), reference.size (), "The beacon template should not change the number of beacons");
+  for (std::size_t i = 0; i < reference.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((m_beacons[i] == reference[i]), true, "Beacon " << i << " differs from the one built without template");
+    }
+
+  RunOne (true, true);
+  NS_TEST_EXPECT_MSG_EQ (m_beacons.size (), 0, "No beacon should be transmitted over the channel");
+  NS_TEST_EXPECT_MSG_GT (m_beaconArrivals, 10, "The associated STA should keep receiving beacons");
+  NS_TEST_EXPECT_MSG_EQ (m_associated, true, "The STA should still be associated");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the Wi-Fi profiling counters
+ *
+ * Two ad hoc nodes exchange a broadcast frame, first with profiling disabled
+ * and then with profiling enabled. Counters must only be updated in the
+ * latter case, in the context of the node running each stage, and must be
+ * reset when the simulator is destroyed. A stage entered from within itself
+ * must only be counted once, while a stage entered by another thread must be
+ * counted separately. Printing the report must not alter the stream format.
+ */
+class WifiProfilerTest : public TestCase
+{
+public:
+  WifiProfilerTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Run the simulation until the broadcast frame is received, without
+   * destroying the simulator
+   * \param enable whether profiling is enabled
+   */
+  void RunOne (bool enable);
+  /**
+   * Send a broadcast frame
+   * \param dev the device
+   */
+  void SendBroadcast (Ptr<NetDevice> dev);
+};
+
+WifiProfilerTest::WifiProfilerTest ()
+  : TestCase ("Check the Wi-Fi profiling counters")
+{
+}
+
+void
+WifiProfilerTest::SendBroadcast (Ptr<NetDevice> dev)
+{
+  dev->Send (Create<Packet> (100), dev->GetBroadcast (), 1);
+}
+
+void
+WifiProfilerTest::RunOne (bool enable)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  YansWifiPhyHelper phy;
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager");
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  if (enable)
+    {
+      WifiProfiler::Enable (false);
+    }
+  Simulator::ScheduleWithContext (nodes.Get (0)->GetId (), Seconds (1.0), &WifiProfilerTest::SendBroadcast, this, devices.Get (0));
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+}
+
+void
+WifiProfilerTest::DoRun (void)
+{
+  RunOne (false);
+  NS_TEST_EXPECT_MSG_EQ (WifiProfiler::IsEnabled (), false, "Profiling should be disabled by default");
+  NS_TEST_EXPECT_MSG_EQ (WifiProfiler::GetCount (0, WifiProfiler::CHANNEL_SEND), 0, "No stage should be counted when profiling is disabled");
+  Simulator::Destroy ();
+
+  RunOne (true);
+  NS_TEST_EXPECT_MSG_EQ (WifiProfiler::GetCount (0, WifiProfiler::CHANNEL_SEND), 1, "The sender should have transmitted one frame");
+  NS_TEST_EXPECT_MSG_EQ (WifiProfiler::GetCount (1, WifiProfiler::CHANNEL_SEND), 0, "The receiver should not have transmitted");
+  NS_TEST_EXPECT_MSG_GT (WifiProfiler::GetCount (1, WifiProfiler::SNR_PER), 0, "The receiver should have computed the SNR and the PER");
+  NS_TEST_EXPECT_MSG_EQ (WifiProfiler::GetCount (1, WifiProfiler::MAC_LOW_RECEIVE), 1, "The receiver MacLow should have received one frame");
+  NS_TEST_EXPECT_MSG_GT (WifiProfiler::GetSeconds (1, WifiProfiler::MAC_LOW_RECEIVE), 0, "Time spent in MacLow should be accounted");
+  uint32_t context = Simulator::GetContext ();
+  uint64_t count = WifiProfiler::GetCount (context, WifiProfiler::AGGREGATION);
+  {
+    WifiProfiler::Scope outer (WifiProfiler::AGGREGATION);
+    WifiProfiler::Scope inner (WifiProfiler::AGGREGATION);
+  }
+  NS_TEST_EXPECT_MSG_EQ (WifiProfiler::GetCount (context, WifiProfiler::AGGREGATION), count + 1, "Nested scopes of the same stage should be counted once");
+  {
+    WifiProfiler::Scope outer (WifiProfiler::AGGREGATION);
+    std::thread thread ([] ()
+                        {
+                          WifiProfiler::Scope scope (WifiProfiler::AGGREGATION);
+                        });
+    thread.join ();
+  }
+  NS_TEST_EXPECT_MSG_EQ (WifiProfiler::GetCount (context, WifiProfiler::AGGREGATION), count + 3, "Scopes of the same stage in different threads should both be counted");
+  std::ostringstream os;
+  os << std::hex;
+  os.precision (2);
+  std::ios_base::fmtflags flags = os.flags ();
+  WifiProfiler::Print (os);
+  NS_TEST_EXPECT_MSG_EQ ((os.flags () == flags), true, "The format flags of the stream should be restored");
+  NS_TEST_EXPECT_MSG_EQ (os.precision (), 2, "The precision of the stream should be restored");
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (WifiProfiler::IsEnabled (), false, "Profiling should be disabled once the simulator is destroyed");
+  NS_TEST_EXPECT_MSG_EQ (WifiProfiler::GetCount (0, WifiProfiler::CHANNEL_SEND), 0, "Counters should be reset once the simulator is destroyed");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the registration-based dispatch of received Action frames
+ *
+ * A handler is registered on an ad hoc station for Self Protected Peer Link
+ * Open frames, which RegularWifiMac does not handle itself. Another station
+ * sends two such frames, the second one after the handler has been
+ * replaced. Each frame must be delivered to the handler registered at the
+ * time it is received, with its body starting after the Action header.
+ */
+class ActionFrameDispatchTest : public TestCase
+{
+public:
+  ActionFrameDispatchTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Send a Peer Link Open frame
+   * \param sender the MAC of the sender
+   * \param receiver the address of the receiver
+   */
+  void SendPeerLinkOpen (Ptr<RegularWifiMac> sender, Mac48Address receiver);
+  /**
+   * First handler of the Peer Link Open frames
+   * \param packet the frame body following the Action header
+   * \param hdr the MAC header of the frame
+   */
+  void FirstHandler (Ptr<Packet> packet, const WifiMacHeader &hdr);
+  /**
+   * Second handler of the Peer Link Open frames
+   * \param packet the frame body following the Action header
+   * \param hdr the MAC header of the frame
+   */
+  void SecondHandler (Ptr<Packet> packet, const WifiMacHeader &hdr);
+  /**
+   * Record a Peer Link Open frame received by a handler
+   * \param index the index of the handler
+   * \param packet the frame body following the Action header
+   * \param hdr the MAC header of the frame
+   */
+  void Record (uint8_t index, Ptr<Packet> packet, const WifiMacHeader &hdr);
+
+  std::vector<uint32_t> m_received; ///< number of frames received per handler
+  uint32_t m_bodySize;              ///< size of the body of the last received frame
+  Mac48Address m_sender;            ///< sender of the last received frame
+};
+
+ActionFrameDispatchTest::ActionFrameDispatchTest ()
+  : TestCase ("Check the registration-based dispatch of received Action frames"),
+    m_received (2, 0),
+    m_bodySize (0)
+{
+}
+
+void
+ActionFrameDispatchTest::SendPeerLinkOpen (Ptr<RegularWifiMac> sender, Mac48Address receiver)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_MGT_ACTION);
+  hdr.SetAddr1 (receiver);
+  hdr.SetAddr2 (sender->GetAddress ());
+  hdr.SetAddr3 (sender->GetBssid ());
+  hdr.SetDsNotFrom ();
+  hdr.SetDsNotTo ();
+  Ptr<Packet> packet = Create<Packet> (10);
+  WifiActionHeader actionHdr;
+  WifiActionHeader::ActionValue action;
+  action.selfProtectedAction = WifiActionHeader::PEER_LINK_OPEN;
+  actionHdr.SetAction (WifiActionHeader::SELF_PROTECTED, action);
+  packet->AddHeader (actionHdr);
+  PointerValue ptr;
+  sender->GetAttribute ("Txop", ptr);
+  ptr.Get<Txop> ()->Queue (packet, hdr);
+}
+
+void
+ActionFrameDispatchTest::FirstHandler (Ptr<Packet> packet, const WifiMacHeader &hdr)
+{
+  Record (0, packet, hdr);
+}
+
+void
+ActionFrameDispatchTest::SecondHandler (Ptr<Packet> packet, const WifiMacHeader &hdr)
+{
+  Record (1, packet, hdr);
+}
+
+void
+ActionFrameDispatchTest::Record (uint8_t index, Ptr<Packet> packet, const WifiMacHeader &hdr)
+{
+  m_received.at (index)++;
+  m_bodySize = packet->GetSize ();
+  m_sender = hdr.GetAddr2 ();
+}
+
+void
+ActionFrameDispatchTest::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  YansWifiPhyHelper phy;
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager");
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  Ptr<RegularWifiMac> senderMac = DynamicCast<RegularWifiMac> (DynamicCast<WifiNetDevice> (devices.Get (0))->GetMac ());
+  Ptr<RegularWifiMac> receiverMac = DynamicCast<RegularWifiMac> (DynamicCast<WifiNetDevice> (devices.Get (1))->GetMac ());
+  receiverMac->SetActionFrameHandler (WifiActionHeader::SELF_PROTECTED, WifiActionHeader::PEER_LINK_OPEN,
+                                      MakeCallback (&ActionFrameDispatchTest::FirstHandler, this));
+
+  Mac48Address senderAddress = senderMac->GetAddress ();
+  Mac48Address receiverAddress = receiverMac->GetAddress ();
+
+  Simulator::Schedule (Seconds (1.0), &ActionFrameDispatchTest::SendPeerLinkOpen, this, senderMac, receiverAddress);
+  Simulator::Schedule (Seconds (1.5), &RegularWifiMac::SetActionFrameHandler, receiverMac,
+                       WifiActionHeader::SELF_PROTECTED, WifiActionHeader::PEER_LINK_OPEN,
+                       MakeCallback (&ActionFrameDispatchTest::SecondHandler, this));
+  Simulator::Schedule (Seconds (2.0), &ActionFrameDispatchTest::SendPeerLinkOpen, this, senderMac, receiverAddress);
+  Simulator::Stop (Seconds (3.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_received[0], 1, "The first frame should be delivered to the first handler");
+  NS_TEST_EXPECT_MSG_EQ (m_received[1], 1, "The second frame should be delivered to the second handler");
+  NS_TEST_EXPECT_MSG_EQ (m_bodySize, 10, "The handler should be given the frame body following the Action header");
+  NS_TEST_EXPECT_MSG_EQ (m_sender, senderAddress, "The handler should be given the MAC header of the frame");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Minstrel-HT statistics update test
+ *
+ * The transmission attempts of a remote station are reported directly to
+ * Minstrel-HT over a few statistics intervals. The statistics of the rates
+ * attempted in an interval must be updated, those of the other rates kept,
+ * and the number of updates skipped by each rate, which decides whether a
+ * slow rate may be sampled, must count the intervals since the rate was
+ * last attempted.
+ */
+class MinstrelHtStatsTest : public TestCase
+{
+public:
+  MinstrelHtStatsTest ();
+  virtual void DoRun (void);
+};
+
+MinstrelHtStatsTest::MinstrelHtStatsTest ()
+  : TestCase ("Check the update of the Minstrel-HT statistics")
+{
+}
+
+void
+MinstrelHtStatsTest::DoRun (void)
+{
+  NodeContainer wifiNode;
+  wifiNode.Create (1);
+
+  YansWifiPhyHelper phy;
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211n_5GHZ);
+  wifi.SetRemoteStationManager ("ns3::MinstrelHtWifiManager");
+
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer device = wifi.Install (phy, mac, wifiNode);
+  Ptr<MinstrelHtWifiManager> manager =
+    DynamicCast<MinstrelHtWifiManager> (DynamicCast<WifiNetDevice> (device.Get (0))->GetRemoteStationManager ());
+  manager->Initialize ();
+
+  // a remote station supporting MCS 0 to 7 with a single stream, a long
+  // guard interval and a 20 MHz channel
+  Ptr<HtCapabilities> htCapabilities = Create<HtCapabilities> ();
+  htCapabilities->SetHtSupported (1);
+  htCapabilities->SetShortGuardInterval20 (0);
+  WifiRemoteStationState state;
+  state.m_state = WifiRemoteStationState::GOT_ASSOC_TX_OK;
+  state.m_address = Mac48Address ("00:00:00:00:00:01");
+  for (uint8_t mcs = 0; mcs < 8; mcs++)
+    {
+      htCapabilities->SetRxMcsBitmask (mcs);
+      state.m_operationalMcsSet.push_back (WifiPhy::GetHtMcs (mcs));
+    }
+  state.m_htCapabilities = htCapabilities;
+  state.m_vhtCapabilities = 0;
+  state.m_heCapabilities = 0;
+  state.m_channelWidth = 20;
+  state.m_guardInterval = 800;
+  state.m_ness = 0;
+  state.m_aggregation = true;
+  state.m_qosSupported = true;
+
+  MinstrelHtWifiRemoteStation *station = static_cast<MinstrelHtWifiRemoteStation *> (manager->DoCreateStation ());
+  station->m_state = &state;
+  manager->CheckInit (station);
+  NS_TEST_ASSERT_MSG_EQ (station->m_isHt, true, "The station should use the HT statistics");
+
+  uint8_t groupId = manager->GetHtGroupId (1, 0, 20);
+  uint16_t mcs2 = manager->GetIndex (groupId, 2);
+  uint16_t mcs3 = manager->GetIndex (groupId, 3);
+  uint16_t mcs5 = manager->GetIndex (groupId, 5);
+  const HtRateInfo &mcs2Info = station->m_groupsTable[groupId].m_ratesTable[2];
+  const HtRateInfo &mcs3Info = station->m_groupsTable[groupId].m_ratesTable[3];
+  const HtRateInfo &mcs5Info = station->m_groupsTable[groupId].m_ratesTable[5];
+  // the initialization updates the statistics once
+  uint32_t initialUpdates = station->m_numStatsUpdates;
+
+  // first interval: MCS 2 and MCS 5 are attempted
+  manager->AddRateAttempts (station, groupId, 2, 8, 10);
+  manager->AddRateAttempts (station, groupId, 5, 10, 10);
+  manager->UpdateStats (station);
+
+  NS_TEST_EXPECT_MSG_EQ (mcs2Info.prob, 80, "Unexpected success probability of MCS 2");
+  NS_TEST_EXPECT_MSG_EQ (mcs2Info.ewmaProb, 80, "The first EWMA should be the success probability");
+  NS_TEST_EXPECT_MSG_EQ (mcs2Info.prevNumRateAttempt, 10, "Unexpected attempts of the last interval");
+  NS_TEST_EXPECT_MSG_EQ (mcs2Info.prevNumRateSuccess, 8, "Unexpected successes of the last interval");
+  NS_TEST_EXPECT_MSG_EQ (mcs2Info.numRateAttempt, 0, "The attempts should be reset by the update");
+  NS_TEST_EXPECT_MSG_EQ (mcs5Info.ewmaProb, 100, "Unexpected EWMA of MCS 5");
+  NS_TEST_EXPECT_MSG_GT (mcs5Info.throughput, mcs2Info.throughput, "MCS 5 should have the highest throughput");
+  NS_TEST_EXPECT_MSG_GT (mcs2Info.throughput, 0, "MCS 2 should have a throughput");
+  NS_TEST_EXPECT_MSG_EQ (mcs3Info.throughput, 0, "MCS 3 was never attempted");
+  NS_TEST_EXPECT_MSG_EQ (station->m_maxTpRate, mcs5, "MCS 5 should be the max throughput rate");
+  NS_TEST_EXPECT_MSG_EQ (station->m_maxTpRate2, mcs2, "MCS 2 should be the second max throughput rate");
+  NS_TEST_EXPECT_MSG_EQ (manager->GetNumSkippedUpdates (station, mcs2), 0, "MCS 2 was attempted in the interval");
+  NS_TEST_EXPECT_MSG_EQ (manager->GetNumSkippedUpdates (station, mcs3), initialUpdates + 1,
+                         "MCS 3 should have skipped all the updates");
+
+  // second interval: only MCS 2 is attempted
+  double mcs5Throughput = mcs5Info.throughput;
+  manager->AddRateAttempts (station, groupId, 2, 5, 10);
+  manager->UpdateStats (station);
+
+  NS_TEST_EXPECT_MSG_EQ (mcs2Info.prob, 50, "Unexpected success probability of MCS 2");
+  NS_TEST_EXPECT_MSG_EQ_TOL (mcs2Info.ewmaProb, (50 * 25 + 80 * 75) / 100.0, 1e-9, "Unexpected EWMA of MCS 2");
+  NS_TEST_EXPECT_MSG_EQ (mcs2Info.attemptHist, 20, "Unexpected attempt history of MCS 2");
+  NS_TEST_EXPECT_MSG_EQ (mcs5Info.ewmaProb, 100, "The EWMA of a rate not attempted should be kept");
+  NS_TEST_EXPECT_MSG_EQ (mcs5Info.throughput, mcs5Throughput, "The throughput of a rate not attempted should be kept");
+  NS_TEST_EXPECT_MSG_EQ (mcs5Info.attemptHist, 10, "Unexpected attempt history of MCS 5");
+  NS_TEST_EXPECT_MSG_EQ (mcs5Info.prevNumRateAttempt, 0, "The attempts of the last interval should be reset");
+  NS_TEST_EXPECT_MSG_EQ (mcs5Info.prevNumRateSuccess, 0, "The successes of the last interval should be reset");
+  NS_TEST_EXPECT_MSG_EQ (station->m_maxTpRate, mcs5, "A rate not attempted should remain the max throughput rate");
+  NS_TEST_EXPECT_MSG_EQ (manager->GetNumSkippedUpdates (station, mcs5), 1, "MCS 5 skipped one update");
+
+  // 19 more intervals without attempts: MCS 5 becomes eligible for sampling
+  // as a slow rate after 20 skipped updates
+  for (uint32_t i = 0; i < 19; i++)
+    {
+      NS_TEST_EXPECT_MSG_LT (manager->GetNumSkippedUpdates (station, mcs5), 20, "MCS 5 skipped too many updates");
+      manager->UpdateStats (station);
+    }
+  NS_TEST_EXPECT_MSG_EQ (manager->GetNumSkippedUpdates (station, mcs5), 20, "MCS 5 skipped 20 updates");
+  NS_TEST_EXPECT_MSG_EQ (manager->GetNumSkippedUpdates (station, mcs2), 19, "MCS 2 skipped 19 updates");
+  NS_TEST_EXPECT_MSG_EQ (manager->GetNumSkippedUpdates (station, mcs3), initialUpdates + 21,
+                         "MCS 3 should have skipped all the updates");
+  NS_TEST_EXPECT_MSG_EQ (mcs5Info.throughput, mcs5Throughput, "The throughput of a rate not attempted should be kept");
+  NS_TEST_EXPECT_MSG_EQ (station->m_maxTpRate, mcs5, "A rate not attempted should remain the max throughput rate");
+
+  // a new attempt resets the count
+  manager->AddRateAttempts (station, groupId, 5, 1, 1);
+  manager->UpdateStats (station);
+  NS_TEST_EXPECT_MSG_EQ (manager->GetNumSkippedUpdates (station, mcs5), 0, "MCS 5 was attempted in the interval");
+  NS_TEST_EXPECT_MSG_EQ (mcs5Info.attemptHist, 11, "Unexpected attempt history of MCS 5");
+
+  delete station;
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -3082,6 +3982,14 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new IdealRateManagerChannelWidthTest, TestCase::QUICK);
   AddTestCase (new IdealRateManagerMimoTest, TestCase::QUICK);
   AddTestCase (new HeRuMcsDataRateTestCase, TestCase::QUICK);
+  AddTestCase (new WifiMacQueueFlowIndexTest, TestCase::QUICK);
+  AddTestCase (new WifiMacHeaderViewTest, TestCase::QUICK);
+  AddTestCase (new YansWifiChannelPartitionTest (false), TestCase::QUICK);
+  AddTestCase (new YansWifiChannelPartitionTest (true), TestCase::QUICK);
+  AddTestCase (new BeaconTemplateTest, TestCase::QUICK);
+  AddTestCase (new WifiProfilerTest, TestCase::QUICK);
+  AddTestCase (new ActionFrameDispatchTest, TestCase::QUICK);
+  AddTestCase (new MinstrelHtStatsTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
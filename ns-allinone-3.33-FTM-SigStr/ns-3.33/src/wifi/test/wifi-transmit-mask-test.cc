@@ -229,6 +229,54 @@ WifiOfdmMaskSlopesTestCase::DoRun (void)
 }
 
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test checks that transmit PSDs built from the cached 1 W templates
+ * carry the requested power and are independent copies.
+ */
+class WifiTxPsdTemplateTestCase : public TestCase
+{
+public:
+  WifiTxPsdTemplateTestCase ();
+  virtual ~WifiTxPsdTemplateTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+WifiTxPsdTemplateTestCase::WifiTxPsdTemplateTestCase ()
+  : TestCase ("Check scaling of cached transmit PSD templates")
+{
+}
+
+WifiTxPsdTemplateTestCase::~WifiTxPsdTemplateTestCase ()
+{
+}
+
+void
+WifiTxPsdTemplateTestCase::DoRun (void)
+{
+  for (double txPowerW : {0.001, 0.02, 0.1, 1.0})
+    {
+      Ptr<SpectrumValue> ofdm = WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (5180, 20, txPowerW, 10);
+      NS_TEST_EXPECT_MSG_EQ_TOL (Integral (*ofdm), txPowerW, 1e-9 * txPowerW, "OFDM PSD does not carry the requested power");
+      Ptr<SpectrumValue> ht = WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (5190, 40, txPowerW, 20);
+      NS_TEST_EXPECT_MSG_EQ_TOL (Integral (*ht), txPowerW, 1e-9 * txPowerW, "HT PSD does not carry the requested power");
+      Ptr<SpectrumValue> he = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (5210, 80, txPowerW, 40);
+      NS_TEST_EXPECT_MSG_EQ_TOL (Integral (*he), txPowerW, 1e-9 * txPowerW, "HE PSD does not carry the requested power");
+      Ptr<SpectrumValue> dsss = WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity (2412, txPowerW, 10);
+      NS_TEST_EXPECT_MSG_EQ_TOL (Integral (*dsss), txPowerW, 1e-9 * txPowerW, "DSSS PSD does not carry the requested power");
+    }
+
+  //modifying a returned PSD must not alter the template
+  Ptr<SpectrumValue> first = WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (5180, 20, 0.1, 10);
+  (*first) *= 0;
+  Ptr<SpectrumValue> second = WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (5180, 20, 0.1, 10);
+  NS_TEST_EXPECT_MSG_EQ_TOL (Integral (*second), 0.1, 1e-10, "Transmit PSD template has been modified");
+}
+
 
 /**
  * \ingroup wifi-test
@@ -711,4 +759,6 @@ WifiTransmitMaskTestSuite::WifiTransmitMaskTestSuite ()
   AddTestCase (new WifiOfdmMaskSlopesTestCase ("11ax_5GHz 160MHz", WIFI_PHY_STANDARD_80211ax, WIFI_PHY_BAND_5GHZ,
                                                160, maskSlopesLeft, maskSlopesRight, tol),
                TestCase::QUICK);
+
+  AddTestCase (new WifiTxPsdTemplateTestCase, TestCase::QUICK);
 }
@@ -0,0 +1,412 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+/*
+ * Replay the operations recorded by ns3::RecordingScheduler against
+ * every scheduler, and report for each one the time per operation, the
+ * memory high-water mark and the number of cache misses.
+ */
+
+namespace {
+
+/*
+ * The global operator new and delete are replaced to account for the
+ * memory allocated while a scheduler is replayed. Each block starts
+ * with a header holding its size.
+ */
+
+/// Size of the header of the allocated blocks, which preserves their alignment
+const std::size_t HEADER = 16;
+std::size_t g_allocated = 0; //!< Number of bytes currently allocated
+std::size_t g_peak = 0;      //!< Largest value of g_allocated since the last reset
+
+/**
+ * Allocate a block and account for it.
+ * \param size the requested size
+ * \return the block, or 0 if the allocation failed
+ */
+void *
+Allocate (std::size_t size)
+{
+  char *p = static_cast<char *> (std::malloc (size + HEADER));
+  if (p == 0)
+    {
+      return 0;
+    }
+  *reinterpret_cast<std::size_t *> (p) = size;
+  g_allocated += size;
+  if (g_allocated > g_peak)
+    {
+      g_peak = g_allocated;
+    }
+  return p + HEADER;
+}
+
+/**
+ * Release a block allocated by Allocate().
+ * \param ptr the block
+ */
+void
+Deallocate (void *ptr)
+{
+  if (ptr == 0)
+    {
+      return;
+    }
+  char *p = static_cast<char *> (ptr) - HEADER;
+  g_allocated -= *reinterpret_cast<std::size_t *> (p);
+  std::free (p);
+}
+
+} // unnamed namespace
+
+void *
+operator new (std::size_t size)
+{
+  void *p = Allocate (size);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void *
+operator new (std::size_t size, const std::nothrow_t &) noexcept
+{
+  return Allocate (size);
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  return operator new (size);
+}
+
+void *
+operator new[] (std::size_t size, const std::nothrow_t &) noexcept
+{
+  return Allocate (size);
+}
+
+void
+operator delete (void *ptr) noexcept
+{
+  Deallocate (ptr);
+}
+
+void
+operator delete (void *ptr, const std::nothrow_t &) noexcept
+{
+  Deallocate (ptr);
+}
+
+void
+operator delete[] (void *ptr) noexcept
+{
+  Deallocate (ptr);
+}
+
+void
+operator delete[] (void *ptr, const std::nothrow_t &) noexcept
+{
+  Deallocate (ptr);
+}
+
+namespace {
+
+/// A recorded scheduler operation
+struct Operation
+{
+  char op;          //!< 'i' for Insert, 'n' for RemoveNext, 'r' for Remove
+  uint64_t ts;      //!< Event timestamp
+  uint32_t uid;     //!< Event unique id
+};
+
+/**
+ * Read the operations recorded by a RecordingScheduler.
+ * \param filename the name of the file
+ * \param [out] operations the operations
+ * \return false if the file cannot be read
+ */
+bool
+ReadOperations (std::string filename, std::vector<Operation> &operations)
+{
+  std::ifstream input (filename.c_str ());
+  if (!input.is_open ())
+    {
+      return false;
+    }
+  Operation operation;
+  while (input >> operation.op >> operation.ts >> operation.uid)
+    {
+      operations.push_back (operation);
+    }
+  return input.eof ();
+}
+
+/**
+ * Count the cache misses of the calling thread, when the performance
+ * counters are available.
+ */
+class CacheMisses
+{
+public:
+  CacheMisses ()
+    : m_fd (-1)
+  {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset (&attr, 0, sizeof (attr));
+    attr.size = sizeof (attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    m_fd = syscall (__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+  ~CacheMisses ()
+  {
+#ifdef __linux__
+    if (m_fd >= 0)
+      {
+        close (m_fd);
+      }
+#endif
+  }
+  /// \return true if the cache misses can be counted
+  bool IsAvailable (void) const
+  {
+    return m_fd >= 0;
+  }
+  /// Reset and start the counter
+  void Start (void)
+  {
+#ifdef __linux__
+    if (m_fd >= 0)
+      {
+        ioctl (m_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl (m_fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+  }
+  /// \return the number of cache misses since Start()
+  uint64_t Stop (void)
+  {
+    uint64_t count = 0;
+#ifdef __linux__
+    if (m_fd >= 0)
+      {
+        ioctl (m_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read (m_fd, &count, sizeof (count)) != sizeof (count))
+          {
+            count = 0;
+          }
+      }
+#endif
+    return count;
+  }
+
+private:
+  int m_fd; //!< The performance counter file descriptor
+};
+
+/// Result of the replay of the operations against a scheduler
+struct Result
+{
+  double nsPerOp;         //!< Mean time per operation (ns)
+  std::size_t peakBytes;  //!< Memory high-water mark (bytes)
+  uint64_t cacheMisses;   //!< Number of cache misses
+  uint64_t mismatches;    //!< Number of RemoveNext which returned an unexpected event
+};
+
+/**
+ * Replay the operations against a scheduler.
+ * \param tid the type of the scheduler
+ * \param operations the operations
+ * \param cacheMisses the cache miss counter
+ * \return the result of the replay
+ */
+Result
+Replay (TypeId tid, const std::vector<Operation> &operations, CacheMisses &cacheMisses)
+{
+  Result result;
+  result.mismatches = 0;
+  std::size_t allocated = g_allocated;
+  g_peak = g_allocated;
+
+  ObjectFactory factory;
+  factory.SetTypeId (tid);
+  Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+
+  cacheMisses.Start ();
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  Scheduler::Event ev;
+  ev.impl = 0;
+  ev.key.m_context = 0;
+  for (std::vector<Operation>::const_iterator i = operations.begin (); i != operations.end (); i++)
+    {
+      ev.key.m_ts = i->ts;
+      ev.key.m_uid = i->uid;
+      switch (i->op)
+        {
+        case 'i':
+          scheduler->Insert (ev);
+          break;
+        case 'n':
+          if (scheduler->IsEmpty () || !(scheduler->RemoveNext ().key == ev.key))
+            {
+              result.mismatches++;
+            }
+          break;
+        case 'r':
+          scheduler->Remove (ev);
+          break;
+        default:
+          NS_FATAL_ERROR ("Unknown operation " << i->op);
+        }
+    }
+  std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now () - start;
+  result.cacheMisses = cacheMisses.Stop ();
+
+  result.nsPerOp = std::chrono::duration<double, std::nano> (elapsed).count () / operations.size ();
+  result.peakBytes = g_peak - allocated;
+  return result;
+}
+
+} // unnamed namespace
+
+
+int main (int argc, char *argv[])
+{
+  std::string filename = "";
+  std::string schedulers = "";
+  uint32_t runs = 3;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the schedulers against recorded event traces.\n"
+             "\n"
+             "The trace is recorded by running any program with the\n"
+             "ns3::RecordingScheduler, e.g.:\n"
+             "  --SchedulerType=ns3::RecordingScheduler\n"
+             "  --ns3::RecordingScheduler::FileName=trace.sched\n"
+             "It is then replayed against every scheduler (or the ones given by\n"
+             "--schedulers), which reports the mean time per operation (best of\n"
+             "--runs), the memory high-water mark, the cache misses (when the\n"
+             "performance counters are available) and the number of events\n"
+             "removed out of order. The exit status is non-zero if any event\n"
+             "was removed out of order.");
+  cmd.AddValue ("file", "file of recorded scheduler operations", filename);
+  cmd.AddValue ("schedulers", "comma-separated list of schedulers (default: all)", schedulers);
+  cmd.AddValue ("runs", "number of runs per scheduler (default 3)", runs);
+  cmd.Parse (argc, argv);
+  std::string me = cmd.GetName () + ": ";
+
+  if (filename == "")
+    {
+      std::cerr << me << "missing --file" << std::endl;
+      return 1;
+    }
+  std::vector<Operation> operations;
+  if (!ReadOperations (filename, operations) || operations.empty ())
+    {
+      std::cerr << me << "cannot read operations from " << filename << std::endl;
+      return 1;
+    }
+
+  std::vector<TypeId> tids;
+  if (schedulers == "")
+    {
+      for (uint16_t i = 0; i < TypeId::GetRegisteredN (); i++)
+        {
+          TypeId tid = TypeId::GetRegistered (i);
+          if (tid.IsChildOf (Scheduler::GetTypeId ()) && tid.HasConstructor ()
+              && tid != RecordingScheduler::GetTypeId ())
+            {
+              tids.push_back (tid);
+            }
+        }
+    }
+  else
+    {
+      std::istringstream list (schedulers);
+      std::string name;
+      while (std::getline (list, name, ','))
+        {
+          tids.push_back (TypeId::LookupByName (name));
+        }
+    }
+
+  CacheMisses cacheMisses;
+  std::cout << me << operations.size () << " operations from " << filename << std::endl
+            << std::endl
+            << std::left << std::setw (32) << "Scheduler"
+            << std::right << std::setw (12) << "ns/op"
+            << std::setw (16) << "Peak (bytes)"
+            << std::setw (16) << "Cache misses"
+            << std::setw (12) << "Mismatches" << std::endl;
+  bool ok = true;
+  for (std::vector<TypeId>::const_iterator i = tids.begin (); i != tids.end (); i++)
+    {
+      Result best = Result ();
+      for (uint32_t run = 0; run < std::max<uint32_t> (runs, 1); run++)
+        {
+          Result result = Replay (*i, operations, cacheMisses);
+          if (run == 0 || result.nsPerOp < best.nsPerOp)
+            {
+              best = result;
+            }
+        }
+      std::cout << std::left << std::setw (32) << i->GetName ()
+                << std::right << std::setw (12) << std::fixed << std::setprecision (1) << best.nsPerOp
+                << std::setw (16) << best.peakBytes
+                << std::setw (16);
+      if (cacheMisses.IsAvailable ())
+        {
+          std::cout << best.cacheMisses;
+        }
+      else
+        {
+          std::cout << "n/a";
+        }
+      std::cout << std::setw (12) << best.mismatches << std::endl;
+      ok = ok && best.mismatches == 0;
+    }
+  return ok ? 0 : 1;
+}
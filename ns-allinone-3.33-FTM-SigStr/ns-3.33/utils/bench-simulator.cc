@@ -205,6 +205,7 @@ int main (int argc, char *argv[])
 
   bool schedCal           = false;
   bool schedHeap          = false;
+  bool schedLadder        = false;
   bool schedList          = false;
   bool schedMap           = true;
   bool schedPriorityQueue = false;
@@ -227,6 +228,7 @@ int main (int argc, char *argv[])
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
   cmd.AddValue ("calrev", "reverse ordering in the CalendarScheduler", calRev);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
+  cmd.AddValue ("ladder", "use LadderScheduler",          schedLadder);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
   cmd.AddValue ("pri",   "use PriorityQueue",             schedPriorityQueue);
@@ -250,6 +252,10 @@ int main (int argc, char *argv[])
     {
       factory.SetTypeId ("ns3::HeapScheduler");
     }
+  if (schedLadder)
+    {
+      factory.SetTypeId ("ns3::LadderScheduler");
+    }
   if (schedList)
     {
       factory.SetTypeId ("ns3::ListScheduler");